@@ -0,0 +1,28 @@
+/*
+ * Copyright (c) 2023 Intel Corporation.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/arch/arm/aarch32/cortex_m/cmsis.h>
+
+bool arch_perf_sample_get(uintptr_t *pc, uintptr_t *lr)
+{
+	const z_arch_esf_t *esf;
+
+	/* Some other exception is active underneath this one */
+	if ((SCB->ICSR & SCB_ICSR_RETTOBASE_Msk) == 0U) {
+		return false;
+	}
+
+	/* Threads run on the process stack, the exception entry stacked
+	 * their caller-saved registers there
+	 */
+	esf = (const z_arch_esf_t *)__get_PSP();
+
+	*pc = esf->basic.pc;
+	*lr = esf->basic.lr;
+
+	return true;
+}
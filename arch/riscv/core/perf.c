@@ -0,0 +1,27 @@
+/*
+ * Copyright (c) 2023 Intel Corporation.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/kernel_structs.h>
+
+bool arch_perf_sample_get(uintptr_t *pc, uintptr_t *lr)
+{
+	const z_arch_esf_t *esf;
+
+	if (_current_cpu->nested != 1U) {
+		return false;
+	}
+
+	/* The outermost interrupt saves the thread's stack pointer, which
+	 * points to its esf, on top of the interrupt stack, see isr.S
+	 */
+	esf = *((const z_arch_esf_t **)(_current_cpu->irq_stack - 16));
+
+	*pc = esf->mepc;
+	*lr = esf->ra;
+
+	return true;
+}
@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2023 Intel Corporation.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/kernel_structs.h>
+
+/* Interrupted context as left on the thread stack by _interrupt_enter */
+struct perf_isf {
+	uint32_t edi;
+	uint32_t ecx;
+	uint32_t edx;
+	uint32_t eax;
+	uint32_t eip;
+};
+
+bool arch_perf_sample_get(uintptr_t *pc, uintptr_t *lr)
+{
+	const struct perf_isf *isf;
+
+	if (_current_cpu->nested != 1U) {
+		return false;
+	}
+
+	/* The outermost interrupt pushes the thread's stack pointer on
+	 * the base of the interrupt stack, see intstub.S
+	 */
+	isf = *((const struct perf_isf **)_current_cpu->irq_stack - 1);
+
+	*pc = isf->eip;
+
+	/* The return address is somewhere on the thread's stack */
+	*lr = 0U;
+
+	return true;
+}
@@ -2188,6 +2188,28 @@ uintptr_t arch_page_info_get(void *addr, uintptr_t *phys, bool clear_accessed)
 	return (uintptr_t)all_pte;
 }
 
+#ifdef CONFIG_DEMAND_PAGING_PAGE_CLEANER
+__pinned_func
+void arch_page_dirty_clear(void *addr)
+{
+	page_map_set(z_x86_kernel_ptables, addr, 0, NULL, MMU_D,
+		     OPTION_FLUSH);
+
+#if defined(CONFIG_USERSPACE) && !defined(CONFIG_X86_COMMON_PAGE_TABLE)
+	sys_snode_t *node;
+
+	/* IRQs are locked, safe to do this */
+	SYS_SLIST_FOR_EACH_NODE(&x86_domain_list, node) {
+		struct arch_mem_domain *domain =
+			CONTAINER_OF(node, struct arch_mem_domain, node);
+
+		page_map_set(domain->ptables, addr, 0, NULL, MMU_D,
+			     OPTION_FLUSH | OPTION_USER);
+	}
+#endif /* USERSPACE && ~X86_COMMON_PAGE_TABLE */
+}
+#endif /* CONFIG_DEMAND_PAGING_PAGE_CLEANER */
+
 __pinned_func
 enum arch_page_location arch_page_location_get(void *addr, uintptr_t *location)
 {
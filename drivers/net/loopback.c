@@ -82,6 +82,103 @@ int loopback_get_num_dropped_packets(void)
 
 #endif
 
+#ifdef CONFIG_NET_LOOPBACK_SIMULATE_PACKET_DELAY
+struct loopback_delayed_pkt {
+	struct net_pkt *pkt;
+	int64_t due;
+};
+
+static struct loopback_delayed_pkt
+	loopback_delay_queue[CONFIG_NET_LOOPBACK_DELAY_QUEUE_SIZE];
+static unsigned int loopback_delay_head;
+static unsigned int loopback_delay_count;
+static uint32_t loopback_packet_delay_ms;
+static struct k_spinlock loopback_delay_lock;
+
+static void loopback_delay_work_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(loopback_delay_work, loopback_delay_work_handler);
+
+int loopback_set_packet_delay(uint32_t delay_ms)
+{
+	loopback_packet_delay_ms = delay_ms;
+	return 0;
+}
+
+/* Hand over the packets whose delay has elapsed, in order */
+static void loopback_delay_work_handler(struct k_work *work)
+{
+	struct loopback_delayed_pkt *entry;
+	struct net_pkt *pkt;
+	k_spinlock_key_t key;
+	int64_t now;
+
+	ARG_UNUSED(work);
+
+	while (true) {
+		key = k_spin_lock(&loopback_delay_lock);
+
+		if (loopback_delay_count == 0U) {
+			k_spin_unlock(&loopback_delay_lock, key);
+			break;
+		}
+
+		entry = &loopback_delay_queue[loopback_delay_head];
+		now = k_uptime_get();
+		if (entry->due > now) {
+			k_work_reschedule(&loopback_delay_work,
+					  K_MSEC(entry->due - now));
+			k_spin_unlock(&loopback_delay_lock, key);
+			break;
+		}
+
+		pkt = entry->pkt;
+		loopback_delay_head = (loopback_delay_head + 1U) %
+				      ARRAY_SIZE(loopback_delay_queue);
+		loopback_delay_count--;
+
+		k_spin_unlock(&loopback_delay_lock, key);
+
+		if (net_recv_data(net_pkt_iface(pkt), pkt) < 0) {
+			LOG_ERR("Data receive failed.");
+			net_pkt_unref(pkt);
+		}
+	}
+}
+
+/* Queue a received packet, like a bottleneck link with a fixed size
+ * buffer would: when it is full, the packet is lost.
+ */
+static int loopback_delay_pkt(struct net_pkt *pkt)
+{
+	k_spinlock_key_t key;
+	unsigned int tail;
+	int ret = 0;
+
+	key = k_spin_lock(&loopback_delay_lock);
+
+	if (loopback_delay_count == ARRAY_SIZE(loopback_delay_queue)) {
+		ret = -ENOBUFS;
+		goto out;
+	}
+
+	tail = (loopback_delay_head + loopback_delay_count) %
+	       ARRAY_SIZE(loopback_delay_queue);
+	loopback_delay_queue[tail].pkt = pkt;
+	loopback_delay_queue[tail].due = k_uptime_get() +
+					 loopback_packet_delay_ms;
+
+	if (loopback_delay_count++ == 0U) {
+		k_work_reschedule(&loopback_delay_work,
+				  K_MSEC(loopback_packet_delay_ms));
+	}
+
+out:
+	k_spin_unlock(&loopback_delay_lock, key);
+
+	return ret;
+}
+#endif
+
 static int loopback_send(const struct device *dev, struct net_pkt *pkt)
 {
 	struct net_pkt *cloned;
@@ -138,6 +235,21 @@ static int loopback_send(const struct device *dev, struct net_pkt *pkt)
 		goto out;
 	}
 
+#ifdef CONFIG_NET_LOOPBACK_SIMULATE_PACKET_DELAY
+	if (loopback_packet_delay_ms > 0U) {
+		if (loopback_delay_pkt(cloned) < 0) {
+			/* Overflowing the queue is a loss, not an error */
+			net_pkt_unref(cloned);
+#ifdef CONFIG_NET_LOOPBACK_SIMULATE_PACKET_DROP
+			loopback_packet_dropped_count++;
+#endif
+		}
+
+		res = 0;
+		goto out;
+	}
+#endif
+
 	res = net_recv_data(net_pkt_iface(cloned), cloned);
 	if (res < 0) {
 		LOG_ERR("Data receive failed.");
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_DEBUG_PERF_H_
+#define ZEPHYR_INCLUDE_DEBUG_PERF_H_
+
+#include <stdint.h>
+#include <zephyr/kernel.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup perf Sampling profiler
+ * @brief Statistical profiler for threads and interrupts
+ *
+ * While running, the profiler periodically records which thread the
+ * system timer interrupt preempted and, on architectures selecting
+ * CONFIG_ARCH_HAS_PERF_SAMPLE, where it was executing. Samples are
+ * kept in a ring buffer which holds the most recent
+ * CONFIG_PROFILING_PERF_BUFFER_SIZE of them.
+ *
+ * @{
+ */
+
+/** A single profiler sample */
+struct perf_sample {
+	/** Interrupted thread, NULL if an interrupt was interrupted */
+	struct k_thread *thread;
+	/** Program counter, 0 if not known */
+	uintptr_t pc;
+	/** Return address, 0 if not known */
+	uintptr_t lr;
+};
+
+/**
+ * @brief Callback for perf_foreach()
+ *
+ * @param sample Sample
+ * @param user_data User data passed to perf_foreach()
+ */
+typedef void (*perf_sample_cb_t)(const struct perf_sample *sample,
+				 void *user_data);
+
+/**
+ * @brief Start sampling
+ *
+ * Samples recorded by a previous run are discarded. Samples are taken
+ * from a kernel timer, so @a frequency cannot be higher than
+ * CONFIG_SYS_CLOCK_TICKS_PER_SEC.
+ *
+ * @param frequency Sampling frequency in Hz
+ *
+ * @retval 0 Sampling started
+ * @retval -EINVAL Invalid frequency
+ * @retval -EALREADY Sampling is already running
+ */
+int perf_start(uint32_t frequency);
+
+/**
+ * @brief Stop sampling
+ *
+ * @retval 0 Sampling stopped
+ * @retval -EALREADY Sampling is not running
+ */
+int perf_stop(void);
+
+/**
+ * @brief Get the number of samples taken by the last run
+ *
+ * This includes samples which have been overwritten in the ring buffer.
+ *
+ * @return Number of samples taken
+ */
+uint32_t perf_samples_taken(void);
+
+/**
+ * @brief Iterate over the recorded samples, oldest first
+ *
+ * @param cb Callback called for every sample
+ * @param user_data User data passed to @a cb
+ *
+ * @return Number of samples visited
+ * @retval -EBUSY Sampling is running
+ */
+int perf_foreach(perf_sample_cb_t cb, void *user_data);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_DEBUG_PERF_H_ */
@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_DEBUG_TELEMETRY_H_
+#define ZEPHYR_INCLUDE_DEBUG_TELEMETRY_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <zephyr/toolchain.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup telemetry Thread telemetry
+ * @brief Periodic binary snapshots of thread statistics
+ *
+ * The telemetry subsystem periodically snapshots the execution cycles,
+ * context switch count and stack high-water mark of every thread, and
+ * the busy, idle and interrupt cycles of every CPU, into a compact binary
+ * record which is written to all the telemetry backends.
+ *
+ * A record is a struct telemetry_record_hdr, followed by @a length bytes
+ * of payload and a CRC16-CCITT of the header and payload, seeded with
+ * 0xffff. All fields are little endian. scripts/profiling/telemetry.py
+ * decodes records.
+ *
+ * @{
+ */
+
+/** First byte of every record */
+#define TELEMETRY_MAGIC0 'Z'
+/** Second byte of every record */
+#define TELEMETRY_MAGIC1 'T'
+
+/** Version of the record format */
+#define TELEMETRY_VERSION 1
+
+/** Record types */
+enum telemetry_record_type {
+	/** struct telemetry_snapshot, then one struct telemetry_cpu per
+	 * CPU and one struct telemetry_thread per thread
+	 */
+	TELEMETRY_RECORD_SNAPSHOT = 0,
+	/** For every thread, a struct telemetry_thread_name followed by the
+	 * name, without NUL terminator. Sent whenever the set of threads
+	 * changes.
+	 */
+	TELEMETRY_RECORD_THREAD_NAMES = 1,
+};
+
+/** Record header */
+struct telemetry_record_hdr {
+	/** TELEMETRY_MAGIC0, TELEMETRY_MAGIC1 */
+	uint8_t magic[2];
+	/** TELEMETRY_VERSION */
+	uint8_t version;
+	/** One of enum telemetry_record_type */
+	uint8_t type;
+	/** Payload length, in bytes */
+	uint16_t length;
+	/** Sequence number, incremented for every record */
+	uint16_t seq;
+	/** System uptime, in milliseconds */
+	uint32_t uptime;
+} __packed;
+
+/** Snapshot record payload */
+struct telemetry_snapshot {
+	/** Frequency of the cycle counter, in Hz */
+	uint32_t cycles_per_sec;
+	/** Cycles elapsed since the previous snapshot */
+	uint32_t interval;
+	/** Number of struct telemetry_cpu following */
+	uint8_t num_cpus;
+	/** Number of struct telemetry_thread following */
+	uint8_t num_threads;
+	/** Threads left out, beyond CONFIG_TELEMETRY_MAX_THREADS */
+	uint16_t dropped;
+} __packed;
+
+/** Per CPU statistics, in cycles since the previous snapshot */
+struct telemetry_cpu {
+	/** Cycles spent in threads other than the idle thread */
+	uint32_t busy;
+	/** Cycles spent in the idle thread */
+	uint32_t idle;
+	/** Cycles not accounted to any thread, i.e. spent in interrupts
+	 * on architectures which stop thread accounting while servicing
+	 * them
+	 */
+	uint32_t isr;
+} __packed;
+
+/** Per thread statistics */
+struct telemetry_thread {
+	/** Thread identifier, the low 32 bits of its address */
+	uint32_t id;
+	/** Execution cycles since the thread started. The CPU share of
+	 * the thread is the difference with the previous snapshot
+	 * divided by the interval.
+	 */
+	uint64_t cycles;
+	/** Number of times the thread was switched in, 0 without
+	 * CONFIG_SCHED_THREAD_USAGE_ANALYSIS
+	 */
+	uint32_t switches;
+	/** Stack size, in bytes */
+	uint32_t stack_size;
+	/** Stack high-water mark, in bytes */
+	uint32_t stack_used;
+	/** Priority */
+	int8_t prio;
+	/** Thread state flags */
+	uint8_t state;
+} __packed;
+
+/** Thread name entry header */
+struct telemetry_thread_name {
+	/** Thread identifier, as in struct telemetry_thread */
+	uint32_t id;
+	/** Length of the name following */
+	uint8_t len;
+} __packed;
+
+struct telemetry_backend;
+
+/** Telemetry backend API */
+struct telemetry_backend_api {
+	/** Called once at boot, optional */
+	int (*init)(const struct telemetry_backend *backend);
+	/** Write one complete record */
+	void (*output)(const struct telemetry_backend *backend,
+		       const uint8_t *data, size_t length);
+};
+
+/** Telemetry backend */
+struct telemetry_backend {
+	/** Backend name */
+	const char *name;
+	/** Backend API */
+	const struct telemetry_backend_api *api;
+};
+
+/**
+ * @brief Define a telemetry backend
+ *
+ * Records are written to every backend defined.
+ *
+ * @param _name Backend name.
+ * @param _api Backend API, a struct telemetry_backend_api.
+ */
+#define TELEMETRY_BACKEND_DEFINE(_name, _api)				\
+	static const STRUCT_SECTION_ITERABLE(telemetry_backend, _name) = { \
+		.name = STRINGIFY(_name),				\
+		.api = &_api						\
+	}
+
+/**
+ * @brief Start taking snapshots periodically
+ *
+ * Snapshots are taken by a thread running at the lowest application
+ * priority. With a non-zero CONFIG_TELEMETRY_PERIOD, this is done at
+ * boot.
+ *
+ * @param period_ms Period, in milliseconds
+ *
+ * @retval 0 Started
+ * @retval -EINVAL Invalid period, zero or longer than the 32-bit cycle
+ *         counter wraps around
+ * @retval -EALREADY Already started
+ */
+int telemetry_start(uint32_t period_ms);
+
+/**
+ * @brief Stop taking snapshots periodically
+ *
+ * @retval 0 Stopped
+ * @retval -EALREADY Not started
+ */
+int telemetry_stop(void);
+
+/**
+ * @brief Take a snapshot now
+ *
+ * The snapshot is taken and written to the backends from the calling
+ * thread.
+ *
+ * @retval 0 Snapshot written
+ * @retval -ENODEV No backend defined
+ */
+int telemetry_snapshot(void);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_DEBUG_TELEMETRY_H_ */
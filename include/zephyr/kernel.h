@@ -1646,12 +1646,55 @@ static inline void *z_impl_k_timer_user_data_get(const struct k_timer *timer)
  */
 __syscall int64_t k_uptime_ticks(void);
 
+/** @cond INTERNAL_HIDDEN */
+#ifdef CONFIG_USERSPACE_TIME_PAGE
+/* Tick count published for user mode, see CONFIG_USERSPACE_TIME_PAGE */
+struct z_time_page {
+	uint32_t seq;
+	uint64_t ticks;
+};
+
+extern struct z_time_page z_time_page;
+#endif
+
+static inline int64_t z_uptime_ticks(void)
+{
+#ifdef CONFIG_USERSPACE_TIME_PAGE
+	if (k_is_user_context()) {
+		uint32_t seq;
+		uint64_t ticks;
+
+		/* Only the kernel writes the page.  Should an update
+		 * keep racing with us, ask the kernel instead.
+		 */
+		for (int i = 0; i < 4; i++) {
+			seq = __atomic_load_n(&z_time_page.seq,
+					      __ATOMIC_ACQUIRE);
+			ticks = z_time_page.ticks;
+			__atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+			if (((seq & 1U) == 0U) &&
+			    (__atomic_load_n(&z_time_page.seq,
+					     __ATOMIC_RELAXED) == seq)) {
+				return (int64_t)ticks;
+			}
+		}
+	}
+#endif
+
+	return k_uptime_ticks();
+}
+/** @endcond */
+
 /**
  * @brief Get system uptime.
  *
  * This routine returns the elapsed time since the system booted,
  * in milliseconds.
  *
+ * With @kconfig{CONFIG_USERSPACE_TIME_PAGE}, user threads read the
+ * uptime without making a system call.
+ *
  * @note
  *    While this function returns time in milliseconds, it does
  *    not mean it has millisecond resolution. The actual resolution depends on
@@ -1661,7 +1704,7 @@ __syscall int64_t k_uptime_ticks(void);
  */
 static inline int64_t k_uptime_get(void)
 {
-	return k_ticks_to_ms_floor64(k_uptime_ticks());
+	return k_ticks_to_ms_floor64(z_uptime_ticks());
 }
 
 /**
@@ -2758,6 +2801,7 @@ __syscall int k_stack_pop(struct k_stack *stack, stack_data_t *data,
 
 struct k_work;
 struct k_work_q;
+struct k_work_q_worker;
 struct k_work_queue_config;
 extern struct k_work_q k_sys_work_q;
 
@@ -2964,6 +3008,248 @@ __syscall int k_condvar_wait(struct k_condvar *condvar, struct k_mutex *mutex,
  * @cond INTERNAL_HIDDEN
  */
 
+struct k_rwlock {
+	struct k_spinlock lock;
+	_wait_q_t readers_wait_q;
+	_wait_q_t writers_wait_q;
+	struct k_thread *writer;
+	uint32_t readers;
+};
+
+#define Z_RWLOCK_INITIALIZER(obj)					\
+	{								\
+	.lock = {},							\
+	.readers_wait_q = Z_WAIT_Q_INIT(&obj.readers_wait_q),		\
+	.writers_wait_q = Z_WAIT_Q_INIT(&obj.writers_wait_q),		\
+	.writer = NULL,							\
+	.readers = 0,							\
+	}
+
+/**
+ * INTERNAL_HIDDEN @endcond
+ */
+
+/**
+ * @defgroup rwlock_apis Reader-Writer Lock APIs
+ * @ingroup kernel_apis
+ * @{
+ */
+
+/**
+ * @brief Statically define and initialize a reader-writer lock.
+ *
+ * The lock can be accessed outside the module where it is defined using:
+ *
+ * @code extern struct k_rwlock <name>; @endcode
+ *
+ * @param name Name of the reader-writer lock.
+ */
+#define K_RWLOCK_DEFINE(name)						\
+	STRUCT_SECTION_ITERABLE(k_rwlock, name) =			\
+		Z_RWLOCK_INITIALIZER(name)
+
+/**
+ * @brief Initialize a reader-writer lock.
+ *
+ * Upon completion, the lock is available to readers and writers.
+ *
+ * @param rwlock Address of the reader-writer lock.
+ *
+ * @retval 0 Reader-writer lock initialized.
+ */
+__syscall int k_rwlock_init(struct k_rwlock *rwlock);
+
+/**
+ * @brief Lock a reader-writer lock for reading.
+ *
+ * Any number of threads may hold the lock for reading at the same time,
+ * as long as no thread holds it for writing.  Writers are preferred:
+ * once a writer is waiting for the lock, new readers wait as well, so
+ * a steady stream of readers cannot starve writers.  For the same
+ * reason read locks are not recursive; a thread that already holds the
+ * lock for reading must not lock it for reading again.
+ *
+ * Reader-writer locks do not implement priority inheritance.
+ *
+ * @funcprops \isr_ok with @a timeout set to K_NO_WAIT
+ *
+ * @param rwlock Address of the reader-writer lock.
+ * @param timeout Waiting period to lock the lock,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Lock held for reading.
+ * @retval -EBUSY Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+__syscall int k_rwlock_read_lock(struct k_rwlock *rwlock, k_timeout_t timeout);
+
+/**
+ * @brief Release a reader-writer lock held for reading.
+ *
+ * When the last reader releases the lock, it is handed to the highest
+ * priority waiting writer, if any.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param rwlock Address of the reader-writer lock.
+ *
+ * @retval 0 Lock released.
+ * @retval -EINVAL The lock is not held for reading.
+ */
+__syscall int k_rwlock_read_unlock(struct k_rwlock *rwlock);
+
+/**
+ * @brief Lock a reader-writer lock for writing.
+ *
+ * The lock is held exclusively by one writing thread, and neither
+ * readers nor other writers can take it meanwhile.  Write locks are
+ * not recursive.
+ *
+ * @param rwlock Address of the reader-writer lock.
+ * @param timeout Waiting period to lock the lock,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Lock held for writing.
+ * @retval -EBUSY Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+__syscall int k_rwlock_write_lock(struct k_rwlock *rwlock, k_timeout_t timeout);
+
+/**
+ * @brief Release a reader-writer lock held for writing.
+ *
+ * All readers waiting for the lock are let in first; if there are none,
+ * the lock is handed to the highest priority waiting writer.  Alternating
+ * this way keeps either side from starving the other.
+ *
+ * @param rwlock Address of the reader-writer lock.
+ *
+ * @retval 0 Lock released.
+ * @retval -EPERM The current thread does not hold the lock for writing.
+ */
+__syscall int k_rwlock_write_unlock(struct k_rwlock *rwlock);
+
+/**
+ * @}
+ */
+
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+
+struct k_rcu {
+	struct k_spinlock lock;
+	_wait_q_t wait_q;
+	/* Phase new readers enter, 0 or 1 */
+	atomic_t phase;
+	/* Readers currently inside a critical section, per phase */
+	atomic_t readers[2];
+	/* Set while a grace period is waited for */
+	atomic_t syncing;
+};
+
+#define Z_RCU_INITIALIZER(obj)						\
+	{								\
+	.lock = {},							\
+	.wait_q = Z_WAIT_Q_INIT(&obj.wait_q),				\
+	.phase = ATOMIC_INIT(0),					\
+	.readers = { ATOMIC_INIT(0), ATOMIC_INIT(0) },			\
+	.syncing = ATOMIC_INIT(0),					\
+	}
+
+/**
+ * INTERNAL_HIDDEN @endcond
+ */
+
+/**
+ * @defgroup rcu_apis Read-Copy-Update APIs
+ * @ingroup kernel_apis
+ * @{
+ */
+
+/**
+ * @brief Statically define and initialize an RCU domain.
+ *
+ * The domain can be accessed outside the module where it is defined using:
+ *
+ * @code extern struct k_rcu <name>; @endcode
+ *
+ * @param name Name of the RCU domain.
+ */
+#define K_RCU_DEFINE(name)						\
+	STRUCT_SECTION_ITERABLE(k_rcu, name) =				\
+		Z_RCU_INITIALIZER(name)
+
+/**
+ * @brief Initialize an RCU domain.
+ *
+ * An RCU domain protects read-mostly data that is only ever replaced as
+ * a whole: writers publish a new copy with an atomic pointer store and
+ * call k_rcu_synchronize() before freeing the old copy, while readers
+ * access the current copy inside a read-side critical section without
+ * ever blocking or being blocked by writers.
+ *
+ * @param rcu Address of the RCU domain.
+ *
+ * @retval 0 RCU domain initialized.
+ */
+__syscall int k_rcu_init(struct k_rcu *rcu);
+
+/**
+ * @brief Enter an RCU read-side critical section.
+ *
+ * Data published in the domain before this call, or at any time up to
+ * the matching k_rcu_read_unlock(), stays valid until then.  The
+ * critical section never blocks and may be nested, and the thread may
+ * be preempted or sleep inside it; doing so only delays writers waiting
+ * in k_rcu_synchronize().
+ *
+ * @funcprops \isr_ok
+ *
+ * @param rcu Address of the RCU domain.
+ *
+ * @return Token to pass to the matching k_rcu_read_unlock().
+ */
+__syscall int k_rcu_read_lock(struct k_rcu *rcu);
+
+/**
+ * @brief Leave an RCU read-side critical section.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param rcu Address of the RCU domain.
+ * @param token Value returned by the matching k_rcu_read_lock().
+ *
+ * @retval 0 Critical section left.
+ * @retval -EINVAL Invalid token.
+ */
+__syscall int k_rcu_read_unlock(struct k_rcu *rcu, int token);
+
+/**
+ * @brief Wait for all pre-existing RCU readers to finish.
+ *
+ * Blocks until every read-side critical section of the domain that was
+ * entered before this call has been left.  Once it returns, data that
+ * was unpublished before the call can no longer be referenced by any
+ * reader and may be freed or reused.  Concurrent callers are serialized.
+ *
+ * This must not be called from within a read-side critical section of
+ * the same domain.
+ *
+ * @param rcu Address of the RCU domain.
+ *
+ * @retval 0 Grace period elapsed.
+ */
+__syscall int k_rcu_synchronize(struct k_rcu *rcu);
+
+/**
+ * @}
+ */
+
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+
 struct k_sem {
 	_wait_q_t wait_q;
 	unsigned int count;
@@ -3322,6 +3608,37 @@ void k_work_queue_start(struct k_work_q *queue,
 			k_thread_stack_t *stack, size_t stack_size,
 			int prio, const struct k_work_queue_config *cfg);
 
+/** @brief Add a worker thread to a work queue.
+ *
+ * This turns a started work queue into a pool: the new thread runs items
+ * of @p queue alongside the queue thread and any workers added before,
+ * at the priority the queue was started with.  Every worker has its own
+ * list of pending items; submissions from outside the queue are spread
+ * over the workers, work submitted from a handler goes to the worker
+ * running it, and an idle worker steals items from the others.
+ *
+ * The state of a work item behaves exactly as with a single thread.  In
+ * particular an item is never run by two workers at once, cancel and
+ * flush wait for the one that runs it, and k_work_queue_drain() waits
+ * for all of them.  Different items can however run concurrently, so
+ * handlers must not rely on the queue to serialize them.
+ *
+ * Workers cannot be removed again.
+ *
+ * @note Available when @kconfig{CONFIG_WORKQUEUE_POOL} is enabled.
+ *
+ * @param queue pointer to a work queue started with k_work_queue_start().
+ *
+ * @param worker worker object, which must not be in use.
+ *
+ * @param stack pointer to the worker thread stack area.
+ *
+ * @param stack_size size of the the worker thread stack area, in bytes.
+ */
+void k_work_queue_add_worker(struct k_work_q *queue,
+			     struct k_work_q_worker *worker,
+			     k_thread_stack_t *stack, size_t stack_size);
+
 /** @brief Access the thread that animates a work queue.
  *
  * This is necessary to grant a work queue thread access to things the work
@@ -3884,7 +4201,44 @@ struct k_work_q {
 
 	/* Flags describing queue state. */
 	uint32_t flags;
+
+#ifdef CONFIG_WORKQUEUE_POOL
+	/* Item being run by the queue thread, if any. */
+	struct k_work *running;
+
+	/* Additional k_work_q_worker threads. */
+	sys_slist_t workers;
+
+	/* Worker that gets the next submission from outside the
+	 * queue, NULL for the queue thread.
+	 */
+	struct k_work_q_worker *next_worker;
+#endif
+};
+
+#ifdef CONFIG_WORKQUEUE_POOL
+/** @brief An additional thread of a work queue pool.
+ *
+ * See k_work_queue_add_worker().
+ */
+struct k_work_q_worker {
+	/* The thread that animates the work. */
+	struct k_thread thread;
+
+	/* All the following fields must be accessed only while the
+	 * work module spinlock is held.
+	 */
+
+	/* Node in the queue's list of workers. */
+	sys_snode_t node;
+
+	/* List of k_work items to be worked by this worker. */
+	sys_slist_t pending;
+
+	/* Item being run by this worker, if any. */
+	struct k_work *running;
 };
+#endif
 
 /* Provide the implementation for inline functions declared above */
 
@@ -4310,6 +4664,8 @@ struct k_msgq {
 
 
 #define K_MSGQ_FLAG_ALLOC	BIT(0)
+#define K_MSGQ_FLAG_PUT_CLAIM	BIT(1)
+#define K_MSGQ_FLAG_GET_CLAIM	BIT(2)
 
 /**
  * @brief Message Queue Attributes
@@ -4424,9 +4780,39 @@ int k_msgq_cleanup(struct k_msgq *msgq);
  * @retval 0 Message sent.
  * @retval -ENOMSG Returned without waiting or queue purged.
  * @retval -EAGAIN Waiting period timed out.
+ * @retval -EBUSY A put claim is outstanding, see k_msgq_put_claim().
  */
 __syscall int k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t timeout);
 
+/**
+ * @brief Send several messages to a message queue.
+ *
+ * This routine sends up to @a num_msgs consecutive messages from @a data
+ * to message queue @a msgq, taking the queue lock and rescheduling at most
+ * once for the whole batch. Threads waiting to receive get the first
+ * messages, the rest are queued until the queue is full.
+ *
+ * If the queue is full on entry the routine waits, like k_msgq_put(),
+ * until the first message has been sent and then returns.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ * @param data Pointer to an array of @a num_msgs messages.
+ * @param num_msgs Number of messages in @a data.
+ * @param timeout Non-negative waiting period for space to become
+ *                available, or one of the special values K_NO_WAIT and
+ *                K_FOREVER.
+ *
+ * @return Number of messages sent, which may be less than @a num_msgs, or
+ *         a negative error code:
+ * @retval -ENOMSG Queue full and returned without waiting, or queue purged.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EBUSY A put claim is outstanding, see k_msgq_put_claim().
+ */
+__syscall int k_msgq_put_many(struct k_msgq *msgq, const void *data,
+			      uint32_t num_msgs, k_timeout_t timeout);
+
 /**
  * @brief Receive a message from a message queue.
  *
@@ -4446,9 +4832,129 @@ __syscall int k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t time
  * @retval 0 Message received.
  * @retval -ENOMSG Returned without waiting.
  * @retval -EAGAIN Waiting period timed out.
+ * @retval -EBUSY A get claim is outstanding, see k_msgq_get_claim().
  */
 __syscall int k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout);
 
+/**
+ * @brief Receive several messages from a message queue.
+ *
+ * This routine receives up to @a max_msgs messages from message queue
+ * @a msgq into @a data, in "first in, first out" order, taking the queue
+ * lock and rescheduling at most once for the whole batch. Threads waiting
+ * to send refill the space that was freed.
+ *
+ * If the queue is empty on entry the routine waits, like k_msgq_get(),
+ * for a single message and then returns.
+ *
+ * @note @a timeout must be set to K_NO_WAIT if called from ISR.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ * @param data Address of an area that can hold @a max_msgs messages.
+ * @param max_msgs Maximum number of messages to receive.
+ * @param timeout Waiting period to receive a message,
+ *                or one of the special values K_NO_WAIT and
+ *                K_FOREVER.
+ *
+ * @return Number of messages received, or a negative error code:
+ * @retval -ENOMSG Queue empty and returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EBUSY A get claim is outstanding, see k_msgq_get_claim().
+ */
+__syscall int k_msgq_get_many(struct k_msgq *msgq, void *data,
+			      uint32_t max_msgs, k_timeout_t timeout);
+
+/**
+ * @brief Claim space in a message queue for writing messages in place.
+ *
+ * This routine returns free message slots of @a msgq that the caller can
+ * fill directly, without copying the messages from a separate buffer.
+ * The slots are contiguous, so fewer than @a max_msgs may be returned
+ * when the free space wraps around the end of the ring buffer. The
+ * messages become visible to receivers once k_msgq_put_commit() is
+ * called.
+ *
+ * Only one put claim can be outstanding at a time. While it is, other
+ * attempts to send to the queue fail with -EBUSY. Claiming does not
+ * wait; use k_msgq_num_free_get() or retry later when the queue is full.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ * @param data Set to the first claimed message slot.
+ * @param max_msgs Maximum number of message slots to claim.
+ *
+ * @return Number of message slots claimed, 0 if the queue is full (no
+ *         claim is then outstanding), or -EBUSY if a put claim is
+ *         already outstanding.
+ */
+int k_msgq_put_claim(struct k_msgq *msgq, void **data, uint32_t max_msgs);
+
+/**
+ * @brief Send messages written in place.
+ *
+ * This routine completes a claim made with k_msgq_put_claim(), sending
+ * the first @a num_msgs claimed slots as messages and releasing the rest.
+ * Threads waiting to receive are woken up with a single reschedule.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ * @param num_msgs Number of messages written, at most the number claimed.
+ *
+ * @retval 0 Messages sent.
+ * @retval -EINVAL No put claim is outstanding or @a num_msgs is larger
+ *         than the claim.
+ */
+int k_msgq_put_commit(struct k_msgq *msgq, uint32_t num_msgs);
+
+/**
+ * @brief Claim messages of a message queue for reading them in place.
+ *
+ * This routine returns the oldest messages of @a msgq so that the caller
+ * can process them directly in the ring buffer. The messages are
+ * contiguous, so fewer than @a max_msgs may be returned when they wrap
+ * around the end of the ring buffer. They stay in the queue, and their
+ * space is not reused, until k_msgq_get_commit() is called.
+ *
+ * Only one get claim can be outstanding at a time. While it is, other
+ * attempts to receive from the queue fail with -EBUSY. Purging the queue
+ * cancels the claim. Claiming does not wait; k_poll() with
+ * K_POLL_TYPE_MSGQ_DATA_AVAILABLE can be used to wait for messages.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ * @param data Set to the first claimed message.
+ * @param max_msgs Maximum number of messages to claim.
+ *
+ * @return Number of messages claimed, 0 if the queue is empty (no claim
+ *         is then outstanding), or -EBUSY if a get claim is already
+ *         outstanding.
+ */
+int k_msgq_get_claim(struct k_msgq *msgq, void **data, uint32_t max_msgs);
+
+/**
+ * @brief Remove messages read in place.
+ *
+ * This routine completes a claim made with k_msgq_get_claim(), removing
+ * the first @a num_msgs claimed messages from the queue and leaving the
+ * rest in place. Threads waiting to send are woken up with a single
+ * reschedule.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ * @param num_msgs Number of messages consumed, at most the number claimed.
+ *
+ * @retval 0 Messages removed.
+ * @retval -EINVAL No get claim is outstanding or @a num_msgs is larger
+ *         than the claim.
+ */
+int k_msgq_get_commit(struct k_msgq *msgq, uint32_t num_msgs);
+
 /**
  * @brief Peek/read a message from a message queue.
  *
@@ -4705,6 +5211,12 @@ extern void k_mbox_data_get(struct k_mbox_msg *rx_msg, void *buffer);
  * @{
  */
 
+/** Pipe scatter/gather segment */
+struct k_pipe_iovec {
+	void          *data;            /**< Segment address */
+	size_t         len;             /**< Segment size (in bytes) */
+};
+
 /** Pipe Structure */
 struct k_pipe {
 	unsigned char *buffer;          /**< Pipe buffer: may be NULL */
@@ -4730,6 +5242,8 @@ struct k_pipe {
  * @cond INTERNAL_HIDDEN
  */
 #define K_PIPE_FLAG_ALLOC	BIT(0)	/** Buffer was allocated */
+#define K_PIPE_FLAG_PUT_CLAIM	BIT(1)	/** Free space is claimed */
+#define K_PIPE_FLAG_GET_CLAIM	BIT(2)	/** Buffered data is claimed */
 
 #define Z_PIPE_INITIALIZER(obj, pipe_buffer, pipe_buffer_size)     \
 	{                                                           \
@@ -4830,6 +5344,7 @@ __syscall int k_pipe_alloc_init(struct k_pipe *pipe, size_t size);
  * @retval -EIO Returned without waiting; zero data bytes were written.
  * @retval -EAGAIN Waiting period timed out; between zero and @a min_xfer
  *                 minus one data bytes were written.
+ * @retval -EBUSY A put claim is outstanding, see k_pipe_put_claim().
  */
 __syscall int k_pipe_put(struct k_pipe *pipe, void *data,
 			 size_t bytes_to_write, size_t *bytes_written,
@@ -4853,11 +5368,160 @@ __syscall int k_pipe_put(struct k_pipe *pipe, void *data,
  * @retval -EIO Returned without waiting; zero data bytes were read.
  * @retval -EAGAIN Waiting period timed out; between zero and @a min_xfer
  *                 minus one data bytes were read.
+ * @retval -EBUSY A get claim is outstanding, see k_pipe_get_claim().
  */
 __syscall int k_pipe_get(struct k_pipe *pipe, void *data,
 			 size_t bytes_to_read, size_t *bytes_read,
 			 size_t min_xfer, k_timeout_t timeout);
 
+/**
+ * @brief Write data from a scatter/gather list to a pipe.
+ *
+ * This routine works like k_pipe_put(), but gathers the data to write
+ * from the segments of @a iov, in order, so that data which is not
+ * contiguous in memory (e.g. a header and a payload) does not need to
+ * be copied into one buffer first.  The segments are written as one
+ * stream of bytes.  The list and the segments must stay valid until the
+ * routine returns.
+ *
+ * This routine is not available to user mode threads.
+ *
+ * @param pipe Address of the pipe.
+ * @param iov Segments to write.
+ * @param iov_cnt Number of segments in @a iov.
+ * @param bytes_written Address of area to hold the number of bytes written.
+ * @param min_xfer Minimum number of bytes to write.
+ * @param timeout Waiting period to wait for the data to be written,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 At least @a min_xfer bytes of data were written.
+ * @retval -EINVAL invalid parameters supplied
+ * @retval -EIO Returned without waiting; zero data bytes were written.
+ * @retval -EAGAIN Waiting period timed out; between zero and @a min_xfer
+ *                 minus one data bytes were written.
+ * @retval -EBUSY A put claim is outstanding, see k_pipe_put_claim().
+ */
+int k_pipe_put_iov(struct k_pipe *pipe, const struct k_pipe_iovec *iov,
+		   size_t iov_cnt, size_t *bytes_written, size_t min_xfer,
+		   k_timeout_t timeout);
+
+/**
+ * @brief Read data from a pipe into a scatter/gather list.
+ *
+ * This routine works like k_pipe_get(), but scatters the data read over
+ * the segments of @a iov, filling them in order.
+ *
+ * This routine is not available to user mode threads.
+ *
+ * @param pipe Address of the pipe.
+ * @param iov Segments to fill.
+ * @param iov_cnt Number of segments in @a iov.
+ * @param bytes_read Address of area to hold the number of bytes read.
+ * @param min_xfer Minimum number of data bytes to read.
+ * @param timeout Waiting period to wait for the data to be read,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 At least @a min_xfer bytes of data were read.
+ * @retval -EINVAL invalid parameters supplied
+ * @retval -EIO Returned without waiting; zero data bytes were read.
+ * @retval -EAGAIN Waiting period timed out; between zero and @a min_xfer
+ *                 minus one data bytes were read.
+ * @retval -EBUSY A get claim is outstanding, see k_pipe_get_claim().
+ */
+int k_pipe_get_iov(struct k_pipe *pipe, const struct k_pipe_iovec *iov,
+		   size_t iov_cnt, size_t *bytes_read, size_t min_xfer,
+		   k_timeout_t timeout);
+
+/**
+ * @brief Claim free space of a pipe's ring buffer for writing in place.
+ *
+ * This routine hands the caller a contiguous area of free space in the
+ * ring buffer of @a pipe, so that data can be produced directly into the
+ * pipe (e.g. by DMA) instead of being copied in by k_pipe_put().  The
+ * data becomes visible to readers once k_pipe_put_commit() is called.
+ *
+ * Only one put claim can be outstanding at a time.  While it is, other
+ * writes to the pipe fail with -EBUSY.  Claiming does not wait; nothing
+ * is claimed while the ring buffer is full or writers are waiting.
+ *
+ * This routine is not available to user mode threads.
+ *
+ * @param pipe Address of the pipe.
+ * @param data Set to the start of the claimed area.
+ * @param max_bytes Maximum number of bytes to claim.
+ * @param bytes_claimed Set to the number of bytes claimed; if this is 0
+ *                      no claim is outstanding.
+ *
+ * @retval 0 Success.
+ * @retval -EBUSY A put claim is already outstanding.
+ */
+int k_pipe_put_claim(struct k_pipe *pipe, void **data, size_t max_bytes,
+		     size_t *bytes_claimed);
+
+/**
+ * @brief Write data produced in place to a pipe.
+ *
+ * This routine completes a claim made with k_pipe_put_claim(), writing
+ * the first @a bytes claimed bytes to the pipe and releasing the rest.
+ *
+ * This routine is not available to user mode threads.
+ *
+ * @param pipe Address of the pipe.
+ * @param bytes Number of bytes produced, at most the number claimed.
+ *
+ * @retval 0 Success.
+ * @retval -EINVAL No put claim is outstanding or @a bytes is larger than
+ *         the claim.
+ */
+int k_pipe_put_commit(struct k_pipe *pipe, size_t bytes);
+
+/**
+ * @brief Claim data in a pipe's ring buffer for reading in place.
+ *
+ * This routine hands the caller a contiguous area of data in the ring
+ * buffer of @a pipe, so that it can be consumed without being copied out
+ * by k_pipe_get().  The data stays in the pipe, and its space is not
+ * reused, until k_pipe_get_commit() is called.  Data from writers that
+ * are still waiting is only available once it has reached the ring
+ * buffer.
+ *
+ * Only one get claim can be outstanding at a time.  While it is, other
+ * reads from the pipe fail with -EBUSY; flushing the pipe cancels the
+ * claim.  Claiming does not wait; k_poll() with
+ * K_POLL_TYPE_PIPE_DATA_AVAILABLE can be used to wait for data.
+ *
+ * This routine is not available to user mode threads.
+ *
+ * @param pipe Address of the pipe.
+ * @param data Set to the start of the claimed data.
+ * @param max_bytes Maximum number of bytes to claim.
+ * @param bytes_claimed Set to the number of bytes claimed; if this is 0
+ *                      no claim is outstanding.
+ *
+ * @retval 0 Success.
+ * @retval -EBUSY A get claim is already outstanding.
+ */
+int k_pipe_get_claim(struct k_pipe *pipe, void **data, size_t max_bytes,
+		     size_t *bytes_claimed);
+
+/**
+ * @brief Remove data consumed in place from a pipe.
+ *
+ * This routine completes a claim made with k_pipe_get_claim(), removing
+ * the first @a bytes claimed bytes from the pipe and leaving the rest to
+ * be read again.
+ *
+ * This routine is not available to user mode threads.
+ *
+ * @param pipe Address of the pipe.
+ * @param bytes Number of bytes consumed, at most the number claimed.
+ *
+ * @retval 0 Success.
+ * @retval -EINVAL No get claim is outstanding or @a bytes is larger than
+ *         the claim.
+ */
+int k_pipe_get_commit(struct k_pipe *pipe, size_t bytes);
+
 /**
  * @brief Query the number of bytes that may be read from @a pipe.
  *
@@ -4909,6 +5573,16 @@ __syscall void k_pipe_buffer_flush(struct k_pipe *pipe);
  * @cond INTERNAL_HIDDEN
  */
 
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+/* Per-CPU stack of free blocks.  Only the owning CPU pushes and pops
+ * (with CAS); other CPUs may only detach the whole list at once.
+ */
+struct z_mem_slab_cpu_cache {
+	atomic_ptr_t head;
+	uint32_t count;
+};
+#endif
+
 struct k_mem_slab {
 	_wait_q_t wait_q;
 	struct k_spinlock lock;
@@ -4916,9 +5590,19 @@ struct k_mem_slab {
 	size_t block_size;
 	char *buffer;
 	char *free_list;
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+	atomic_t num_used;
+#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
+	atomic_t max_used;
+#endif
+	/* threads about to pend; cached frees must wake them */
+	atomic_t waiters;
+	struct z_mem_slab_cpu_cache cpu_cache[CONFIG_MP_MAX_NUM_CPUS];
+#else
 	uint32_t num_used;
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	uint32_t max_used;
+#endif
 #endif
 
 	SYS_PORT_TRACING_TRACKING_FIELD(k_mem_slab)
@@ -5072,7 +5756,11 @@ extern void k_mem_slab_free(struct k_mem_slab *slab, void **mem);
  */
 static inline uint32_t k_mem_slab_num_used_get(struct k_mem_slab *slab)
 {
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+	return (uint32_t)atomic_get(&slab->num_used);
+#else
 	return slab->num_used;
+#endif
 }
 
 /**
@@ -5087,7 +5775,9 @@ static inline uint32_t k_mem_slab_num_used_get(struct k_mem_slab *slab)
  */
 static inline uint32_t k_mem_slab_max_used_get(struct k_mem_slab *slab)
 {
-#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
+#if defined(CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION) && defined(CONFIG_MEM_SLAB_PER_CPU_CACHE)
+	return (uint32_t)atomic_get(&slab->max_used);
+#elif defined(CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION)
 	return slab->max_used;
 #else
 	ARG_UNUSED(slab);
@@ -5107,7 +5797,7 @@ static inline uint32_t k_mem_slab_max_used_get(struct k_mem_slab *slab)
  */
 static inline uint32_t k_mem_slab_num_free_get(struct k_mem_slab *slab)
 {
-	return slab->num_blocks - slab->num_used;
+	return slab->num_blocks - k_mem_slab_num_used_get(slab);
 }
 
 /**
@@ -5150,6 +5840,10 @@ struct k_heap {
 	struct sys_heap heap;
 	_wait_q_t wait_q;
 	struct k_spinlock lock;
+#ifdef CONFIG_SYS_HEAP_CACHE
+	/* threads about to pend; frees into the cache must wake them */
+	atomic_t waiters;
+#endif
 };
 
 /**
@@ -5555,6 +6249,45 @@ struct k_poll_event {
 	}, \
 	}
 
+/**
+ * @brief Poll set member
+ *
+ * Wraps a poll event so that it can be registered with a poll set.
+ */
+struct k_poll_set_event {
+	/** event to watch, set up with k_poll_event_init() */
+	struct k_poll_event event;
+
+	/**
+	 * K_POLL_STATE_xxx values that made the member ready, set by
+	 * k_poll_set_wait() when it returns the member
+	 */
+	uint32_t state;
+
+	/** PRIVATE - DO NOT TOUCH */
+	sys_dnode_t _ready_node;
+};
+
+/**
+ * @brief Poll set
+ *
+ * A set of poll events that stay registered with their objects across
+ * waits, see k_poll_set_init().
+ */
+struct k_poll_set {
+	/** PRIVATE - DO NOT TOUCH */
+	struct z_poller poller;
+
+	/** PRIVATE - DO NOT TOUCH */
+	sys_dlist_t ready;
+
+	/** PRIVATE - DO NOT TOUCH */
+	_wait_q_t wait_q;
+
+	/** PRIVATE - DO NOT TOUCH */
+	struct k_spinlock lock;
+};
+
 /**
  * @brief Initialize one struct k_poll_event instance
  *
@@ -5675,6 +6408,94 @@ __syscall void k_poll_signal_check(struct k_poll_signal *sig,
 
 __syscall int k_poll_signal_raise(struct k_poll_signal *sig, int result);
 
+/**
+ * @brief Initialize a poll set.
+ *
+ * A poll set is an alternative to k_poll() for a thread that waits on
+ * the same, possibly large, group of objects over and over.  Events are
+ * registered with their objects once, by k_poll_set_add(), instead of on
+ * every call to k_poll().  An object whose state changes queues its event
+ * to the ready list of the set, and k_poll_set_wait() just takes events
+ * from that list, so its cost does not depend on the size of the set.
+ *
+ * Members are reported once per state change of their object and are
+ * not reported again until the next one: after an event has been
+ * returned the caller is expected to drain the object, e.g. by taking a
+ * semaphore or getting from a FIFO with K_NO_WAIT until that fails.
+ * Threads pending on an object and k_poll() callers watching it are
+ * notified of a state change before a poll set is.
+ *
+ * Poll sets and their members are not accessible from user mode.
+ *
+ * @param set Poll set to initialize.
+ */
+extern void k_poll_set_init(struct k_poll_set *set);
+
+/**
+ * @brief Add an event to a poll set.
+ *
+ * The event of @a member must have been initialized with
+ * k_poll_event_init() and stays registered with its object until it is
+ * removed from the set.  If the object is already available, the member
+ * is reported by the next k_poll_set_wait().
+ *
+ * The member must not be passed to k_poll() or k_work_poll_submit(), or
+ * be modified, while it is part of the set.
+ *
+ * @param set Poll set.
+ * @param member Poll set member.
+ *
+ * @retval 0 The member was added.
+ * @retval -EALREADY The member is already registered.
+ * @retval -EINVAL The event type is K_POLL_TYPE_IGNORE.
+ */
+extern int k_poll_set_add(struct k_poll_set *set,
+			  struct k_poll_set_event *member);
+
+/**
+ * @brief Remove an event from a poll set.
+ *
+ * Unregisters the event from its object and drops it from the ready
+ * list if it has not been reported yet.
+ *
+ * @param set Poll set.
+ * @param member Poll set member.
+ *
+ * @retval 0 The member was removed.
+ * @retval -EINVAL The member is not part of @a set.
+ */
+extern int k_poll_set_remove(struct k_poll_set *set,
+			     struct k_poll_set_event *member);
+
+/**
+ * @brief Wait for events of a poll set.
+ *
+ * Takes up to @a max_events members off the ready list of @a set,
+ * waiting for one to become ready if the list is empty.  The state field
+ * of a returned member holds the K_POLL_STATE_xxx values that made it
+ * ready, as k_poll() would have set them in the event.  It is copied
+ * while the member is taken off the list, so objects signalling the
+ * member again do not change it.  Members stay in the set and nothing
+ * needs to be reset.
+ *
+ * More than one thread can wait on the same set, each member is then
+ * reported to only one of them.  The state field of a member is valid
+ * until the member is reported again.
+ *
+ * @param set Poll set.
+ * @param ready Array to store the ready members in.
+ * @param max_events Size of @a ready, must be at least 1.
+ * @param timeout Waiting period for a member to be ready,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Number of members stored in @a ready (at least 1)
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EINVAL @a max_events is not positive.
+ */
+extern int k_poll_set_wait(struct k_poll_set *set,
+			   struct k_poll_set_event **ready, int max_events,
+			   k_timeout_t timeout);
+
 /**
  * @internal
  */
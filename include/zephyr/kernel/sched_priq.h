@@ -49,12 +49,20 @@ struct k_thread *z_priq_rb_best(struct _priq_rb *pq);
  * comparatively high, but performance is very fast.  Won't work with
  * features like deadline scheduling which need large priority spaces
  * to represent their requirements.
+ *
+ * Only the lists whose bit is set are valid; an empty list is
+ * (re)initialized when a thread is first added to it, so an all-zero
+ * structure is a valid empty queue.
  */
+#define Z_PRIQ_MQ_LEVELS MIN(32, (CONFIG_NUM_COOP_PRIORITIES + \
+				  CONFIG_NUM_PREEMPT_PRIORITIES + 1))
+
 struct _priq_mq {
-	sys_dlist_t queues[32];
+	sys_dlist_t queues[Z_PRIQ_MQ_LEVELS];
 	unsigned int bitmask; /* bit 1<<i set if queues[i] is non-empty */
 };
 
 struct k_thread *z_priq_mq_best(struct _priq_mq *pq);
+struct k_thread *z_priq_mq_next(struct _priq_mq *pq, struct k_thread *thread);
 
 #endif /* ZEPHYR_INCLUDE_SCHED_PRIQ_H_ */
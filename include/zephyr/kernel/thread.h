@@ -40,6 +40,7 @@ struct __thread_entry {
 #endif
 
 struct k_thread;
+struct k_pipe_iovec;
 
 /*
  * This _pipe_desc structure is used by the pipes kernel module when
@@ -51,6 +52,9 @@ struct _pipe_desc {
 	unsigned char   *buffer;         /* Position in src/dest buffer */
 	size_t           bytes_to_xfer;  /* # bytes left to transfer */
 	struct k_thread *thread;         /* Back pointer to pended thread */
+	const struct k_pipe_iovec *iov;  /* Segments after the current one */
+	size_t           iov_cnt;        /* # segments after the current one */
+	size_t           iov_bytes;      /* # bytes in those segments */
 };
 
 /* can be used for creating 'dummy' threads, e.g. for pending on objects */
@@ -113,6 +117,11 @@ struct _thread_base {
 	/* CPU index on which thread was last run */
 	uint8_t cpu;
 
+#ifdef CONFIG_SCHED_CPU_RUNQ_STEAL
+	/* CPU whose run queue holds the thread while it is queued */
+	uint8_t runq_cpu;
+#endif
+
 	/* Recursive count of irq_lock() calls */
 	uint8_t global_lock_count;
 
@@ -181,6 +190,18 @@ struct _mem_domain_info {
 
 #endif /* CONFIG_USERSPACE */
 
+#ifdef CONFIG_USERSPACE_OBJ_CACHE
+struct z_object;
+
+/* Kernel objects recently looked up by the thread's system calls */
+struct _thread_obj_cache {
+	const void *obj[CONFIG_USERSPACE_OBJ_CACHE_SIZE];
+	struct z_object *ko[CONFIG_USERSPACE_OBJ_CACHE_SIZE];
+	/* Object metadata generation the entries are valid for */
+	uint32_t gen;
+};
+#endif /* CONFIG_USERSPACE_OBJ_CACHE */
+
 #ifdef CONFIG_THREAD_USERSPACE_LOCAL_DATA
 struct _thread_userspace_local_data {
 #if defined(CONFIG_ERRNO) && !defined(CONFIG_ERRNO_IN_TLS) && !defined(CONFIG_LIBC_ERRNO)
@@ -310,6 +331,10 @@ struct k_thread {
 	k_thread_stack_t *stack_obj;
 	/** current syscall frame pointer */
 	void *syscall_frame;
+#ifdef CONFIG_USERSPACE_OBJ_CACHE
+	/** kernel object lookup cache */
+	struct _thread_obj_cache obj_cache;
+#endif
 #endif /* CONFIG_USERSPACE */
 
 
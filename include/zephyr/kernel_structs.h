@@ -110,10 +110,15 @@ struct _cpu {
 	/* one assigned idle thread per CPU */
 	struct k_thread *idle_thread;
 
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) || defined(CONFIG_SCHED_CPU_RUNQ_STEAL)
 	struct _ready_q ready_q;
 #endif
 
+#ifdef CONFIG_SCHED_CPU_RUNQ_STEAL
+	/* Number of threads in ready_q */
+	uint32_t runq_len;
+#endif
+
 #if (CONFIG_NUM_METAIRQ_PRIORITIES > 0) && (CONFIG_NUM_COOP_PRIORITIES > 0)
 	/* Coop thread preempted by current metairq, or NULL */
 	struct k_thread *metairq_preempted;
@@ -157,11 +162,16 @@ struct z_kernel {
 	int32_t idle; /* Number of ticks for kernel idling */
 #endif
 
+#ifdef CONFIG_SCHED_CPU_RUNQ_STEAL
+	/* Mask of the CPUs whose run queue is not empty */
+	uint32_t runq_cpus;
+#endif
+
 	/*
 	 * ready queue: can be big, keep after small fields, since some
 	 * assembly (e.g. ARC) are limited in the encoding of the offset
 	 */
-#ifndef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if !defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) && !defined(CONFIG_SCHED_CPU_RUNQ_STEAL)
 	struct _ready_q ready_q;
 #endif
 
@@ -221,6 +231,14 @@ extern bool z_priq_rb_lessthan(struct rbnode *a, struct rbnode *b);
 
 #define Z_WAIT_Q_INIT(wait_q) { { { .lessthan_fn = z_priq_rb_lessthan } } }
 
+#elif defined(CONFIG_WAITQ_MULTIQ)
+
+typedef struct {
+	struct _priq_mq waitq;
+} _wait_q_t;
+
+#define Z_WAIT_Q_INIT(wait_q) { { .bitmask = 0U } }
+
 #else
 
 typedef struct {
@@ -240,11 +258,18 @@ struct _timeout {
 	sys_dnode_t node;
 	_timeout_func_t fn;
 #ifdef CONFIG_TIMEOUT_64BIT
-	/* Can't use k_ticks_t for header dependency reasons */
+	/* Can't use k_ticks_t for header dependency reasons.  Delta
+	 * from the previous timeout, or the absolute expiry tick with
+	 * CONFIG_TIMEOUT_QUEUE_WHEEL.
+	 */
 	int64_t dticks;
 #else
 	int32_t dticks;
 #endif
+#ifdef CONFIG_TIMEOUT_PER_CPU
+	/* CPU whose timeout queue holds this timeout */
+	uint8_t cpu;
+#endif
 };
 
 typedef void (*k_thread_timeslice_fn_t)(struct k_thread *thread, void *data);
@@ -11,6 +11,8 @@
 #ifndef ZEPHYR_INCLUDE_NET_LOOPBACK_H_
 #define ZEPHYR_INCLUDE_NET_LOOPBACK_H_
 
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -33,6 +35,21 @@ int loopback_set_packet_drop_ratio(float ratio);
 int loopback_get_num_dropped_packets(void);
 #endif
 
+#ifdef CONFIG_NET_LOOPBACK_SIMULATE_PACKET_DELAY
+/**
+ * @brief Set the packet delay
+ *
+ * Packets are looped back after the delay. Once
+ * CONFIG_NET_LOOPBACK_DELAY_QUEUE_SIZE packets are waiting, further
+ * packets are dropped.
+ *
+ * @param[in] delay_ms Delay in milliseconds, 0 to loop back immediately
+ *
+ * @return 0 on success, otherwise a negative integer.
+ */
+int loopback_set_packet_delay(uint32_t delay_ms);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -322,6 +322,14 @@ __net_socket struct net_context {
 #endif
 #if defined(CONFIG_NET_CONTEXT_DSCP_ECN)
 		uint8_t dscp_ecn;
+#endif
+#if defined(CONFIG_NET_CONTEXT_RECV_PKTINFO)
+		/** Report the destination of received packets */
+		bool recv_pktinfo;
+#endif
+#if defined(CONFIG_NET_CONTEXT_TIMESTAMPING)
+		/** SO_TIMESTAMPING flags */
+		uint8_t timestamping;
 #endif
 	} options;
 
@@ -1073,6 +1081,8 @@ enum net_context_option {
 	NET_OPT_RCVBUF		= 6,
 	NET_OPT_SNDBUF		= 7,
 	NET_OPT_DSCP_ECN	= 8,
+	NET_OPT_RECV_PKTINFO	= 9,
+	NET_OPT_TIMESTAMPING	= 10,
 };
 
 /**
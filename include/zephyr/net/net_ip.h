@@ -245,6 +245,11 @@ struct msghdr {
 	int           msg_flags;      /* flags on received message */
 };
 
+struct mmsghdr {
+	struct msghdr msg_hdr;        /* message */
+	unsigned int  msg_len;        /* bytes sent or received */
+};
+
 struct cmsghdr {
 	socklen_t cmsg_len;    /* Number of bytes, including header */
 	int       cmsg_level;  /* Originating protocol */
@@ -292,6 +297,19 @@ struct cmsghdr {
 #define CMSG_LEN(length) (ALIGN_D(sizeof(struct cmsghdr)) + length)
 #endif
 
+/** Ancillary data of an IPv4 packet, see IP_PKTINFO */
+struct in_pktinfo {
+	unsigned int   ipi_ifindex;  /* Interface index */
+	struct in_addr ipi_spec_dst; /* Local address */
+	struct in_addr ipi_addr;     /* Destination address */
+};
+
+/** Ancillary data of an IPv6 packet, see IPV6_RECVPKTINFO */
+struct in6_pktinfo {
+	struct in6_addr ipi6_addr;    /* Destination address */
+	unsigned int    ipi6_ifindex; /* Interface index */
+};
+
 /** @cond INTERNAL_HIDDEN */
 
 /* Packet types.  */
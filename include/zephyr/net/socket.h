@@ -55,6 +55,10 @@ struct zsock_pollfd {
 
 /** zsock_recv: Read data without removing it from socket input queue */
 #define ZSOCK_MSG_PEEK 0x02
+/** zsock_recvmsg: Control data was truncated (output value only, in
+ *  msg_flags)
+ */
+#define ZSOCK_MSG_CTRUNC 0x08
 /** zsock_recv: return the real length of the datagram, even when it was longer
  *  than the passed buffer
  */
@@ -63,6 +67,8 @@ struct zsock_pollfd {
 #define ZSOCK_MSG_DONTWAIT 0x40
 /** zsock_recv: block until the full amount of data can be returned */
 #define ZSOCK_MSG_WAITALL 0x100
+/** zsock_recvmmsg: Block for the first message only */
+#define ZSOCK_MSG_WAITFORONE 0x10000
 
 /* Well-known values, e.g. from Linux man 2 shutdown:
  * "The constants SHUT_RD, SHUT_WR, SHUT_RDWR have the value 0, 1, 2,
@@ -403,6 +409,29 @@ static inline ssize_t zsock_send(int sock, const void *buf, size_t len,
 __syscall ssize_t zsock_sendmsg(int sock, const struct msghdr *msg,
 				int flags);
 
+/**
+ * @brief Send multiple messages on a socket
+ *
+ * @details
+ * Sends the messages of @a msgvec in order, as zsock_sendmsg() would, but
+ * locks the socket once for the whole batch. The number of bytes sent for
+ * each message is stored in its msg_len field. Sending stops at the first
+ * message which cannot be sent.
+ *
+ * This function is also exposed as ``sendmmsg()``
+ * if :kconfig:option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ *
+ * @param sock Socket
+ * @param msgvec Messages to send
+ * @param vlen Number of messages in @a msgvec
+ * @param flags Flags, as for zsock_sendmsg()
+ *
+ * @return Number of messages sent, or -1 with errno set if the first
+ *         message could not be sent.
+ */
+__syscall int zsock_sendmmsg(int sock, struct mmsghdr *msgvec,
+			     unsigned int vlen, int flags);
+
 /**
  * @brief Receive data from an arbitrary network address
  *
@@ -419,6 +448,49 @@ __syscall ssize_t zsock_recvfrom(int sock, void *buf, size_t max_len,
 				 int flags, struct sockaddr *src_addr,
 				 socklen_t *addrlen);
 
+/**
+ * @brief Receive a message from an arbitrary network address
+ *
+ * @details
+ * @rst
+ * See `POSIX.1-2017 article
+ * <http://pubs.opengroup.org/onlinepubs/9699919799/functions/recvmsg.html>`__
+ * for normative description.
+ * This function is also exposed as ``recvmsg()``
+ * if :kconfig:option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ *
+ * The data is scattered over the buffers of msg_iov. For datagram
+ * sockets, the ancillary data enabled with the IP_PKTINFO,
+ * IPV6_RECVPKTINFO and SO_TIMESTAMPING socket options is returned in
+ * msg_control.
+ */
+__syscall ssize_t zsock_recvmsg(int sock, struct msghdr *msg, int flags);
+
+/**
+ * @brief Receive multiple messages from a socket
+ *
+ * @details
+ * Receives up to @a vlen messages into @a msgvec, as zsock_recvmsg()
+ * would, but locks the socket once for the whole batch. The number of
+ * bytes received for each message is stored in its msg_len field. With
+ * ZSOCK_MSG_WAITFORONE, only the first message is waited for, and the
+ * following ones are received if already queued.
+ *
+ * This function is also exposed as ``recvmmsg()``
+ * if :kconfig:option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ *
+ * @param sock Socket
+ * @param msgvec Messages to receive
+ * @param vlen Number of messages in @a msgvec
+ * @param flags Flags, as for zsock_recvmsg(), and ZSOCK_MSG_WAITFORONE
+ *
+ * @return Number of messages received, or -1 with errno set if no
+ *         message could be received.
+ */
+__syscall int zsock_recvmmsg(int sock, struct mmsghdr *msgvec,
+			     unsigned int vlen, int flags);
+
 /**
  * @brief Receive data from a connected peer
  *
@@ -437,6 +509,45 @@ static inline ssize_t zsock_recv(int sock, void *buf, size_t max_len,
 	return zsock_recvfrom(sock, buf, max_len, flags, NULL, NULL);
 }
 
+/**
+ * @brief Receive data without copying it
+ *
+ * @details
+ * Takes the next received datagram, or the next received segment of a
+ * stream, off the socket and loans its network buffers to the caller.
+ * @a iov is filled with the data fragments, which must only be read, and
+ * stay valid until the loan is given back with zsock_recv_loan_release().
+ * On a stream socket, the receive window only opens again when the loan
+ * is released.
+ *
+ * This function is only available from supervisor threads, on native
+ * TCP and UDP sockets, if :kconfig:option:`CONFIG_NET_SOCKETS_RECV_LOAN`
+ * is enabled.
+ *
+ * @param sock Socket
+ * @param iov Array filled with the data fragments
+ * @param iovcnt Number of entries in @a iov on input, number of entries
+ *        used on output. If @a iov is too small, this is the number of
+ *        entries needed and the data stays queued.
+ * @param loan Loan to release, NULL at end of stream
+ * @param flags ZSOCK_MSG_DONTWAIT, or 0
+ *
+ * @return Number of bytes loaned, 0 at end of stream, or -1 with errno
+ *         set, EMSGSIZE if @a iov is too small.
+ */
+ssize_t zsock_recv_loan(int sock, struct iovec *iov, size_t *iovcnt,
+			void **loan, int flags);
+
+/**
+ * @brief Give back the buffers loaned by zsock_recv_loan()
+ *
+ * On a stream socket, this reopens the receive window by the size of the
+ * loaned data. The loan may be given back after the socket was closed.
+ *
+ * @param loan Loan returned by zsock_recv_loan()
+ */
+void zsock_recv_loan_release(void *loan);
+
 /**
  * @brief Control blocking/non-blocking mode of a socket
  *
@@ -777,6 +888,13 @@ static inline ssize_t sendmsg(int sock, const struct msghdr *message,
 	return zsock_sendmsg(sock, message, flags);
 }
 
+/** POSIX wrapper for @ref zsock_sendmmsg */
+static inline int sendmmsg(int sock, struct mmsghdr *msgvec,
+			   unsigned int vlen, int flags)
+{
+	return zsock_sendmmsg(sock, msgvec, vlen, flags);
+}
+
 /** POSIX wrapper for @ref zsock_recvfrom */
 static inline ssize_t recvfrom(int sock, void *buf, size_t max_len, int flags,
 			       struct sockaddr *src_addr, socklen_t *addrlen)
@@ -784,6 +902,27 @@ static inline ssize_t recvfrom(int sock, void *buf, size_t max_len, int flags,
 	return zsock_recvfrom(sock, buf, max_len, flags, src_addr, addrlen);
 }
 
+/** POSIX wrapper for @ref zsock_recvmsg */
+static inline ssize_t recvmsg(int sock, struct msghdr *msg, int flags)
+{
+	return zsock_recvmsg(sock, msg, flags);
+}
+
+struct timespec;
+
+/**
+ * POSIX wrapper for @ref zsock_recvmmsg. @a timeout is ignored, for
+ * compatibility, SO_RCVTIMEO applies to every message instead.
+ */
+static inline int recvmmsg(int sock, struct mmsghdr *msgvec,
+			   unsigned int vlen, int flags,
+			   struct timespec *timeout)
+{
+	ARG_UNUSED(timeout);
+
+	return zsock_recvmmsg(sock, msgvec, vlen, flags);
+}
+
 /** POSIX wrapper for @ref zsock_poll */
 static inline int poll(struct zsock_pollfd *fds, int nfds, int timeout)
 {
@@ -887,6 +1026,10 @@ static inline char *inet_ntop(sa_family_t family, const void *src, char *dst,
 #define MSG_DONTWAIT ZSOCK_MSG_DONTWAIT
 /** POSIX wrapper for @ref ZSOCK_MSG_WAITALL */
 #define MSG_WAITALL ZSOCK_MSG_WAITALL
+/** POSIX wrapper for @ref ZSOCK_MSG_CTRUNC */
+#define MSG_CTRUNC ZSOCK_MSG_CTRUNC
+/** POSIX wrapper for @ref ZSOCK_MSG_WAITFORONE */
+#define MSG_WAITFORONE ZSOCK_MSG_WAITFORONE
 
 /** POSIX wrapper for @ref ZSOCK_SHUT_RD */
 #define SHUT_RD ZSOCK_SHUT_RD
@@ -975,8 +1118,14 @@ struct ifreq {
 /** sockopt: Socket accepts incoming connections (ignored, for compatibility) */
 #define SO_ACCEPTCONN 30
 
-/** sockopt: Timestamp TX packets */
+/**
+ * sockopt: Timestamp packets, a combination of the SOF_TIMESTAMPING_*
+ * flags. The timestamp of a received packet is returned by recvmsg() as
+ * a SCM_TIMESTAMPING control message holding a struct net_ptp_time.
+ */
 #define SO_TIMESTAMPING 37
+/** Control message type of a packet timestamp */
+#define SCM_TIMESTAMPING SO_TIMESTAMPING
 /** sockopt: Protocol used with the socket */
 #define SO_PROTOCOL 38
 
@@ -988,15 +1137,39 @@ struct ifreq {
 /* Socket options for IPPROTO_TCP level */
 /** sockopt: Disable TCP buffering (ignored, for compatibility) */
 #define TCP_NODELAY 1
+/** sockopt: Congestion control algorithm, by name, e.g. "cubic" */
+#define TCP_CONGESTION 13
+
+/* SO_TIMESTAMPING flags, compatible with Linux */
+/** Report the timestamp the network driver gave a received packet */
+#define SOF_TIMESTAMPING_RX_HARDWARE BIT(2)
+/** Timestamp received packets when they are queued to the socket, with
+ *  the system uptime. Used when the driver gave no timestamp.
+ */
+#define SOF_TIMESTAMPING_RX_SOFTWARE BIT(3)
 
 /* Socket options for IPPROTO_IP level */
 /** sockopt: Set or receive the Type-Of-Service value for an outgoing packet. */
 #define IP_TOS 1
 
+/**
+ * sockopt: Return a struct in_pktinfo IP_PKTINFO control message with
+ * the destination address and interface of every received packet.
+ */
+#define IP_PKTINFO 8
+
 /* Socket options for IPPROTO_IPV6 level */
 /** sockopt: Don't support IPv4 access (ignored, for compatibility) */
 #define IPV6_V6ONLY 26
 
+/**
+ * sockopt: Return a struct in6_pktinfo IPV6_PKTINFO control message with
+ * the destination address and interface of every received packet.
+ */
+#define IPV6_RECVPKTINFO 49
+/** Control message type of the IPv6 packet information */
+#define IPV6_PKTINFO 50
+
 /** sockopt: Set or receive the traffic class value for an outgoing packet. */
 #define IPV6_TCLASS 67
 
@@ -1155,6 +1155,36 @@ uint32_t arch_timing_freq_get_mhz(void);
 
 #endif /* CONFIG_TIMING_FUNCTIONS */
 
+#ifdef CONFIG_ARCH_HAS_PERF_SAMPLE
+
+/**
+ * @defgroup arch-perf Architecture-specific profiling APIs
+ * @ingroup arch-interface
+ * @{
+ */
+
+/**
+ * @brief Get the program counter of the interrupted thread
+ *
+ * Called by the sampling profiler from an interrupt handler. If the
+ * interrupt being handled preempted a thread, as opposed to another
+ * interrupt, the program counter and return address the thread will
+ * resume with are stored.
+ *
+ * @param pc Program counter of the interrupted thread
+ * @param lr Return address of the interrupted thread, 0 if not known.
+ *           It is only meaningful if the thread was interrupted in a
+ *           leaf function.
+ *
+ * @retval true A thread was interrupted, @a pc and @a lr are set
+ * @retval false Another interrupt was interrupted
+ */
+bool arch_perf_sample_get(uintptr_t *pc, uintptr_t *lr);
+
+/** @} */
+
+#endif /* CONFIG_ARCH_HAS_PERF_SAMPLE */
+
 #ifdef CONFIG_PCIE_MSI_MULTI_VECTOR
 
 struct msi_vector;
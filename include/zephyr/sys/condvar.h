@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ *
+ * @brief public sys_condvar APIs.
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_CONDVAR_H_
+#define ZEPHYR_INCLUDE_SYS_CONDVAR_H_
+
+/*
+ * sys_condvar exists in user memory working as condition variable for
+ * user mode threads when user mode is enabled, paired with a sys_mutex.
+ * Signaling a condition variable nobody waits on takes atomic ops only.
+ * When user mode isn't enabled, sys_condvar behaves like k_condvar.
+ *
+ * With user mode, the k_futex inside must be a kernel object known at build
+ * time: define condition variables with SYS_CONDVAR_DEFINE(), not on the
+ * stack or heap, or waiting on them fails with -EINVAL.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/mutex.h>
+#include <zephyr/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * sys_condvar structure
+ */
+struct sys_condvar {
+#ifdef CONFIG_USERSPACE
+	/* Sequence number, bumped on every signal */
+	struct k_futex futex;
+	atomic_t waiters;
+#else
+	struct k_condvar kernel_condvar;
+#endif
+};
+
+/**
+ * @defgroup user_condvar_apis User mode condition variable APIs
+ * @ingroup kernel_apis
+ * @{
+ */
+
+/**
+ * @brief Statically define and initialize a sys_condvar
+ *
+ * The condition variable can be accessed outside the module where it is
+ * defined using:
+ *
+ * @code extern struct sys_condvar <name>; @endcode
+ *
+ * Route this to memory domains using K_APP_DMEM().
+ *
+ * @param _name Name of the condition variable.
+ */
+#ifdef CONFIG_USERSPACE
+#define SYS_CONDVAR_DEFINE(_name) \
+	struct sys_condvar _name = { \
+		.futex = { 0 }, \
+		.waiters = ATOMIC_INIT(0) \
+	}
+#else
+#define SYS_CONDVAR_DEFINE(_name) \
+	STRUCT_SECTION_ITERABLE_ALTERNATE(k_condvar, sys_condvar, _name) = { \
+		.kernel_condvar = Z_CONDVAR_INITIALIZER(_name.kernel_condvar) \
+	}
+#endif
+
+/**
+ * @brief Initialize a condition variable.
+ *
+ * @param condvar Address of the condition variable.
+ *
+ * @retval 0 Condition variable initialized.
+ */
+int sys_condvar_init(struct sys_condvar *condvar);
+
+/**
+ * @brief Wake up one thread waiting on a condition variable.
+ *
+ * No system call is made if no thread waits on @a condvar.
+ *
+ * @param condvar Address of the condition variable.
+ *
+ * @retval 0 Success.
+ * @retval -EINVAL Parameter address not recognized.
+ * @retval -EACCES Caller does not have enough access.
+ */
+int sys_condvar_signal(struct sys_condvar *condvar);
+
+/**
+ * @brief Wake up all threads waiting on a condition variable.
+ *
+ * No system call is made if no thread waits on @a condvar.
+ *
+ * @param condvar Address of the condition variable.
+ *
+ * @return Number of threads woken up, or negative error code
+ * @retval -EINVAL Parameter address not recognized.
+ * @retval -EACCES Caller does not have enough access.
+ */
+int sys_condvar_broadcast(struct sys_condvar *condvar);
+
+/**
+ * @brief Wait on a condition variable.
+ *
+ * Releases @a mutex, which the calling thread must have locked exactly
+ * once, waits for @a condvar to be signaled, and locks @a mutex again
+ * before returning, whatever the outcome of the wait.
+ *
+ * Like other condition variables, a sys_condvar may return without
+ * having been signaled, so the condition must be checked again after
+ * this returns.
+ *
+ * @param condvar Address of the condition variable.
+ * @param mutex Address of the mutex protecting the condition.
+ * @param timeout Waiting period for the condition variable,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Success.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EINVAL Parameter address not recognized.
+ * @retval -EACCES Caller does not have enough access.
+ * @retval -EPERM Caller does not own the mutex.
+ */
+int sys_condvar_wait(struct sys_condvar *condvar, struct sys_mutex *mutex,
+		     k_timeout_t timeout);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_CONDVAR_H_ */
@@ -111,6 +111,9 @@ struct k_mem_paging_stats_t {
 		/** Number of page faults while in ISR */
 		unsigned long			in_isr;
 #endif
+
+		/** Number of pages read ahead of page faults */
+		unsigned long			prefetched;
 	} pagefaults;
 
 	struct {
@@ -119,6 +122,9 @@ struct k_mem_paging_stats_t {
 
 		/** Number of dirty pages selected for eviction */
 		unsigned long			dirty;
+
+		/** Number of dirty pages written back ahead of eviction */
+		unsigned long			cleaned;
 	} eviction;
 #endif /* CONFIG_DEMAND_PAGING_STATS */
 };
@@ -607,6 +613,33 @@ void k_mem_paging_backing_store_location_free(uintptr_t location);
  */
 void k_mem_paging_backing_store_page_out(uintptr_t location);
 
+/**
+ * Copy a batch of loaded data pages to the backing store
+ *
+ * This is used by the page cleaner (CONFIG_DEMAND_PAGING_PAGE_CLEANER) to
+ * write dirty data pages back ahead of their eviction. Each data page is
+ * still mapped at pfs[i]->addr, and is to be copied to locations[i], which
+ * was obtained with k_mem_paging_backing_store_location_get(). The backing
+ * store may start all the transfers at once and complete them in any order,
+ * but must not return before all of them are complete. The kernel then sets
+ * the Z_PAGE_FRAME_BACKED bit of the page frames.
+ *
+ * The default implementation copies the data pages one at a time with
+ * k_mem_paging_backing_store_page_out(), mapping each of them to
+ * Z_SCRATCH_PAGE in turn.
+ *
+ * Calls to this, k_mem_paging_backing_store_page_out() and
+ * k_mem_paging_backing_store_page_in() will always be serialized, but
+ * interrupts may be enabled.
+ *
+ * @param pfs Page frames holding the data pages
+ * @param locations Location tokens for the data pages
+ * @param count Number of data pages
+ */
+void k_mem_paging_backing_store_page_out_batch(struct z_page_frame *const *pfs,
+					       const uintptr_t *locations,
+					       size_t count);
+
 /**
  * Copy a data page from the provided location to Z_SCRATCH_PAGE.
  *
@@ -11,9 +11,10 @@
  * sys_mutex behaves almost exactly like k_mutex, with the added advantage
  * that a sys_mutex instance can reside in user memory.
  *
- * Further enhancements will support locking/unlocking uncontended sys_mutexes
- * with simple atomic ops instead of syscalls, similar to Linux's
- * FUTEX_LOCK_PI and FUTEX_UNLOCK_PI
+ * With CONFIG_SYS_MUTEX_FUTEX, sys_mutex is built on top of a k_futex
+ * instead of a k_mutex, and uncontended sys_mutexes are locked/unlocked
+ * with simple atomic ops instead of syscalls. Such mutexes do not do
+ * priority inheritance.
  */
 
 #ifdef __cplusplus
@@ -25,13 +26,21 @@ extern "C" {
 #include <zephyr/types.h>
 #include <zephyr/sys_clock.h>
 
+#ifdef CONFIG_SYS_MUTEX_FUTEX
+#include <zephyr/kernel.h>
+
 struct sys_mutex {
-	/* Currently unused, but will be used to store state for fast mutexes
-	 * that can be locked/unlocked with atomic ops if there is no
-	 * contention
-	 */
+	/* 0: unlocked, 1: locked, 2: locked with possible waiters */
+	struct k_futex futex;
+	struct k_thread *owner;
+	uint32_t lock_count;
+};
+#else
+struct sys_mutex {
+	/* Unused, the kernel looks up the k_mutex backing this object */
 	atomic_t val;
 };
+#endif
 
 /**
  * @defgroup user_mutex_apis User mode mutex APIs
@@ -67,13 +76,23 @@ struct sys_mutex {
  */
 static inline void sys_mutex_init(struct sys_mutex *mutex)
 {
+#ifdef CONFIG_SYS_MUTEX_FUTEX
+	atomic_set(&mutex->futex.val, 0);
+	mutex->owner = NULL;
+	mutex->lock_count = 0U;
+#else
 	ARG_UNUSED(mutex);
 
 	/* Nothing to do, kernel-side data structures are initialized at
 	 * boot
 	 */
+#endif
 }
 
+int z_sys_mutex_futex_lock(struct sys_mutex *mutex, k_timeout_t timeout);
+
+int z_sys_mutex_futex_unlock(struct sys_mutex *mutex);
+
 __syscall int z_sys_mutex_kernel_lock(struct sys_mutex *mutex,
 				      k_timeout_t timeout);
 
@@ -101,8 +120,11 @@ __syscall int z_sys_mutex_kernel_unlock(struct sys_mutex *mutex);
  */
 static inline int sys_mutex_lock(struct sys_mutex *mutex, k_timeout_t timeout)
 {
-	/* For now, make the syscall unconditionally */
+#ifdef CONFIG_SYS_MUTEX_FUTEX
+	return z_sys_mutex_futex_lock(mutex, timeout);
+#else
 	return z_sys_mutex_kernel_lock(mutex, timeout);
+#endif
 }
 
 /**
@@ -124,8 +146,11 @@ static inline int sys_mutex_lock(struct sys_mutex *mutex, k_timeout_t timeout)
  */
 static inline int sys_mutex_unlock(struct sys_mutex *mutex)
 {
-	/* For now, make the syscall unconditionally */
+#ifdef CONFIG_SYS_MUTEX_FUTEX
+	return z_sys_mutex_futex_unlock(mutex);
+#else
 	return z_sys_mutex_kernel_unlock(mutex);
+#endif
 }
 
 #include <syscalls/mutex.h>
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ *
+ * @brief public sys_rwlock APIs.
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_RWLOCK_H_
+#define ZEPHYR_INCLUDE_SYS_RWLOCK_H_
+
+/*
+ * sys_rwlock exists in user memory working as reader-writer lock for
+ * user mode threads when user mode is enabled. Uncontended locking and
+ * unlocking takes atomic ops only. When user mode isn't enabled,
+ * sys_rwlock behaves like k_rwlock.
+ *
+ * With user mode, the k_futex inside must be a kernel object known at build
+ * time: define locks with SYS_RWLOCK_DEFINE(), not on the stack or heap, or
+ * contended locking fails with -EINVAL.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * sys_rwlock structure
+ */
+struct sys_rwlock {
+#ifdef CONFIG_USERSPACE
+	/* Reader count, writer and waiters flags */
+	struct k_futex futex;
+#else
+	struct k_rwlock kernel_rwlock;
+#endif
+};
+
+/**
+ * @defgroup user_rwlock_apis User mode reader-writer lock APIs
+ * @ingroup kernel_apis
+ * @{
+ */
+
+/**
+ * @brief Statically define and initialize a sys_rwlock
+ *
+ * The lock can be accessed outside the module where it is defined using:
+ *
+ * @code extern struct sys_rwlock <name>; @endcode
+ *
+ * Route this to memory domains using K_APP_DMEM().
+ *
+ * @param _name Name of the reader-writer lock.
+ */
+#ifdef CONFIG_USERSPACE
+#define SYS_RWLOCK_DEFINE(_name) \
+	struct sys_rwlock _name = { \
+		.futex = { 0 } \
+	}
+#else
+#define SYS_RWLOCK_DEFINE(_name) \
+	STRUCT_SECTION_ITERABLE_ALTERNATE(k_rwlock, sys_rwlock, _name) = { \
+		.kernel_rwlock = Z_RWLOCK_INITIALIZER(_name.kernel_rwlock) \
+	}
+#endif
+
+/**
+ * @brief Initialize a reader-writer lock.
+ *
+ * @param rwlock Address of the reader-writer lock.
+ *
+ * @retval 0 Reader-writer lock initialized.
+ */
+int sys_rwlock_init(struct sys_rwlock *rwlock);
+
+/**
+ * @brief Lock a reader-writer lock for reading.
+ *
+ * Any number of threads may hold the lock for reading at the same time.
+ * Once a thread waits for the lock, new readers wait as well, so a
+ * steady stream of readers cannot starve writers, and read locks are not
+ * recursive.
+ *
+ * @param rwlock Address of the reader-writer lock.
+ * @param timeout Waiting period to lock the lock,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Lock held for reading.
+ * @retval -EBUSY Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EINVAL Parameter address not recognized.
+ * @retval -EACCES Caller does not have enough access.
+ */
+int sys_rwlock_read_lock(struct sys_rwlock *rwlock, k_timeout_t timeout);
+
+/**
+ * @brief Release a reader-writer lock held for reading.
+ *
+ * @param rwlock Address of the reader-writer lock.
+ *
+ * @retval 0 Lock released.
+ * @retval -EINVAL The lock is not held for reading.
+ */
+int sys_rwlock_read_unlock(struct sys_rwlock *rwlock);
+
+/**
+ * @brief Lock a reader-writer lock for writing.
+ *
+ * Write locks are not recursive.
+ *
+ * @param rwlock Address of the reader-writer lock.
+ * @param timeout Waiting period to lock the lock,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Lock held for writing.
+ * @retval -EBUSY Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EINVAL Parameter address not recognized.
+ * @retval -EACCES Caller does not have enough access.
+ */
+int sys_rwlock_write_lock(struct sys_rwlock *rwlock, k_timeout_t timeout);
+
+/**
+ * @brief Release a reader-writer lock held for writing.
+ *
+ * When user mode is enabled, the lock does not track which thread holds
+ * it for writing, so this only checks that some thread does.
+ *
+ * @param rwlock Address of the reader-writer lock.
+ *
+ * @retval 0 Lock released.
+ * @retval -EPERM The lock is not held for writing.
+ */
+int sys_rwlock_write_unlock(struct sys_rwlock *rwlock);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_RWLOCK_H_ */
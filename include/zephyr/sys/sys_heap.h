@@ -150,6 +150,44 @@ void *sys_heap_aligned_alloc(struct sys_heap *heap, size_t align, size_t bytes);
  */
 void sys_heap_free(struct sys_heap *heap, void *mem);
 
+#ifdef CONFIG_SYS_HEAP_CACHE
+
+/** @brief Allocate from the current CPU's heap cache only
+ *
+ * Pops a block from the per-CPU magazine matching @a bytes, without
+ * touching the heap proper.  Returns NULL on a cache miss, or if the
+ * request is not cacheable (too large, or aligned beyond the natural
+ * block alignment); the caller then falls back to
+ * sys_heap_aligned_alloc() under its usual lock.
+ *
+ * @note Unlike the rest of the API this function may run concurrently
+ * with any other sys_heap call on the same heap, provided the heap
+ * itself is protected by a lock taken with interrupts masked (i.e. a
+ * k_spinlock, as k_heap does).  Other callers should not use it.
+ *
+ * @param heap Heap from which to allocate
+ * @param align Alignment in bytes, must be a power of two or zero
+ * @param bytes Number of bytes requested
+ * @return Pointer to memory the caller can now use, or NULL
+ */
+void *sys_heap_cache_alloc(struct sys_heap *heap, size_t align, size_t bytes);
+
+/** @brief Free into the current CPU's heap cache only
+ *
+ * Counterpart of sys_heap_cache_alloc(): parks the block in the
+ * per-CPU magazine for its size class if there is room.  Returns
+ * false if the block was not taken, in which case it must be freed
+ * with sys_heap_free() under the heap lock.  Same concurrency rules
+ * as sys_heap_cache_alloc().
+ *
+ * @param heap Heap to which to return the memory
+ * @param mem A pointer previously returned from this heap
+ * @return true if the block was cached (or @a mem is NULL)
+ */
+bool sys_heap_cache_free(struct sys_heap *heap, void *mem);
+
+#endif /* CONFIG_SYS_HEAP_CACHE */
+
 /** @brief Expand the size of an existing allocation
  *
  * Returns a pointer to a new memory region with the same contents,
@@ -104,6 +104,22 @@ extern void z_dump_object_error(int retval, const void *obj,
  */
 extern struct z_object *z_object_find(const void *obj);
 
+#ifdef CONFIG_USERSPACE_OBJ_CACHE
+/**
+ * Lookup a kernel object on behalf of the current thread
+ *
+ * Same as z_object_find(), but results are cached per thread. Only for
+ * use from thread context, typically in system call handlers.
+ *
+ * @param obj Address of the kernel object to get metadata
+ * @return Kernel object's metadata, or NULL if the parameter wasn't the
+ * memory address of a kernel object
+ */
+extern struct z_object *z_object_find_cached(const void *obj);
+#else
+#define z_object_find_cached(obj) z_object_find(obj)
+#endif
+
 typedef void (*_wordlist_cb_func_t)(struct z_object *ko, void *context);
 
 /**
@@ -447,7 +463,7 @@ static inline int z_obj_validation_check(struct z_object *ko,
 
 #define Z_SYSCALL_IS_OBJ(ptr, type, init) \
 	Z_SYSCALL_VERIFY_MSG(z_obj_validation_check(			\
-				     z_object_find((const void *)ptr),	\
+				     z_object_find_cached((const void *)ptr), \
 				     (const void *)ptr,			\
 				     type, init) == 0, "access denied")
 
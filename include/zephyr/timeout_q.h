@@ -25,6 +25,9 @@ extern "C" {
 static inline void z_init_timeout(struct _timeout *to)
 {
 	sys_dnode_init(&to->node);
+#ifdef CONFIG_TIMEOUT_PER_CPU
+	to->cpu = 0U;
+#endif
 }
 
 void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
@@ -32,6 +35,11 @@ void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 
 int z_abort_timeout(struct _timeout *to);
 
+#ifdef CONFIG_TIMEOUT_PER_CPU
+/* Moves a timeout, armed or not, to the timeout queue of another CPU */
+void z_timeout_migrate(struct _timeout *to, int cpu);
+#endif
+
 static inline bool z_is_inactive_timeout(const struct _timeout *to)
 {
 	return !sys_dnode_is_linked(&to->node);
@@ -523,6 +523,26 @@ enum arch_page_location arch_page_location_get(void *addr, uintptr_t *location);
 uintptr_t arch_page_info_get(void *addr, uintptr_t *location,
 			     bool clear_accessed);
 
+/**
+ * Clear the dirty state of a loaded data page
+ *
+ * Reset ARCH_DATA_PAGE_DIRTY for the provided virtual address in all active
+ * page tables in the system, so that any later write to the data page sets
+ * it again. This is used to write data pages back to the backing store
+ * without evicting them, and is only needed with
+ * CONFIG_DEMAND_PAGING_PAGE_CLEANER.
+ *
+ * This function is called with interrupts locked.
+ *
+ * Clearing dirty state for data pages that are not ARCH_DATA_PAGE_LOADED
+ * is undefined behavior.
+ *
+ * This API is part of infrastructure still under development and may change.
+ *
+ * @param addr Virtual address of the data page
+ */
+void arch_page_dirty_clear(void *addr);
+
 /** @} */
 
 /**
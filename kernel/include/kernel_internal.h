@@ -186,6 +186,13 @@ void z_mem_domain_exit_thread(struct k_thread *thread);
  * not recommended.
  */
 extern struct k_spinlock z_mem_domain_lock;
+
+#ifdef CONFIG_USERSPACE_TIME_PAGE
+/* Holds the uptime published for user mode, read-only for user threads
+ * and part of every memory domain.
+ */
+extern struct k_mem_partition z_time_partition;
+#endif
 #endif /* CONFIG_USERSPACE */
 
 #ifdef CONFIG_GDBSTUB
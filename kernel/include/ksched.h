@@ -12,10 +12,16 @@
 #include <zephyr/timeout_q.h>
 #include <zephyr/tracing/tracing.h>
 #include <stdbool.h>
+#include <limits.h>
 
 BUILD_ASSERT(K_LOWEST_APPLICATION_THREAD_PRIO
 	     >= K_HIGHEST_APPLICATION_THREAD_PRIO);
 
+#ifdef CONFIG_SCHED_CPU_RUNQ_STEAL
+/* Value of a thread's base.cpu until it first runs */
+#define Z_THREAD_CPU_NONE UINT8_MAX
+#endif
+
 #ifdef CONFIG_MULTITHREADING
 #define Z_VALID_PRIO(prio, entry_point)				     \
 	(((prio) == K_IDLE_PRIO && z_is_idle_thread_entry(entry_point)) || \
@@ -315,6 +321,26 @@ static ALWAYS_INLINE bool z_is_thread_timeout_expired(struct k_thread *thread)
  */
 bool z_sched_wake(_wait_q_t *wait_q, int swap_retval, void *swap_data);
 
+/**
+ * Wake up several threads pending on the provided wait queue
+ *
+ * Like calling z_sched_wake() up to @a max times, but all threads are
+ * moved to the run queue inside a single scheduler critical section
+ * and the scheduler makes one preemption (and IPI) decision for the
+ * whole batch instead of one per thread.  Threads are woken in the
+ * same order z_sched_wake() would pick them.
+ *
+ * The same locking rules as for z_sched_wake() apply.
+ *
+ * @param wait_q Wait queue to wake threads from
+ * @param max Maximum number of threads to wake, UINT_MAX for all
+ * @param swap_retval Swap return value for every woken thread
+ * @param swap_data Data return value to supplement swap_retval. May be NULL.
+ * @return Number of threads woken up
+ */
+unsigned int z_sched_wake_many(_wait_q_t *wait_q, unsigned int max,
+			       int swap_retval, void *swap_data);
+
 /**
  * Wakes the specified thread.
  *
@@ -330,8 +356,8 @@ void z_sched_wake_thread(struct k_thread *thread, bool is_timeout);
 /**
  * Wake up all threads pending on the provided wait queue
  *
- * Convenience function to invoke z_sched_wake() on all threads in the queue
- * until there are no more to wake up.
+ * Convenience function to invoke z_sched_wake_many() on all threads in the
+ * queue, so they are all made ready with a single scheduling decision.
  *
  * @param wait_q Wait queue to wake up the highest prio thread
  * @param swap_retval Swap return value for woken thread
@@ -342,14 +368,8 @@ void z_sched_wake_thread(struct k_thread *thread, bool is_timeout);
 static inline bool z_sched_wake_all(_wait_q_t *wait_q, int swap_retval,
 				    void *swap_data)
 {
-	bool woken = false;
-
-	while (z_sched_wake(wait_q, swap_retval, swap_data)) {
-		woken = true;
-	}
-
 	/* True if we woke at least one thread up */
-	return woken;
+	return z_sched_wake_many(wait_q, UINT_MAX, swap_retval, swap_data) != 0U;
 }
 
 /**
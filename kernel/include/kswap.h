@@ -226,6 +226,9 @@ static inline void z_dummy_thread_init(struct k_thread *dummy_thread)
 #ifdef CONFIG_USERSPACE
 	dummy_thread->mem_domain_info.mem_domain = &k_mem_domain_default;
 #endif
+#ifdef CONFIG_USERSPACE_OBJ_CACHE
+	dummy_thread->obj_cache.gen = 0U;
+#endif
 #if (CONFIG_HEAP_MEM_POOL_SIZE > 0)
 	k_thread_system_pool_assign(dummy_thread);
 #else
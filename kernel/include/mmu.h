@@ -90,6 +90,12 @@
  */
 #define Z_PAGE_FRAME_BACKED		BIT(4)
 
+/**
+ * This page frame is kept in memory for a short while by the kernel,
+ * independently of k_mem_pin()
+ */
+#define Z_PAGE_FRAME_HELD		BIT(5)
+
 /**
  * Data structure for physical page frames
  *
@@ -141,10 +147,16 @@ static inline bool z_page_frame_is_backed(struct z_page_frame *pf)
 	return (pf->flags & Z_PAGE_FRAME_BACKED) != 0U;
 }
 
+static inline bool z_page_frame_is_held(struct z_page_frame *pf)
+{
+	return (pf->flags & Z_PAGE_FRAME_HELD) != 0U;
+}
+
 static inline bool z_page_frame_is_evictable(struct z_page_frame *pf)
 {
 	return (!z_page_frame_is_reserved(pf) && z_page_frame_is_mapped(pf) &&
-		!z_page_frame_is_pinned(pf) && !z_page_frame_is_busy(pf));
+		!z_page_frame_is_pinned(pf) && !z_page_frame_is_busy(pf) &&
+		!z_page_frame_is_held(pf));
 }
 
 /* If true, page is not being used for anything, is not reserved, is a member
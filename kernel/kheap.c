@@ -14,6 +14,9 @@ void k_heap_init(struct k_heap *h, void *mem, size_t bytes)
 {
 	z_waitq_init(&h->wait_q);
 	sys_heap_init(&h->heap, mem, bytes);
+#ifdef CONFIG_SYS_HEAP_CACHE
+	atomic_set(&h->waiters, 0);
+#endif
 
 	SYS_PORT_TRACING_OBJ_INIT(k_heap, h);
 }
@@ -68,6 +71,18 @@ void *k_heap_aligned_alloc(struct k_heap *h, size_t align, size_t bytes,
 
 	end = K_TIMEOUT_EQ(timeout, K_FOREVER) ? INT64_MAX : end;
 
+#ifdef CONFIG_SYS_HEAP_CACHE
+	/* Fast path: this CPU's magazine, behind its own spinlock */
+	ret = sys_heap_cache_alloc(&h->heap, align, bytes);
+	if (ret != NULL) {
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_heap, aligned_alloc, h, timeout);
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_heap, aligned_alloc, h, timeout, ret);
+		return ret;
+	}
+
+	bool waiting = false;
+#endif
+
 	k_spinlock_key_t key = k_spin_lock(&h->lock);
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_heap, aligned_alloc, h, timeout);
@@ -85,6 +100,20 @@ void *k_heap_aligned_alloc(struct k_heap *h, size_t align, size_t bytes,
 			break;
 		}
 
+#ifdef CONFIG_SYS_HEAP_CACHE
+		/* k_heap_free() may put memory into a magazine without
+		 * taking our lock.  Announce ourselves, then retry (the
+		 * failing allocation drains the magazines) so that any
+		 * block cached after that drain is guaranteed to see us
+		 * and take the lock to wake us up.
+		 */
+		if (!waiting) {
+			waiting = true;
+			atomic_inc(&h->waiters);
+			continue;
+		}
+#endif
+
 		if (!blocked_alloc) {
 			blocked_alloc = true;
 
@@ -100,6 +129,12 @@ void *k_heap_aligned_alloc(struct k_heap *h, size_t align, size_t bytes,
 		key = k_spin_lock(&h->lock);
 	}
 
+#ifdef CONFIG_SYS_HEAP_CACHE
+	if (waiting) {
+		atomic_dec(&h->waiters);
+	}
+#endif
+
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_heap, aligned_alloc, h, timeout, ret);
 
 	k_spin_unlock(&h->lock, key);
@@ -119,9 +154,24 @@ void *k_heap_alloc(struct k_heap *h, size_t bytes, k_timeout_t timeout)
 
 void k_heap_free(struct k_heap *h, void *mem)
 {
-	k_spinlock_key_t key = k_spin_lock(&h->lock);
+	k_spinlock_key_t key;
+
+#ifdef CONFIG_SYS_HEAP_CACHE
+	if (sys_heap_cache_free(&h->heap, mem)) {
+		if (atomic_get(&h->waiters) == 0) {
+			SYS_PORT_TRACING_OBJ_FUNC(k_heap, free, h);
+			return;
+		}
+		key = k_spin_lock(&h->lock);
+	} else {
+		key = k_spin_lock(&h->lock);
+		sys_heap_free(&h->heap, mem);
+	}
+#else
+	key = k_spin_lock(&h->lock);
 
 	sys_heap_free(&h->heap, mem);
+#endif
 
 	SYS_PORT_TRACING_OBJ_FUNC(k_heap, free, h);
 	if (IS_ENABLED(CONFIG_MULTITHREADING) && z_unpend_all(&h->wait_q) != 0) {
@@ -152,6 +152,13 @@ int k_mem_domain_init(struct k_mem_domain *domain, uint8_t num_parts,
 unlock_out:
 	k_spin_unlock(&z_mem_domain_lock, key);
 
+#ifdef CONFIG_USERSPACE_TIME_PAGE
+	/* User threads of any domain read the uptime from there */
+	if (ret == 0) {
+		ret = k_mem_domain_add_partition(domain, &z_time_partition);
+	}
+#endif
+
 out:
 	return ret;
 }
@@ -352,6 +359,11 @@ static int init_mem_domain_module(void)
 	 */
 	__ASSERT(max_partitions <= CONFIG_MAX_DOMAIN_PARTITIONS, "");
 
+#ifdef CONFIG_USERSPACE_TIME_PAGE
+	/* Only the kernel may publish the uptime */
+	z_time_partition.attr = K_MEM_PARTITION_P_RW_U_RO;
+#endif
+
 	ret = k_mem_domain_init(&k_mem_domain_default, 0, NULL);
 	__ASSERT(ret == 0, "failed to init default mem domain");
 
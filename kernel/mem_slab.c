@@ -72,6 +72,136 @@ out:
 SYS_INIT(init_mem_slab_module, PRE_KERNEL_1,
 	 CONFIG_KERNEL_INIT_PRIORITY_OBJECTS);
 
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+
+/* With per-CPU caches, blocks come and go without the slab lock, so
+ * the usage counters are atomics.  Blocks sitting in a cache count as
+ * free.
+ */
+static void account_alloc(struct k_mem_slab *slab)
+{
+	atomic_val_t used = atomic_inc(&slab->num_used) + 1;
+
+#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
+	atomic_val_t max;
+
+	do {
+		max = atomic_get(&slab->max_used);
+		if (used <= max) {
+			break;
+		}
+	} while (!atomic_cas(&slab->max_used, max, used));
+#else
+	ARG_UNUSED(used);
+#endif
+}
+
+static void account_free(struct k_mem_slab *slab)
+{
+	(void)atomic_dec(&slab->num_used);
+}
+
+/* Pops a block from the current CPU's cache.  Only the owning CPU
+ * pushes, and it has interrupts masked here, so the only concurrent
+ * change possible is cache_reclaim() detaching the whole list: the
+ * CAS then fails on a NULL head and there is no ABA problem.
+ */
+static bool cache_pop(struct k_mem_slab *slab, void **mem)
+{
+	unsigned int key = arch_irq_lock();
+	struct z_mem_slab_cpu_cache *cache = &slab->cpu_cache[arch_curr_cpu()->id];
+	char *block;
+
+	do {
+		block = atomic_ptr_get(&cache->head);
+		if (block == NULL) {
+			cache->count = 0U;
+			break;
+		}
+	} while (!atomic_ptr_cas(&cache->head, block, *(char **)block));
+
+	if (block != NULL) {
+		cache->count--;
+		*mem = block;
+	}
+
+	arch_irq_unlock(key);
+
+	return block != NULL;
+}
+
+/* Pushes a block on the current CPU's cache if it has room.  The
+ * block is accounted free before it is published, so that the usage
+ * counters never see it allocated twice.
+ */
+static bool cache_push(struct k_mem_slab *slab, void *mem)
+{
+	unsigned int key = arch_irq_lock();
+	struct z_mem_slab_cpu_cache *cache = &slab->cpu_cache[arch_curr_cpu()->id];
+	char *head = atomic_ptr_get(&cache->head);
+	bool cached = false;
+
+	if (head == NULL) {
+		cache->count = 0U;
+	}
+
+	if (cache->count < CONFIG_MEM_SLAB_PER_CPU_CACHE_SIZE) {
+		account_free(slab);
+
+		for (;;) {
+			*(char **)mem = head;
+			if (atomic_ptr_cas(&cache->head, head, mem)) {
+				break;
+			}
+			/* Detached by cache_reclaim() meanwhile */
+			head = atomic_ptr_get(&cache->head);
+			cache->count = 0U;
+		}
+		cache->count++;
+		cached = true;
+	}
+
+	arch_irq_unlock(key);
+
+	return cached;
+}
+
+/* Moves the blocks cached by all CPUs to the shared free list.
+ * Called with the slab lock held.
+ */
+static void cache_reclaim(struct k_mem_slab *slab)
+{
+	for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		char *block = atomic_ptr_clear(&slab->cpu_cache[i].head);
+
+		while (block != NULL) {
+			char *next = *(char **)block;
+
+			*(char **)block = slab->free_list;
+			slab->free_list = block;
+			block = next;
+		}
+	}
+}
+
+#else
+
+static inline void account_alloc(struct k_mem_slab *slab)
+{
+	slab->num_used++;
+
+#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
+	slab->max_used = MAX(slab->num_used, slab->max_used);
+#endif
+}
+
+static inline void account_free(struct k_mem_slab *slab)
+{
+	slab->num_used--;
+}
+
+#endif /* CONFIG_MEM_SLAB_PER_CPU_CACHE */
+
 int k_mem_slab_init(struct k_mem_slab *slab, void *buffer,
 		    size_t block_size, uint32_t num_blocks)
 {
@@ -87,6 +217,14 @@ int k_mem_slab_init(struct k_mem_slab *slab, void *buffer,
 	slab->max_used = 0U;
 #endif
 
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+	atomic_set(&slab->waiters, 0);
+	for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		atomic_ptr_set(&slab->cpu_cache[i].head, NULL);
+		slab->cpu_cache[i].count = 0U;
+	}
+#endif
+
 	rc = create_free_list(slab);
 	if (rc < 0) {
 		goto out;
@@ -102,20 +240,45 @@ out:
 
 int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 {
-	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+	k_spinlock_key_t key;
 	int result;
 
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+	bool waiting = false;
+
+	if (cache_pop(slab, mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, alloc, slab, timeout);
+		account_alloc(slab);
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc, slab, timeout, 0);
+		return 0;
+	}
+#endif
+
+	key = k_spin_lock(&slab->lock);
+
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, alloc, slab, timeout);
 
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+	if (slab->free_list == NULL) {
+		/* Announce a possible waiter before looking into the
+		 * other CPUs' caches: a block cached after this point
+		 * will make its freeing CPU take the lock and hand it
+		 * over (see k_mem_slab_free()).
+		 */
+		if (!K_TIMEOUT_EQ(timeout, K_NO_WAIT) &&
+		    IS_ENABLED(CONFIG_MULTITHREADING)) {
+			atomic_inc(&slab->waiters);
+			waiting = true;
+		}
+		cache_reclaim(slab);
+	}
+#endif
+
 	if (slab->free_list != NULL) {
 		/* take a free block */
 		*mem = slab->free_list;
 		slab->free_list = *(char **)(slab->free_list);
-		slab->num_used++;
-
-#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
-		slab->max_used = MAX(slab->num_used, slab->max_used);
-#endif
+		account_alloc(slab);
 
 		result = 0;
 	} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT) ||
@@ -132,11 +295,21 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 			*mem = _current->base.swap_data;
 		}
 
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+		atomic_dec(&slab->waiters);
+#endif
+
 		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc, slab, timeout, result);
 
 		return result;
 	}
 
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+	if (waiting) {
+		atomic_dec(&slab->waiters);
+	}
+#endif
+
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc, slab, timeout, result);
 
 	k_spin_unlock(&slab->lock, key);
@@ -144,9 +317,58 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 	return result;
 }
 
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+/* Hands blocks to pending threads for as long as there are both.
+ * Called with the slab lock held, releases it.
+ */
+static void wake_waiters(struct k_mem_slab *slab, k_spinlock_key_t key)
+{
+	bool woken = false;
+
+	cache_reclaim(slab);
+
+	while (slab->free_list != NULL) {
+		struct k_thread *pending_thread = z_unpend_first_thread(&slab->wait_q);
+		char *block = slab->free_list;
+
+		if (pending_thread == NULL) {
+			break;
+		}
+
+		slab->free_list = *(char **)block;
+		account_alloc(slab);
+
+		z_thread_return_value_set_with_data(pending_thread, 0, block);
+		z_ready_thread(pending_thread);
+		woken = true;
+	}
+
+	if (woken) {
+		z_reschedule(&slab->lock, key);
+	} else {
+		k_spin_unlock(&slab->lock, key);
+	}
+}
+#endif
+
 void k_mem_slab_free(struct k_mem_slab *slab, void **mem)
 {
-	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+	k_spinlock_key_t key;
+
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+	if (cache_push(slab, *mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, free, slab);
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
+
+		/* Pairs with the waiter announcement in k_mem_slab_alloc() */
+		if (atomic_get(&slab->waiters) != 0) {
+			wake_waiters(slab, k_spin_lock(&slab->lock));
+		}
+		return;
+	}
+#endif
+
+	key = k_spin_lock(&slab->lock);
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, free, slab);
 	if (slab->free_list == NULL && IS_ENABLED(CONFIG_MULTITHREADING)) {
@@ -163,7 +385,7 @@ void k_mem_slab_free(struct k_mem_slab *slab, void **mem)
 	}
 	**(char ***) mem = slab->free_list;
 	slab->free_list = *(char **) mem;
-	slab->num_used--;
+	account_free(slab);
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
 
@@ -178,10 +400,10 @@ int k_mem_slab_runtime_stats_get(struct k_mem_slab *slab, struct sys_memory_stat
 
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
 
-	stats->allocated_bytes = slab->num_used * slab->block_size;
-	stats->free_bytes = (slab->num_blocks - slab->num_used) * slab->block_size;
+	stats->allocated_bytes = k_mem_slab_num_used_get(slab) * slab->block_size;
+	stats->free_bytes = k_mem_slab_num_free_get(slab) * slab->block_size;
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
-	stats->max_allocated_bytes = slab->max_used * slab->block_size;
+	stats->max_allocated_bytes = k_mem_slab_max_used_get(slab) * slab->block_size;
 #else
 	stats->max_allocated_bytes = 0;
 #endif
@@ -200,7 +422,11 @@ int k_mem_slab_runtime_stats_reset_max(struct k_mem_slab *slab)
 
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
 
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+	atomic_set(&slab->max_used, atomic_get(&slab->num_used));
+#else
 	slab->max_used = slab->num_used;
+#endif
 
 	k_spin_unlock(&slab->lock, key);
 
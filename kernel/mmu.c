@@ -657,6 +657,18 @@ void k_mem_unmap(void *addr, size_t size)
 
 		arch_mem_unmap(pos, CONFIG_MMU_PAGE_SIZE);
 
+#ifdef CONFIG_DEMAND_PAGING
+		if (z_page_frame_is_backed(pf)) {
+			uintptr_t location;
+
+			/* Drop the clean copy kept in the backing store */
+			if (k_mem_paging_backing_store_location_get(pf, &location,
+								    true) == 0) {
+				k_mem_paging_backing_store_location_free(location);
+			}
+		}
+#endif /* CONFIG_DEMAND_PAGING */
+
 		/* Put the page frame back into free list */
 		page_frame_free_locked(pf);
 	}
@@ -1076,6 +1088,9 @@ static int page_frame_prepare_locked(struct z_page_frame *pf, bool *dirty_ptr,
 			return -ENOMEM;
 		}
 		arch_mem_page_out(pf->addr, *location_ptr);
+
+		/* Any clean copy now belongs to the evicted data page */
+		pf->flags &= ~Z_PAGE_FRAME_BACKED;
 	} else {
 		/* Shouldn't happen unless this function is mis-used */
 		__ASSERT(!dirty, "un-mapped page determined to be dirty");
@@ -1219,6 +1234,165 @@ out:
 	return ret;
 }
 
+#ifdef CONFIG_DEMAND_PAGING_PAGE_CLEANER
+/*
+ * Page cleaner
+ *
+ * Once there are no free page frames left, every page fault has to evict
+ * a data page, and if that one is dirty, write it out before reading the
+ * faulting page in. The page cleaner thread writes dirty data pages which
+ * haven't been accessed recently back to the backing store ahead of time,
+ * in batches, so that page faults mostly find clean pages to evict.
+ *
+ * A data page is marked clean before being copied, so that writes made
+ * during the copy set it dirty again and the copy isn't trusted. Once it
+ * is done, the page frame has a clean copy in the backing store, just like
+ * after a page-in.
+ *
+ * Collected page frames are busy until the batch is written back. This
+ * keeps them from being evicted meanwhile, and keeps the backing store
+ * from handing a location already given to one of them to another one
+ * of the batch in place of a clean copy.
+ */
+#define CLEANER_BATCH CONFIG_DEMAND_PAGING_PAGE_CLEANER_BATCH
+
+static K_KERNEL_PINNED_STACK_DEFINE(page_cleaner_stack,
+				    CONFIG_DEMAND_PAGING_PAGE_CLEANER_STACK_SIZE);
+static struct k_thread page_cleaner_thread;
+
+__weak void
+k_mem_paging_backing_store_page_out_batch(struct z_page_frame *const *pfs,
+					  const uintptr_t *locations,
+					  size_t count)
+{
+	for (size_t i = 0; i < count; i++) {
+		arch_mem_scratch(z_page_frame_to_phys(pfs[i]));
+		k_mem_paging_backing_store_page_out(locations[i]);
+	}
+}
+
+/* Pick data pages to write back, and get them ready for it. Called with
+ * interrupts locked.
+ */
+static size_t page_cleaner_collect(struct z_page_frame **pfs,
+				   uintptr_t *locations)
+{
+	static size_t next;
+	struct z_page_frame *pf;
+	uintptr_t flags;
+	size_t count = 0;
+
+	for (size_t n = 0; (n < Z_NUM_PAGE_FRAMES) && (count < CLEANER_BATCH);
+	     n++) {
+		pf = &z_page_frames[next];
+		next = (next + 1U) % Z_NUM_PAGE_FRAMES;
+
+		if (!z_page_frame_is_evictable(pf)) {
+			continue;
+		}
+
+		flags = arch_page_info_get(pf->addr, NULL, false);
+		if ((flags & ARCH_DATA_PAGE_ACCESSED) != 0U) {
+			/* Likely to be written again soon */
+			continue;
+		}
+
+		if (((flags & ARCH_DATA_PAGE_DIRTY) == 0U) &&
+		    z_page_frame_is_backed(pf)) {
+			/* Already clean */
+			continue;
+		}
+
+		if (k_mem_paging_backing_store_location_get(pf, &locations[count],
+							    false) != 0) {
+			/* Keep what's left for page faults */
+			break;
+		}
+
+		arch_page_dirty_clear(pf->addr);
+		pf->flags |= Z_PAGE_FRAME_BUSY;
+		pfs[count] = pf;
+		count++;
+	}
+
+	return count;
+}
+
+static void page_cleaner_run(void)
+{
+	struct z_page_frame *pfs[CLEANER_BATCH];
+	uintptr_t locations[CLEANER_BATCH];
+	size_t count;
+	int key;
+
+	/* Same locking as for evictions, see do_page_fault() */
+#ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
+	k_sched_lock();
+#endif /* CONFIG_DEMAND_PAGING_ALLOW_IRQ */
+	key = irq_lock();
+
+	if (z_free_page_count != 0U) {
+		/* Page faults don't need to evict anything yet */
+		goto out;
+	}
+
+	count = page_cleaner_collect(pfs, locations);
+	if (count == 0U) {
+		goto out;
+	}
+
+#ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
+	irq_unlock(key);
+#endif /* CONFIG_DEMAND_PAGING_ALLOW_IRQ */
+	k_mem_paging_backing_store_page_out_batch(pfs, locations, count);
+#ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
+	key = irq_lock();
+#endif /* CONFIG_DEMAND_PAGING_ALLOW_IRQ */
+
+	for (size_t i = 0; i < count; i++) {
+		pfs[i]->flags &= ~Z_PAGE_FRAME_BUSY;
+		pfs[i]->flags |= Z_PAGE_FRAME_BACKED;
+
+		/* Don't let the copy count as a recent access */
+		(void)arch_page_info_get(pfs[i]->addr, NULL, true);
+	}
+
+#ifdef CONFIG_DEMAND_PAGING_STATS
+	paging_stats.eviction.cleaned += count;
+#endif /* CONFIG_DEMAND_PAGING_STATS */
+out:
+	irq_unlock(key);
+#ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
+	k_sched_unlock();
+#endif /* CONFIG_DEMAND_PAGING_ALLOW_IRQ */
+}
+
+static void page_cleaner(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		k_msleep(CONFIG_DEMAND_PAGING_PAGE_CLEANER_PERIOD);
+		page_cleaner_run();
+	}
+}
+
+static int page_cleaner_init(void)
+{
+	k_thread_create(&page_cleaner_thread, page_cleaner_stack,
+			K_KERNEL_STACK_SIZEOF(page_cleaner_stack),
+			page_cleaner, NULL, NULL, NULL,
+			K_LOWEST_APPLICATION_THREAD_PRIO, 0, K_NO_WAIT);
+	k_thread_name_set(&page_cleaner_thread, "page_cleaner");
+
+	return 0;
+}
+
+SYS_INIT(page_cleaner_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+#endif /* CONFIG_DEMAND_PAGING_PAGE_CLEANER */
+
 static inline void paging_stats_faults_inc(struct k_thread *faulting_thread,
 					   int key)
 {
@@ -1312,7 +1486,20 @@ static inline struct z_page_frame *do_eviction_select(bool *dirty)
 	return pf;
 }
 
-static bool do_page_fault(void *addr, bool pin)
+static inline void paging_stats_prefetch_inc(struct k_thread *faulting_thread)
+{
+#ifdef CONFIG_DEMAND_PAGING_STATS
+	paging_stats.pagefaults.prefetched++;
+
+#ifdef CONFIG_DEMAND_PAGING_THREAD_STATS
+	faulting_thread->paging_stats.pagefaults.prefetched++;
+#else
+	ARG_UNUSED(faulting_thread);
+#endif /* CONFIG_DEMAND_PAGING_THREAD_STATS */
+#endif /* CONFIG_DEMAND_PAGING_STATS */
+}
+
+static bool do_page_fault(void *addr, bool pin, bool prefetch)
 {
 	struct z_page_frame *pf;
 	int key, ret;
@@ -1391,7 +1578,11 @@ static bool do_page_fault(void *addr, bool pin)
 	__ASSERT(status == ARCH_PAGE_LOCATION_PAGED_OUT,
 		 "unexpected status value %d", status);
 
-	paging_stats_faults_inc(faulting_thread, key);
+	if (prefetch) {
+		paging_stats_prefetch_inc(faulting_thread);
+	} else {
+		paging_stats_faults_inc(faulting_thread, key);
+	}
 
 	pf = free_page_frame_list_get();
 	if (pf == NULL) {
@@ -1444,7 +1635,7 @@ static void do_page_in(void *addr)
 {
 	bool ret;
 
-	ret = do_page_fault(addr, false);
+	ret = do_page_fault(addr, false, false);
 	__ASSERT(ret, "unmapped memory address %p", addr);
 	(void)ret;
 }
@@ -1461,7 +1652,7 @@ static void do_mem_pin(void *addr)
 {
 	bool ret;
 
-	ret = do_page_fault(addr, true);
+	ret = do_page_fault(addr, true, false);
 	__ASSERT(ret, "unmapped memory address %p", addr);
 	(void)ret;
 }
@@ -1474,9 +1665,102 @@ void k_mem_pin(void *addr, size_t size)
 	virt_region_foreach(addr, size, do_mem_pin);
 }
 
+#if CONFIG_DEMAND_PAGING_PREFETCH > 0
+/*
+ * Number of prefetches holding each page frame. Several threads may fault
+ * on the same page and prefetch after it concurrently; Z_PAGE_FRAME_HELD
+ * stays set until the last of them is done. Only accessed with interrupts
+ * locked.
+ */
+static uint16_t page_frame_holds[Z_NUM_PAGE_FRAMES];
+
+static void page_frame_hold(struct z_page_frame *pf)
+{
+	uint16_t *holds = &page_frame_holds[pf - z_page_frames];
+
+	__ASSERT(*holds < UINT16_MAX, "too many holds on page frame %p", pf);
+	(*holds)++;
+	pf->flags |= Z_PAGE_FRAME_HELD;
+}
+
+static void page_frame_release(struct z_page_frame *pf)
+{
+	uint16_t *holds = &page_frame_holds[pf - z_page_frames];
+
+	__ASSERT(*holds > 0U, "page frame %p not held", pf);
+	(*holds)--;
+	if (*holds == 0U) {
+		pf->flags &= ~Z_PAGE_FRAME_HELD;
+	}
+}
+
+/*
+ * Page in the data pages following one which just faulted, until one of
+ * them isn't paged out. The faulting page is held meanwhile so that
+ * making room for the others doesn't evict it. This uses its own flag
+ * rather than the pin one, which k_mem_pin() and k_mem_unpin() may
+ * change in the meantime.
+ */
+static void do_page_prefetch(void *addr)
+{
+	struct z_page_frame *pf;
+	uint8_t *pos;
+	int key;
+	uintptr_t flags, phys, location;
+	enum arch_page_location status;
+
+	if (k_is_in_isr()) {
+		return;
+	}
+
+	pos = UINT_TO_POINTER(POINTER_TO_UINT(addr) &
+			      ~(CONFIG_MMU_PAGE_SIZE - 1));
+
+	key = irq_lock();
+	flags = arch_page_info_get(pos, &phys, false);
+	if ((flags & ARCH_DATA_PAGE_LOADED) == 0) {
+		/* Already evicted again by someone else */
+		irq_unlock(key);
+		return;
+	}
+	pf = z_phys_to_page_frame(phys);
+	page_frame_hold(pf);
+	irq_unlock(key);
+
+	for (int i = 0; i < CONFIG_DEMAND_PAGING_PREFETCH; i++) {
+		pos += CONFIG_MMU_PAGE_SIZE;
+		if (pos >= Z_VIRT_RAM_END) {
+			break;
+		}
+
+		key = irq_lock();
+		status = arch_page_location_get(pos, &location);
+		irq_unlock(key);
+		if (status != ARCH_PAGE_LOCATION_PAGED_OUT) {
+			break;
+		}
+
+		(void)do_page_fault(pos, false, true);
+	}
+
+	key = irq_lock();
+	page_frame_release(pf);
+	irq_unlock(key);
+}
+#endif /* CONFIG_DEMAND_PAGING_PREFETCH > 0 */
+
 bool z_page_fault(void *addr)
 {
-	return do_page_fault(addr, false);
+	bool ret;
+
+	ret = do_page_fault(addr, false, false);
+#if CONFIG_DEMAND_PAGING_PREFETCH > 0
+	if (ret) {
+		do_page_prefetch(addr);
+	}
+#endif /* CONFIG_DEMAND_PAGING_PREFETCH > 0 */
+
+	return ret;
 }
 
 static void do_mem_unpin(void *addr)
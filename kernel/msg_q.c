@@ -32,6 +32,61 @@ static inline void handle_poll_events(struct k_msgq *msgq, uint32_t state)
 }
 #endif /* CONFIG_POLL */
 
+/* Append a message to the ring, lock must be held */
+static inline void ring_put(struct k_msgq *msgq, const void *data)
+{
+	(void)memcpy(msgq->write_ptr, data, msgq->msg_size);
+	msgq->write_ptr += msgq->msg_size;
+	if (msgq->write_ptr == msgq->buffer_end) {
+		msgq->write_ptr = msgq->buffer_start;
+	}
+	msgq->used_msgs++;
+}
+
+/* Remove the oldest message from the ring, lock must be held */
+static inline void ring_get(struct k_msgq *msgq, void *data)
+{
+	(void)memcpy(data, msgq->read_ptr, msgq->msg_size);
+	msgq->read_ptr += msgq->msg_size;
+	if (msgq->read_ptr == msgq->buffer_end) {
+		msgq->read_ptr = msgq->buffer_start;
+	}
+	msgq->used_msgs--;
+}
+
+/* Number of messages that fit between ptr and the end of the ring */
+static inline uint32_t msgs_to_end(struct k_msgq *msgq, const char *ptr)
+{
+	return (uint32_t)((msgq->buffer_end - ptr) / msgq->msg_size);
+}
+
+/* Complete a pended k_msgq_put()/k_msgq_get(), lock must be held */
+static inline void wake_pending(struct k_thread *thread)
+{
+	arch_thread_return_value_set(thread, 0);
+	z_ready_thread(thread);
+}
+
+/* Let writers blocked on a full queue move their message in after
+ * messages have been removed, lock must be held.
+ *
+ * @return true if a thread was woken, i.e. a reschedule is pending
+ */
+static bool refill_from_writers(struct k_msgq *msgq)
+{
+	struct k_thread *pending_thread;
+	bool woken = false;
+
+	while ((msgq->used_msgs < msgq->max_msgs) &&
+	       ((pending_thread = z_unpend_first_thread(&msgq->wait_q)) != NULL)) {
+		ring_put(msgq, pending_thread->base.swap_data);
+		wake_pending(pending_thread);
+		woken = true;
+	}
+
+	return woken;
+}
+
 void k_msgq_init(struct k_msgq *msgq, char *buffer, size_t msg_size,
 		 uint32_t max_msgs)
 {
@@ -125,7 +180,10 @@ int z_impl_k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t timeout
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, put, msgq, timeout);
 
-	if (msgq->used_msgs < msgq->max_msgs) {
+	if ((msgq->flags & K_MSGQ_FLAG_PUT_CLAIM) != 0U) {
+		/* a producer is writing in place at write_ptr */
+		result = -EBUSY;
+	} else if (msgq->used_msgs < msgq->max_msgs) {
 		/* message queue isn't full */
 		pending_thread = z_unpend_first_thread(&msgq->wait_q);
 		if (pending_thread != NULL) {
@@ -135,18 +193,12 @@ int z_impl_k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t timeout
 			(void)memcpy(pending_thread->base.swap_data, data,
 			       msgq->msg_size);
 			/* wake up waiting thread */
-			arch_thread_return_value_set(pending_thread, 0);
-			z_ready_thread(pending_thread);
+			wake_pending(pending_thread);
 			z_reschedule(&msgq->lock, key);
 			return 0;
 		} else {
 			/* put message in queue */
-			(void)memcpy(msgq->write_ptr, data, msgq->msg_size);
-			msgq->write_ptr += msgq->msg_size;
-			if (msgq->write_ptr == msgq->buffer_end) {
-				msgq->write_ptr = msgq->buffer_start;
-			}
-			msgq->used_msgs++;
+			ring_put(msgq, data);
 #ifdef CONFIG_POLL
 			handle_poll_events(msgq, K_POLL_STATE_MSGQ_DATA_AVAILABLE);
 #endif /* CONFIG_POLL */
@@ -215,14 +267,12 @@ int z_impl_k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout)
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, get, msgq, timeout);
 
-	if (msgq->used_msgs > 0U) {
+	if ((msgq->flags & K_MSGQ_FLAG_GET_CLAIM) != 0U) {
+		/* a consumer is reading in place at read_ptr */
+		result = -EBUSY;
+	} else if (msgq->used_msgs > 0U) {
 		/* take first available message from queue */
-		(void)memcpy(data, msgq->read_ptr, msgq->msg_size);
-		msgq->read_ptr += msgq->msg_size;
-		if (msgq->read_ptr == msgq->buffer_end) {
-			msgq->read_ptr = msgq->buffer_start;
-		}
-		msgq->used_msgs--;
+		ring_get(msgq, data);
 
 		/* handle first thread waiting to write (if any) */
 		pending_thread = z_unpend_first_thread(&msgq->wait_q);
@@ -230,17 +280,10 @@ int z_impl_k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout)
 			SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_msgq, get, msgq, timeout);
 
 			/* add thread's message to queue */
-			(void)memcpy(msgq->write_ptr, pending_thread->base.swap_data,
-			       msgq->msg_size);
-			msgq->write_ptr += msgq->msg_size;
-			if (msgq->write_ptr == msgq->buffer_end) {
-				msgq->write_ptr = msgq->buffer_start;
-			}
-			msgq->used_msgs++;
+			ring_put(msgq, pending_thread->base.swap_data);
 
 			/* wake up waiting thread */
-			arch_thread_return_value_set(pending_thread, 0);
-			z_ready_thread(pending_thread);
+			wake_pending(pending_thread);
 			z_reschedule(&msgq->lock, key);
 
 			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, get, msgq, timeout, 0);
@@ -281,6 +324,277 @@ static inline int z_vrfy_k_msgq_get(struct k_msgq *msgq, void *data,
 #include <syscalls/k_msgq_get_mrsh.c>
 #endif
 
+int z_impl_k_msgq_put_many(struct k_msgq *msgq, const void *data,
+			   uint32_t num_msgs, k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	struct k_thread *pending_thread;
+	const char *src = data;
+	k_spinlock_key_t key;
+	bool woken = false;
+	uint32_t n = 0U;
+	int result = 0;
+
+	key = k_spin_lock(&msgq->lock);
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, put, msgq, timeout);
+
+	if ((msgq->flags & K_MSGQ_FLAG_PUT_CLAIM) != 0U) {
+		result = -EBUSY;
+	} else if (msgq->used_msgs < msgq->max_msgs) {
+		/* Threads waiting on an empty queue take the first messages,
+		 * the rest go into the ring.  Everybody is woken up with a
+		 * single reschedule at the end.
+		 */
+		while ((n < num_msgs) &&
+		       ((pending_thread = z_unpend_first_thread(&msgq->wait_q)) != NULL)) {
+			(void)memcpy(pending_thread->base.swap_data, src,
+				     msgq->msg_size);
+			wake_pending(pending_thread);
+			src += msgq->msg_size;
+			n++;
+			woken = true;
+		}
+
+		while ((n < num_msgs) &&
+		       (msgq->used_msgs < msgq->max_msgs)) {
+			ring_put(msgq, src);
+			src += msgq->msg_size;
+			n++;
+		}
+
+#ifdef CONFIG_POLL
+		if (msgq->used_msgs > 0U) {
+			handle_poll_events(msgq, K_POLL_STATE_MSGQ_DATA_AVAILABLE);
+		}
+#endif /* CONFIG_POLL */
+		result = (int)n;
+	} else if ((num_msgs == 0U) || K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		result = (num_msgs == 0U) ? 0 : -ENOMSG;
+	} else {
+		SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_msgq, put, msgq, timeout);
+
+		/* Full: wait to hand over the first message, like
+		 * k_msgq_put() does
+		 */
+		_current->base.swap_data = (void *)data;
+
+		result = z_pend_curr(&msgq->lock, key, &msgq->wait_q, timeout);
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put, msgq, timeout, result);
+		return (result == 0) ? 1 : result;
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put, msgq, timeout, result);
+
+	if (woken) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+
+	return result;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_msgq_put_many(struct k_msgq *msgq, const void *data,
+					 uint32_t num_msgs, k_timeout_t timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(msgq, K_OBJ_MSGQ));
+	Z_OOPS(Z_SYSCALL_MEMORY_ARRAY_READ(data, num_msgs, msgq->msg_size));
+
+	return z_impl_k_msgq_put_many(msgq, data, num_msgs, timeout);
+}
+#include <syscalls/k_msgq_put_many_mrsh.c>
+#endif
+
+int z_impl_k_msgq_get_many(struct k_msgq *msgq, void *data,
+			   uint32_t max_msgs, k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	char *dst = data;
+	k_spinlock_key_t key;
+	bool woken = false;
+	uint32_t n = 0U;
+	int result = 0;
+
+	key = k_spin_lock(&msgq->lock);
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, get, msgq, timeout);
+
+	if ((msgq->flags & K_MSGQ_FLAG_GET_CLAIM) != 0U) {
+		result = -EBUSY;
+	} else if (msgq->used_msgs > 0U) {
+		while ((n < max_msgs) && (msgq->used_msgs > 0U)) {
+			ring_get(msgq, dst);
+			dst += msgq->msg_size;
+			n++;
+		}
+
+		/* Writers blocked on the full queue fill up the space in
+		 * one go, and are woken up with a single reschedule.
+		 */
+		woken = refill_from_writers(msgq);
+		result = (int)n;
+	} else if ((max_msgs == 0U) || K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		result = (max_msgs == 0U) ? 0 : -ENOMSG;
+	} else {
+		SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_msgq, get, msgq, timeout);
+
+		/* Empty: wait for a single message, like k_msgq_get() does */
+		_current->base.swap_data = data;
+
+		result = z_pend_curr(&msgq->lock, key, &msgq->wait_q, timeout);
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, get, msgq, timeout, result);
+		return (result == 0) ? 1 : result;
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, get, msgq, timeout, result);
+
+	if (woken) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+
+	return result;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_msgq_get_many(struct k_msgq *msgq, void *data,
+					 uint32_t max_msgs, k_timeout_t timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(msgq, K_OBJ_MSGQ));
+	Z_OOPS(Z_SYSCALL_MEMORY_ARRAY_WRITE(data, max_msgs, msgq->msg_size));
+
+	return z_impl_k_msgq_get_many(msgq, data, max_msgs, timeout);
+}
+#include <syscalls/k_msgq_get_many_mrsh.c>
+#endif
+
+int k_msgq_put_claim(struct k_msgq *msgq, void **data, uint32_t max_msgs)
+{
+	k_spinlock_key_t key = k_spin_lock(&msgq->lock);
+	int result;
+
+	if ((msgq->flags & K_MSGQ_FLAG_PUT_CLAIM) != 0U) {
+		result = -EBUSY;
+	} else {
+		/* Free slots are contiguous up to the end of the ring */
+		result = MIN(MIN(msgq->max_msgs - msgq->used_msgs,
+				 msgs_to_end(msgq, msgq->write_ptr)),
+			     max_msgs);
+		if (result > 0) {
+			msgq->flags |= K_MSGQ_FLAG_PUT_CLAIM;
+			*data = msgq->write_ptr;
+		}
+	}
+
+	k_spin_unlock(&msgq->lock, key);
+
+	return result;
+}
+
+int k_msgq_put_commit(struct k_msgq *msgq, uint32_t num_msgs)
+{
+	struct k_thread *pending_thread;
+	k_spinlock_key_t key;
+	bool woken = false;
+
+	key = k_spin_lock(&msgq->lock);
+
+	CHECKIF(((msgq->flags & K_MSGQ_FLAG_PUT_CLAIM) == 0U) ||
+		(num_msgs > MIN(msgq->max_msgs - msgq->used_msgs,
+				msgs_to_end(msgq, msgq->write_ptr)))) {
+		k_spin_unlock(&msgq->lock, key);
+		return -EINVAL;
+	}
+
+	msgq->flags &= ~K_MSGQ_FLAG_PUT_CLAIM;
+
+	msgq->write_ptr += num_msgs * msgq->msg_size;
+	if (msgq->write_ptr == msgq->buffer_end) {
+		msgq->write_ptr = msgq->buffer_start;
+	}
+	msgq->used_msgs += num_msgs;
+
+	/* Threads waiting on the queue while it was empty take the
+	 * oldest messages
+	 */
+	while ((msgq->used_msgs > 0U) &&
+	       ((pending_thread = z_unpend_first_thread(&msgq->wait_q)) != NULL)) {
+		ring_get(msgq, pending_thread->base.swap_data);
+		wake_pending(pending_thread);
+		woken = true;
+	}
+
+#ifdef CONFIG_POLL
+	if (msgq->used_msgs > 0U) {
+		handle_poll_events(msgq, K_POLL_STATE_MSGQ_DATA_AVAILABLE);
+	}
+#endif /* CONFIG_POLL */
+
+	if (woken) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+
+	return 0;
+}
+
+int k_msgq_get_claim(struct k_msgq *msgq, void **data, uint32_t max_msgs)
+{
+	k_spinlock_key_t key = k_spin_lock(&msgq->lock);
+	int result;
+
+	if ((msgq->flags & K_MSGQ_FLAG_GET_CLAIM) != 0U) {
+		result = -EBUSY;
+	} else {
+		/* Messages are contiguous up to the end of the ring */
+		result = MIN(MIN(msgq->used_msgs,
+				 msgs_to_end(msgq, msgq->read_ptr)),
+			     max_msgs);
+		if (result > 0) {
+			msgq->flags |= K_MSGQ_FLAG_GET_CLAIM;
+			*data = msgq->read_ptr;
+		}
+	}
+
+	k_spin_unlock(&msgq->lock, key);
+
+	return result;
+}
+
+int k_msgq_get_commit(struct k_msgq *msgq, uint32_t num_msgs)
+{
+	k_spinlock_key_t key = k_spin_lock(&msgq->lock);
+
+	CHECKIF(((msgq->flags & K_MSGQ_FLAG_GET_CLAIM) == 0U) ||
+		(num_msgs > MIN(msgq->used_msgs,
+				msgs_to_end(msgq, msgq->read_ptr)))) {
+		k_spin_unlock(&msgq->lock, key);
+		return -EINVAL;
+	}
+
+	msgq->flags &= ~K_MSGQ_FLAG_GET_CLAIM;
+
+	msgq->read_ptr += num_msgs * msgq->msg_size;
+	if (msgq->read_ptr == msgq->buffer_end) {
+		msgq->read_ptr = msgq->buffer_start;
+	}
+	msgq->used_msgs -= num_msgs;
+
+	if (refill_from_writers(msgq)) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+
+	return 0;
+}
+
 int z_impl_k_msgq_peek(struct k_msgq *msgq, void *data)
 {
 	k_spinlock_key_t key;
@@ -379,6 +693,9 @@ void z_impl_k_msgq_purge(struct k_msgq *msgq)
 	msgq->used_msgs = 0;
 	msgq->read_ptr = msgq->write_ptr;
 
+	/* Nothing is left to be read in place */
+	msgq->flags &= ~K_MSGQ_FLAG_GET_CLAIM;
+
 	z_reschedule(&msgq->lock, key);
 }
 
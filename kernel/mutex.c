@@ -92,11 +92,72 @@ static bool adjust_owner_prio(struct k_mutex *mutex, int32_t new_prio)
 	return false;
 }
 
+#ifdef CONFIG_MUTEX_ADAPTIVE_SPIN
+static inline bool thread_running_elsewhere(struct k_thread *thread)
+{
+	unsigned int cpu = thread->base.cpu;
+
+	return (cpu != arch_curr_cpu()->id) && (_kernel.cpus[cpu].current == thread);
+}
+
+/*
+ * Optimistic spinning: an owner that is running on another CPU is
+ * likely to release the mutex soon, so wait for that with the lock
+ * dropped rather than pay for pending and being woken up again.
+ * Waiters that are already pended keep their hand-off priority since
+ * unlock passes the mutex to them directly.  Called and returns with
+ * the lock held, true if the mutex is now free.  The time spent
+ * spinning is taken off *timeout, which is K_NO_WAIT on return if
+ * it ran out.
+ */
+static bool mutex_spin(struct k_mutex *mutex, k_timeout_t *timeout,
+		       k_spinlock_key_t *key)
+{
+	struct k_thread *owner = mutex->owner;
+	uint32_t budget = k_us_to_cyc_ceil32(CONFIG_MUTEX_ADAPTIVE_SPIN_US);
+	int64_t end;
+	uint32_t start;
+
+	if (K_TIMEOUT_EQ(*timeout, K_NO_WAIT) || !thread_running_elsewhere(owner)) {
+		return false;
+	}
+
+	end = sys_clock_timeout_end_calc(*timeout);
+	k_spin_unlock(&lock, *key);
+
+	start = k_cycle_get_32();
+	do {
+		struct k_thread *curr_owner = *(struct k_thread *volatile *)&mutex->owner;
+
+		if ((curr_owner != owner) || !thread_running_elsewhere(owner)) {
+			break;
+		}
+	} while ((k_cycle_get_32() - start) < budget);
+
+	if (!K_TIMEOUT_EQ(*timeout, K_FOREVER)) {
+		int64_t left = end - sys_clock_tick_get();
+
+		*timeout = (left > 0) ? K_TICKS(left) : K_NO_WAIT;
+	}
+
+	*key = k_spin_lock(&lock);
+
+	return mutex->lock_count == 0U;
+}
+#else
+static inline bool mutex_spin(struct k_mutex *mutex, k_timeout_t *timeout,
+			      k_spinlock_key_t *key)
+{
+	return false;
+}
+#endif
+
 int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 {
 	int new_prio;
 	k_spinlock_key_t key;
 	bool resched = false;
+	k_timeout_t wait = timeout;
 
 	__ASSERT(!arch_is_in_isr(), "mutexes cannot be used inside ISRs");
 
@@ -104,7 +165,8 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 
 	key = k_spin_lock(&lock);
 
-	if (likely((mutex->lock_count == 0U) || (mutex->owner == _current))) {
+	if (likely((mutex->lock_count == 0U) || (mutex->owner == _current)) ||
+	    mutex_spin(mutex, &wait, &key)) {
 
 		mutex->owner_orig_prio = (mutex->lock_count == 0U) ?
 					_current->base.prio :
@@ -132,6 +194,15 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 		return -EBUSY;
 	}
 
+	/* The whole timeout went into spinning */
+	if (unlikely(K_TIMEOUT_EQ(wait, K_NO_WAIT))) {
+		k_spin_unlock(&lock, key);
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, lock, mutex, timeout, -EAGAIN);
+
+		return -EAGAIN;
+	}
+
 	SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_mutex, lock, mutex, timeout);
 
 	new_prio = new_prio_for_inheritance(_current->base.prio,
@@ -143,7 +214,7 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 		resched = adjust_owner_prio(mutex, new_prio);
 	}
 
-	int got_mutex = z_pend_curr(&lock, key, &mutex->wait_q, timeout);
+	int got_mutex = z_pend_curr(&lock, key, &mutex->wait_q, wait);
 
 	LOG_DBG("on mutex %p got_mutex value: %d", mutex, got_mutex);
 
@@ -28,7 +28,7 @@ struct waitq_walk_data {
 };
 
 static int pipe_get_internal(k_spinlock_key_t key, struct k_pipe *pipe,
-			     void *data, size_t bytes_to_read,
+			     const struct k_pipe_iovec *iov, size_t iov_cnt,
 			     size_t *bytes_read, size_t min_xfer,
 			     k_timeout_t timeout);
 
@@ -101,11 +101,16 @@ void z_impl_k_pipe_flush(struct k_pipe *pipe)
 {
 	size_t  bytes_read;
 
+	struct k_pipe_iovec iov = { NULL, (size_t) -1 };
+
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_pipe, flush, pipe);
 
 	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
 
-	(void) pipe_get_internal(key, pipe, NULL, (size_t) -1, &bytes_read, 0U,
+	/* Claimed data is flushed as well */
+	pipe->flags &= ~K_PIPE_FLAG_GET_CLAIM;
+
+	(void) pipe_get_internal(key, pipe, &iov, 1U, &bytes_read, 0U,
 				 K_NO_WAIT);
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_pipe, flush, pipe);
@@ -125,13 +130,19 @@ void z_impl_k_pipe_buffer_flush(struct k_pipe *pipe)
 {
 	size_t  bytes_read;
 
+	struct k_pipe_iovec iov = { NULL, 0U };
+
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_pipe, buffer_flush, pipe);
 
 	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
 
+	/* Claimed data is flushed as well */
+	pipe->flags &= ~K_PIPE_FLAG_GET_CLAIM;
+
 	if (pipe->buffer != NULL) {
-		(void) pipe_get_internal(key, pipe, NULL, pipe->size,
-					 &bytes_read, 0U, K_NO_WAIT);
+		iov.len = pipe->size;
+		(void) pipe_get_internal(key, pipe, &iov, 1U, &bytes_read,
+					 0U, K_NO_WAIT);
 	} else {
 		k_spin_unlock(&pipe->lock, key);
 	}
@@ -206,6 +217,73 @@ static size_t pipe_xfer(unsigned char *dest, size_t dest_size,
 	return num_bytes;
 }
 
+/**
+ * @brief Move on to the next non-empty segment of a descriptor
+ *
+ * Does nothing until the current segment has been transferred.
+ */
+static void pipe_desc_next(struct _pipe_desc *desc)
+{
+	while ((desc->bytes_to_xfer == 0U) && (desc->iov_cnt != 0U)) {
+		desc->buffer = desc->iov->data;
+		desc->bytes_to_xfer = desc->iov->len;
+		desc->iov_bytes -= desc->iov->len;
+		desc->iov++;
+		desc->iov_cnt--;
+	}
+}
+
+/**
+ * @brief Set up a descriptor for a thread's scatter/gather list
+ *
+ * @return Total number of bytes to transfer
+ */
+static size_t pipe_desc_init(struct _pipe_desc *desc,
+			     const struct k_pipe_iovec *iov, size_t iov_cnt)
+{
+	desc->buffer = NULL;
+	desc->bytes_to_xfer = 0U;
+	desc->iov = iov;
+	desc->iov_cnt = iov_cnt;
+	desc->iov_bytes = 0U;
+
+	for (size_t i = 0; i < iov_cnt; i++) {
+		desc->iov_bytes += iov[i].len;
+	}
+
+	pipe_desc_next(desc);
+
+	return desc->bytes_to_xfer + desc->iov_bytes;
+}
+
+/* # bytes that can be written in place from the write index */
+static size_t pipe_space_contig(struct k_pipe *pipe)
+{
+	if (pipe->bytes_used == pipe->size) {
+		return 0U;
+	}
+
+	if (pipe->write_index < pipe->read_index) {
+		return pipe->read_index - pipe->write_index;
+	}
+
+	return pipe->size - pipe->write_index;
+}
+
+/* # bytes that can be read in place from the read index */
+static size_t pipe_data_contig(struct k_pipe *pipe)
+{
+	if (pipe->bytes_used == 0U) {
+		return 0U;
+	}
+
+	if (pipe->read_index < pipe->write_index) {
+		return pipe->write_index - pipe->read_index;
+	}
+
+	return pipe->size - pipe->read_index;
+}
+
 /**
  * @brief Callback routine used to populate wait list
  *
@@ -218,7 +296,7 @@ static int pipe_walk_op(struct k_thread *thread, void *data)
 
 	sys_dlist_append(walk_data->list, &desc->node);
 
-	walk_data->bytes_available += desc->bytes_to_xfer;
+	walk_data->bytes_available += desc->bytes_to_xfer + desc->iov_bytes;
 
 	if (walk_data->bytes_available >= walk_data->bytes_requested) {
 		return 1;
@@ -268,6 +346,8 @@ static size_t pipe_buffer_list_populate(sys_dlist_t         *list,
 
 	desc[0].thread = NULL;
 	desc[0].buffer = &buffer[start];
+	desc[0].iov_cnt = 0U;
+	desc[0].iov_bytes = 0U;
 
 	if (start < end) {
 		desc[0].bytes_to_xfer = end - start;
@@ -279,6 +359,8 @@ static size_t pipe_buffer_list_populate(sys_dlist_t         *list,
 	desc[1].thread = NULL;
 	desc[1].buffer = &buffer[0];
 	desc[1].bytes_to_xfer = end;
+	desc[1].iov_cnt = 0U;
+	desc[1].iov_bytes = 0U;
 
 	sys_dlist_append(list, &desc[1].node);
 
@@ -338,6 +420,20 @@ static size_t pipe_write(struct k_pipe *pipe, sys_dlist_t *src_list,
 		src->buffer         += bytes_copied;
 		src->bytes_to_xfer  -= bytes_copied;
 
+		pipe_desc_next(dest);
+		pipe_desc_next(src);
+
+		if (src->thread == NULL) {
+
+			/* Reading from the pipe buffer. Update details. */
+
+			pipe->bytes_used -= bytes_copied;
+			pipe->read_index += bytes_copied;
+			if (pipe->read_index >= pipe->size) {
+				pipe->read_index -= pipe->size;
+			}
+		}
+
 		if (dest->thread == NULL) {
 
 			/* Writing to the pipe buffer. Update details. */
@@ -369,15 +465,97 @@ static size_t pipe_write(struct k_pipe *pipe, sys_dlist_t *src_list,
 	return num_bytes_written;
 }
 
-int z_impl_k_pipe_put(struct k_pipe *pipe, void *data, size_t bytes_to_write,
-		     size_t *bytes_written, size_t min_xfer,
-		      k_timeout_t timeout)
+/**
+ * @brief Hand data in the pipe buffer to waiting readers
+ *
+ * @return true if a reader was readied
+ */
+static bool pipe_feed_readers(struct k_pipe *pipe)
+{
+	struct _pipe_desc  pipe_desc[2];
+	sys_dlist_t        src_list;
+	sys_dlist_t        dest_list;
+	bool               reschedule_needed = false;
+
+	if (pipe->bytes_used == 0U) {
+		return false;
+	}
+
+	sys_dlist_init(&src_list);
+	sys_dlist_init(&dest_list);
+
+	if (pipe_waiter_list_populate(&dest_list, &pipe->wait_q.readers,
+				      pipe->bytes_used) == 0U) {
+		return false;
+	}
+
+	(void) pipe_buffer_list_populate(&src_list, pipe_desc, pipe->buffer,
+					 pipe->size, pipe->read_index,
+					 pipe->write_index);
+
+	(void) pipe_write(pipe, &src_list, &dest_list, &reschedule_needed);
+
+	return reschedule_needed;
+}
+
+/**
+ * @brief Refill the pipe buffer from waiting writers
+ *
+ * Writers whose data has all gone into the pipe buffer are readied.
+ */
+static void pipe_refill(struct k_pipe *pipe, bool *reschedule)
+{
+	struct _pipe_desc   pipe_desc[2];
+	struct _pipe_desc  *desc;
+	struct k_thread    *thread;
+	sys_dlist_t         src_list;
+	sys_dlist_t         pipe_list;
+
+	/* Claimed free space is not ours to fill */
+	if ((pipe->bytes_used == pipe->size) ||
+	    ((pipe->flags & K_PIPE_FLAG_PUT_CLAIM) != 0U)) {
+		return;
+	}
+
+	sys_dlist_init(&src_list);
+	sys_dlist_init(&pipe_list);
+
+	(void) pipe_waiter_list_populate(&src_list,
+					 &pipe->wait_q.writers,
+					 pipe->size - pipe->bytes_used);
+
+	(void) pipe_buffer_list_populate(&pipe_list, pipe_desc,
+					 pipe->buffer, pipe->size,
+					 pipe->write_index,
+					 pipe->read_index);
+
+	(void) pipe_write(pipe, &src_list, &pipe_list, reschedule);
+
+	/* Writers are drained in wait queue order */
+	while ((thread = z_waitq_head(&pipe->wait_q.writers)) != NULL) {
+		desc = (struct _pipe_desc *)thread->base.swap_data;
+		if ((desc->bytes_to_xfer + desc->iov_bytes) != 0U) {
+			break;
+		}
+
+		z_unpend_thread(thread);
+		z_ready_thread(thread);
+
+		*reschedule = true;
+	}
+}
+
+static int pipe_put_internal(struct k_pipe *pipe,
+			     const struct k_pipe_iovec *iov, size_t iov_cnt,
+			     size_t *bytes_written, size_t min_xfer,
+			     k_timeout_t timeout)
 {
 	struct _pipe_desc  pipe_desc[2];
 	struct _pipe_desc  isr_desc;
 	struct _pipe_desc *src_desc;
 	sys_dlist_t        dest_list;
 	sys_dlist_t        src_list;
+	size_t             bytes_to_write;
 	size_t             bytes_can_write;
 	bool               reschedule_needed = false;
 
@@ -386,6 +564,15 @@ int z_impl_k_pipe_put(struct k_pipe *pipe, void *data, size_t bytes_to_write,
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_pipe, put, pipe, timeout);
 
+	/*
+	 * Do not use the pipe descriptor stored within k_thread if
+	 * invoked from within an ISR as that is not safe to do.
+	 */
+
+	src_desc = k_is_in_isr() ? &isr_desc : &_current->pipe_desc;
+
+	bytes_to_write = pipe_desc_init(src_desc, iov, iov_cnt);
+
 	CHECKIF((min_xfer > bytes_to_write) || bytes_written == NULL) {
 		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_pipe, put, pipe, timeout,
 					       -EINVAL);
@@ -398,6 +585,16 @@ int z_impl_k_pipe_put(struct k_pipe *pipe, void *data, size_t bytes_to_write,
 
 	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
 
+	if ((pipe->flags & K_PIPE_FLAG_PUT_CLAIM) != 0U) {
+		k_spin_unlock(&pipe->lock, key);
+		*bytes_written = 0U;
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_pipe, put, pipe,
+					       timeout, -EBUSY);
+
+		return -EBUSY;
+	}
+
 	/*
 	 * First, write to any waiting readers, if any exist.
 	 * Second, write to the pipe buffer, if it exists.
@@ -430,15 +627,6 @@ int z_impl_k_pipe_put(struct k_pipe *pipe, void *data, size_t bytes_to_write,
 		return -EIO;
 	}
 
-	/*
-	 * Do not use the pipe descriptor stored within k_thread if
-	 * invoked from within an ISR as that is not safe to do.
-	 */
-
-	src_desc = k_is_in_isr() ? &isr_desc : &_current->pipe_desc;
-
-	src_desc->buffer        = data;
-	src_desc->bytes_to_xfer = bytes_to_write;
 	src_desc->thread        = _current;
 	sys_dlist_append(&src_list, &src_desc->node);
 
@@ -494,16 +682,27 @@ int z_impl_k_pipe_put(struct k_pipe *pipe, void *data, size_t bytes_to_write,
 	key = k_spin_lock(&pipe->lock);
 	k_spin_unlock(&pipe->lock, key);
 
-	*bytes_written = bytes_to_write - src_desc->bytes_to_xfer;
+	size_t bytes_remaining = src_desc->bytes_to_xfer + src_desc->iov_bytes;
 
-	int ret = pipe_return_code(min_xfer, src_desc->bytes_to_xfer,
-				   bytes_to_write);
+	*bytes_written = bytes_to_write - bytes_remaining;
+
+	int ret = pipe_return_code(min_xfer, bytes_remaining, bytes_to_write);
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_pipe, put, pipe, timeout, ret);
 
 	return ret;
 }
 
+int z_impl_k_pipe_put(struct k_pipe *pipe, void *data, size_t bytes_to_write,
+		     size_t *bytes_written, size_t min_xfer,
+		      k_timeout_t timeout)
+{
+	struct k_pipe_iovec iov = { data, bytes_to_write };
+
+	return pipe_put_internal(pipe, &iov, 1U, bytes_written, min_xfer,
+				 timeout);
+}
+
 #ifdef CONFIG_USERSPACE
 int z_vrfy_k_pipe_put(struct k_pipe *pipe, void *data, size_t bytes_to_write,
 		     size_t *bytes_written, size_t min_xfer,
@@ -521,7 +720,7 @@ int z_vrfy_k_pipe_put(struct k_pipe *pipe, void *data, size_t bytes_to_write,
 #endif
 
 static int pipe_get_internal(k_spinlock_key_t key, struct k_pipe *pipe,
-			     void *data, size_t bytes_to_read,
+			     const struct k_pipe_iovec *iov, size_t iov_cnt,
 			     size_t *bytes_read, size_t min_xfer,
 			     k_timeout_t timeout)
 {
@@ -533,8 +732,18 @@ static int pipe_get_internal(k_spinlock_key_t key, struct k_pipe *pipe,
 	size_t         num_bytes_read = 0U;
 	size_t         bytes_copied;
 	size_t         bytes_can_read = 0U;
+	size_t         bytes_to_read;
 	bool           reschedule_needed = false;
 
+	/*
+	 * Do not use the pipe descriptor stored within k_thread if
+	 * invoked from within an ISR as that is not safe to do.
+	 */
+
+	dest_desc = k_is_in_isr() ? &isr_desc : &_current->pipe_desc;
+
+	bytes_to_read = pipe_desc_init(dest_desc, iov, iov_cnt);
+
 	/*
 	 * Data copying takes place in the following order.
 	 * 1. Copy data from the pipe buffer to the receive buffer.
@@ -568,15 +777,6 @@ static int pipe_get_internal(k_spinlock_key_t key, struct k_pipe *pipe,
 		return -EIO;
 	}
 
-	/*
-	 * Do not use the pipe descriptor stored within k_thread if
-	 * invoked from within an ISR as that is not safe to do.
-	 */
-
-	dest_desc = k_is_in_isr() ? &isr_desc : &_current->pipe_desc;
-
-	dest_desc->buffer = data;
-	dest_desc->bytes_to_xfer = bytes_to_read;
 	dest_desc->thread = _current;
 
 	src_desc = (struct _pipe_desc *)sys_dlist_get(&src_list);
@@ -596,6 +796,9 @@ static int pipe_get_internal(k_spinlock_key_t key, struct k_pipe *pipe,
 		}
 		dest_desc->bytes_to_xfer -= bytes_copied;
 
+		pipe_desc_next(dest_desc);
+		pipe_desc_next(src_desc);
+
 		if (src_desc->thread == NULL) {
 
 			/* Reading from the pipe buffer. Update details. */
@@ -614,32 +817,24 @@ static int pipe_get_internal(k_spinlock_key_t key, struct k_pipe *pipe,
 
 			reschedule_needed = true;
 		}
-		src_desc = (struct _pipe_desc *)sys_dlist_get(&src_list);
-	}
-
-	if (pipe->bytes_used != pipe->size) {
-		sys_dlist_t         pipe_list;
 
 		/*
-		 * The pipe is not full. If there are any waiting writers,
-		 * refill the pipe.
+		 * Stay on this source if it still has data for the next
+		 * segment of the destination.
 		 */
 
-		sys_dlist_init(&src_list);
-		sys_dlist_init(&pipe_list);
-
-		(void) pipe_waiter_list_populate(&src_list,
-						 &pipe->wait_q.writers,
-						 pipe->size - pipe->bytes_used);
+		if ((src_desc->bytes_to_xfer == 0U) ||
+		    (dest_desc->bytes_to_xfer == 0U)) {
+			src_desc = (struct _pipe_desc *)sys_dlist_get(&src_list);
+		}
+	}
 
-		(void) pipe_buffer_list_populate(&pipe_list, pipe_desc,
-						 pipe->buffer, pipe->size,
-						 pipe->write_index,
-						 pipe->read_index);
+	/*
+	 * The pipe is not full. If there are any waiting writers,
+	 * refill the pipe.
+	 */
 
-		(void) pipe_write(pipe, &src_list,
-				  &pipe_list, &reschedule_needed);
-	}
+	pipe_refill(pipe, &reschedule_needed);
 
 	/*
 	 * The immediate success conditions below are backwards
@@ -680,16 +875,18 @@ static int pipe_get_internal(k_spinlock_key_t key, struct k_pipe *pipe,
 	key = k_spin_lock(&pipe->lock);
 	k_spin_unlock(&pipe->lock, key);
 
-	*bytes_read = bytes_to_read - dest_desc->bytes_to_xfer;
+	size_t bytes_remaining = dest_desc->bytes_to_xfer + dest_desc->iov_bytes;
+
+	*bytes_read = bytes_to_read - bytes_remaining;
 
-	int ret = pipe_return_code(min_xfer, dest_desc->bytes_to_xfer,
-				   bytes_to_read);
+	int ret = pipe_return_code(min_xfer, bytes_remaining, bytes_to_read);
 
 	return ret;
 }
 
-int z_impl_k_pipe_get(struct k_pipe *pipe, void *data, size_t bytes_to_read,
-		     size_t *bytes_read, size_t min_xfer, k_timeout_t timeout)
+static int pipe_get(struct k_pipe *pipe, const struct k_pipe_iovec *iov,
+		    size_t iov_cnt, size_t bytes_to_read, size_t *bytes_read,
+		    size_t min_xfer, k_timeout_t timeout)
 {
 	__ASSERT(((arch_is_in_isr() == false) ||
 		  K_TIMEOUT_EQ(timeout, K_NO_WAIT)), "");
@@ -705,7 +902,17 @@ int z_impl_k_pipe_get(struct k_pipe *pipe, void *data, size_t bytes_to_read,
 
 	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
 
-	int ret = pipe_get_internal(key, pipe, data, bytes_to_read, bytes_read,
+	if ((pipe->flags & K_PIPE_FLAG_GET_CLAIM) != 0U) {
+		k_spin_unlock(&pipe->lock, key);
+		*bytes_read = 0U;
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_pipe, get, pipe,
+					       timeout, -EBUSY);
+
+		return -EBUSY;
+	}
+
+	int ret = pipe_get_internal(key, pipe, iov, iov_cnt, bytes_read,
 				    min_xfer, timeout);
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_pipe, get, pipe, timeout, ret);
@@ -713,6 +920,15 @@ int z_impl_k_pipe_get(struct k_pipe *pipe, void *data, size_t bytes_to_read,
 	return ret;
 }
 
+int z_impl_k_pipe_get(struct k_pipe *pipe, void *data, size_t bytes_to_read,
+		     size_t *bytes_read, size_t min_xfer, k_timeout_t timeout)
+{
+	struct k_pipe_iovec iov = { data, bytes_to_read };
+
+	return pipe_get(pipe, &iov, 1U, bytes_to_read, bytes_read, min_xfer,
+			timeout);
+}
+
 #ifdef CONFIG_USERSPACE
 int z_vrfy_k_pipe_get(struct k_pipe *pipe, void *data, size_t bytes_to_read,
 		      size_t *bytes_read, size_t min_xfer, k_timeout_t timeout)
@@ -728,6 +944,140 @@ int z_vrfy_k_pipe_get(struct k_pipe *pipe, void *data, size_t bytes_to_read,
 #include <syscalls/k_pipe_get_mrsh.c>
 #endif
 
+int k_pipe_put_iov(struct k_pipe *pipe, const struct k_pipe_iovec *iov,
+		   size_t iov_cnt, size_t *bytes_written, size_t min_xfer,
+		   k_timeout_t timeout)
+{
+	return pipe_put_internal(pipe, iov, iov_cnt, bytes_written, min_xfer,
+				 timeout);
+}
+
+int k_pipe_get_iov(struct k_pipe *pipe, const struct k_pipe_iovec *iov,
+		   size_t iov_cnt, size_t *bytes_read, size_t min_xfer,
+		   k_timeout_t timeout)
+{
+	size_t bytes_to_read = 0U;
+
+	for (size_t i = 0; i < iov_cnt; i++) {
+		bytes_to_read += iov[i].len;
+	}
+
+	return pipe_get(pipe, iov, iov_cnt, bytes_to_read, bytes_read,
+			min_xfer, timeout);
+}
+
+int k_pipe_put_claim(struct k_pipe *pipe, void **data, size_t max_bytes,
+		     size_t *bytes_claimed)
+{
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+
+	if ((pipe->flags & K_PIPE_FLAG_PUT_CLAIM) != 0U) {
+		k_spin_unlock(&pipe->lock, key);
+		return -EBUSY;
+	}
+
+	/* Waiting writers come first */
+	if (z_waitq_head(&pipe->wait_q.writers) != NULL) {
+		*bytes_claimed = 0U;
+	} else {
+		*bytes_claimed = MIN(pipe_space_contig(pipe), max_bytes);
+	}
+
+	if (*bytes_claimed != 0U) {
+		pipe->flags |= K_PIPE_FLAG_PUT_CLAIM;
+		*data = &pipe->buffer[pipe->write_index];
+	}
+
+	k_spin_unlock(&pipe->lock, key);
+
+	return 0;
+}
+
+int k_pipe_put_commit(struct k_pipe *pipe, size_t bytes)
+{
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+
+	CHECKIF(((pipe->flags & K_PIPE_FLAG_PUT_CLAIM) == 0U) ||
+		(bytes > pipe_space_contig(pipe))) {
+		k_spin_unlock(&pipe->lock, key);
+		return -EINVAL;
+	}
+
+	pipe->flags &= ~K_PIPE_FLAG_PUT_CLAIM;
+
+	pipe->bytes_used += bytes;
+	pipe->write_index += bytes;
+	if (pipe->write_index >= pipe->size) {
+		pipe->write_index -= pipe->size;
+	}
+
+	/* Readers only wait while the pipe buffer is empty */
+	bool reschedule_needed = pipe_feed_readers(pipe);
+
+	if (pipe->bytes_used != 0U) {
+		handle_poll_events(pipe);
+	}
+
+	if (reschedule_needed) {
+		z_reschedule(&pipe->lock, key);
+	} else {
+		k_spin_unlock(&pipe->lock, key);
+	}
+
+	return 0;
+}
+
+int k_pipe_get_claim(struct k_pipe *pipe, void **data, size_t max_bytes,
+		     size_t *bytes_claimed)
+{
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+
+	if ((pipe->flags & K_PIPE_FLAG_GET_CLAIM) != 0U) {
+		k_spin_unlock(&pipe->lock, key);
+		return -EBUSY;
+	}
+
+	*bytes_claimed = MIN(pipe_data_contig(pipe), max_bytes);
+	if (*bytes_claimed != 0U) {
+		pipe->flags |= K_PIPE_FLAG_GET_CLAIM;
+		*data = &pipe->buffer[pipe->read_index];
+	}
+
+	k_spin_unlock(&pipe->lock, key);
+
+	return 0;
+}
+
+int k_pipe_get_commit(struct k_pipe *pipe, size_t bytes)
+{
+	bool reschedule_needed = false;
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+
+	CHECKIF(((pipe->flags & K_PIPE_FLAG_GET_CLAIM) == 0U) ||
+		(bytes > pipe_data_contig(pipe))) {
+		k_spin_unlock(&pipe->lock, key);
+		return -EINVAL;
+	}
+
+	pipe->flags &= ~K_PIPE_FLAG_GET_CLAIM;
+
+	pipe->bytes_used -= bytes;
+	pipe->read_index += bytes;
+	if (pipe->read_index >= pipe->size) {
+		pipe->read_index -= pipe->size;
+	}
+
+	pipe_refill(pipe, &reschedule_needed);
+
+	if (reschedule_needed) {
+		z_reschedule(&pipe->lock, key);
+	} else {
+		k_spin_unlock(&pipe->lock, key);
+	}
+
+	return 0;
+}
+
 size_t z_impl_k_pipe_read_avail(struct k_pipe *pipe)
 {
 	size_t res;
@@ -23,6 +23,7 @@
 #include <zephyr/sys/dlist.h>
 #include <zephyr/sys/util.h>
 #include <zephyr/sys/__assert.h>
+#include <zephyr/sys/check.h>
 #include <stdbool.h>
 
 /* Single subsystem lock.  Locking per-event would be better on highly
@@ -34,10 +35,11 @@
  */
 static struct k_spinlock lock;
 
-enum POLL_MODE { MODE_NONE, MODE_POLL, MODE_TRIGGERED };
+enum POLL_MODE { MODE_NONE, MODE_POLL, MODE_TRIGGERED, MODE_SET };
 
 static int signal_poller(struct k_poll_event *event, uint32_t state);
 static int signal_triggered_work(struct k_poll_event *event, uint32_t status);
+static int signal_poll_set(struct k_poll_event *event, uint32_t state);
 
 void k_poll_event_init(struct k_poll_event *event, uint32_t type,
 		       int mode, void *obj)
@@ -108,22 +110,28 @@ static struct k_thread *poller_thread(struct z_poller *p)
 	return p ? CONTAINER_OF(p, struct k_thread, poller) : NULL;
 }
 
+/*
+ * Poll sets have no thread to take the priority from, their events are
+ * kept behind those of all other pollers.
+ */
 static inline void add_event(sys_dlist_t *events, struct k_poll_event *event,
 			     struct z_poller *poller)
 {
 	struct k_poll_event *pending;
 
 	pending = (struct k_poll_event *)sys_dlist_peek_tail(events);
-	if ((pending == NULL) ||
-		(z_sched_prio_cmp(poller_thread(pending->poller),
-							   poller_thread(poller)) > 0)) {
+	if ((pending == NULL) || (poller->mode == MODE_SET) ||
+		((pending->poller->mode != MODE_SET) &&
+		 (z_sched_prio_cmp(poller_thread(pending->poller),
+				   poller_thread(poller)) > 0))) {
 		sys_dlist_append(events, &event->_node);
 		return;
 	}
 
 	SYS_DLIST_FOR_EACH_CONTAINER(events, pending, _node) {
-		if (z_sched_prio_cmp(poller_thread(poller),
-					poller_thread(pending->poller)) > 0) {
+		if ((pending->poller->mode == MODE_SET) ||
+		    (z_sched_prio_cmp(poller_thread(poller),
+				      poller_thread(pending->poller)) > 0)) {
 			sys_dlist_insert(&pending->_node, &event->_node);
 			return;
 		}
@@ -446,6 +454,11 @@ static int signal_poll_event(struct k_poll_event *event, uint32_t state)
 	struct z_poller *poller = event->poller;
 	int retcode = 0;
 
+	if ((poller != NULL) && (poller->mode == MODE_SET)) {
+		/* Stays registered, nothing else to do */
+		return signal_poll_set(event, state);
+	}
+
 	if (poller != NULL) {
 		if (poller->mode == MODE_POLL) {
 			retcode = signal_poller(event, state);
@@ -567,6 +580,166 @@ static inline void z_vrfy_k_poll_signal_reset(struct k_poll_signal *sig)
 
 #endif
 
+/* Queue a member to the ready list, set lock must be held */
+static bool poll_set_ready(struct k_poll_set *set,
+			   struct k_poll_set_event *member, uint32_t state)
+{
+	/* Already queued: the waiter has not seen the previous state yet */
+	if (sys_dnode_is_linked(&member->_ready_node)) {
+		member->event.state |= state;
+		return false;
+	}
+
+	member->event.state = state;
+	sys_dlist_append(&set->ready, &member->_ready_node);
+
+	return z_sched_wake(&set->wait_q, 0, NULL);
+}
+
+static int signal_poll_set(struct k_poll_event *event, uint32_t state)
+{
+	struct k_poll_set *set = CONTAINER_OF(event->poller,
+					      struct k_poll_set, poller);
+	struct k_poll_set_event *member =
+		CONTAINER_OF(event, struct k_poll_set_event, event);
+	k_spinlock_key_t key;
+
+	/* The object took the event off its list to signal it, put it
+	 * back so that the next state change is signalled too.
+	 */
+	register_event(event, &set->poller);
+
+	key = k_spin_lock(&set->lock);
+	(void)poll_set_ready(set, member, state);
+	k_spin_unlock(&set->lock, key);
+
+	return 0;
+}
+
+void k_poll_set_init(struct k_poll_set *set)
+{
+	set->poller.is_polling = false;
+	set->poller.mode = MODE_SET;
+	sys_dlist_init(&set->ready);
+	z_waitq_init(&set->wait_q);
+}
+
+int k_poll_set_add(struct k_poll_set *set, struct k_poll_set_event *member)
+{
+	struct k_poll_event *event = &member->event;
+	k_spinlock_key_t key, set_key;
+	uint32_t state;
+	bool woken = false;
+
+	CHECKIF(event->type == K_POLL_TYPE_IGNORE) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&lock);
+
+	if (event->poller != NULL) {
+		k_spin_unlock(&lock, key);
+		return -EALREADY;
+	}
+
+	sys_dnode_init(&member->_ready_node);
+	event->state = K_POLL_STATE_NOT_READY;
+	register_event(event, &set->poller);
+
+	/* Only state changes are signalled, report what is already there */
+	if (is_condition_met(event, &state)) {
+		set_key = k_spin_lock(&set->lock);
+		woken = poll_set_ready(set, member, state);
+		k_spin_unlock(&set->lock, set_key);
+	}
+
+	if (woken) {
+		z_reschedule(&lock, key);
+	} else {
+		k_spin_unlock(&lock, key);
+	}
+
+	return 0;
+}
+
+int k_poll_set_remove(struct k_poll_set *set, struct k_poll_set_event *member)
+{
+	k_spinlock_key_t key, set_key;
+
+	key = k_spin_lock(&lock);
+
+	CHECKIF(member->event.poller != &set->poller) {
+		k_spin_unlock(&lock, key);
+		return -EINVAL;
+	}
+
+	clear_event_registration(&member->event);
+
+	set_key = k_spin_lock(&set->lock);
+	if (sys_dnode_is_linked(&member->_ready_node)) {
+		sys_dlist_remove(&member->_ready_node);
+	}
+	k_spin_unlock(&set->lock, set_key);
+
+	k_spin_unlock(&lock, key);
+
+	return 0;
+}
+
+int k_poll_set_wait(struct k_poll_set *set, struct k_poll_set_event **ready,
+		    int max_events, k_timeout_t timeout)
+{
+	k_spinlock_key_t key;
+	sys_dnode_t *node;
+	int64_t now, end = sys_clock_timeout_end_calc(timeout);
+	int num_ready = 0;
+
+	CHECKIF(max_events <= 0) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&set->lock);
+
+	/* Another waiter may have emptied the list before we ran */
+	while (sys_dlist_is_empty(&set->ready)) {
+		k_timeout_t left = timeout;
+
+		/* Only finite timeouts shrink; K_FOREVER must stay as is
+		 * rather than become a (possibly truncated) tick count.
+		 */
+		if (!K_TIMEOUT_EQ(timeout, K_FOREVER)) {
+			now = sys_clock_tick_get();
+			if ((end - now) <= 0) {
+				k_spin_unlock(&set->lock, key);
+				return -EAGAIN;
+			}
+			left = K_TICKS(end - now);
+		}
+
+		__ASSERT(!arch_is_in_isr(), "");
+
+		(void)z_pend_curr(&set->lock, key, &set->wait_q, left);
+		key = k_spin_lock(&set->lock);
+	}
+
+	while ((num_ready < max_events) &&
+	       ((node = sys_dlist_get(&set->ready)) != NULL)) {
+		struct k_poll_set_event *member =
+			CONTAINER_OF(node, struct k_poll_set_event, _ready_node);
+
+		/* The event state keeps changing with the object once
+		 * the lock is dropped, hand out a copy.
+		 */
+		member->state = member->event.state;
+		member->event.state = K_POLL_STATE_NOT_READY;
+		ready[num_ready++] = member;
+	}
+
+	k_spin_unlock(&set->lock, key);
+
+	return num_ready;
+}
+
 static void triggered_work_handler(struct k_work *work)
 {
 	struct k_work_poll *twork =
@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2023 Intel Corporation.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file @brief read-copy-update kernel services
+ *
+ * This is a two-phase, counter based ("sleepable") RCU.  Readers
+ * announce themselves in the counter of the current phase and never
+ * take a lock.  A grace period flips the phase, so that new readers
+ * count in the other counter, and waits for the counter of the old
+ * phase to drain.  Grace periods are serialized, which guarantees the
+ * counter a grace period flips to is empty at that point.
+ *
+ * A reader that read the phase just before a flip could still count
+ * itself in the old phase after the grace period has found it empty.
+ * To close that window a reader checks the phase again after counting
+ * itself and retries if it changed; since atomic operations are fully
+ * ordered, a reader that sees the unchanged phase is guaranteed to be
+ * seen by the grace period.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/kernel_structs.h>
+#include <zephyr/toolchain.h>
+#include <ksched.h>
+#include <zephyr/wait_q.h>
+#include <errno.h>
+#include <zephyr/syscall_handler.h>
+#include <zephyr/sys/check.h>
+
+int z_impl_k_rcu_init(struct k_rcu *rcu)
+{
+	atomic_set(&rcu->phase, 0);
+	atomic_set(&rcu->readers[0], 0);
+	atomic_set(&rcu->readers[1], 0);
+	atomic_set(&rcu->syncing, 0);
+
+	z_waitq_init(&rcu->wait_q);
+
+	z_object_init(rcu);
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_rcu_init(struct k_rcu *rcu)
+{
+	Z_OOPS(Z_SYSCALL_OBJ_INIT(rcu, K_OBJ_RCU));
+	return z_impl_k_rcu_init(rcu);
+}
+#include <syscalls/k_rcu_init_mrsh.c>
+#endif
+
+static void reader_exit(struct k_rcu *rcu, int phase)
+{
+	/* Only the last reader of a phase being waited for has work */
+	if ((atomic_dec(&rcu->readers[phase]) == 1) &&
+	    (atomic_get(&rcu->syncing) != 0)) {
+		k_spinlock_key_t key = k_spin_lock(&rcu->lock);
+
+		if (z_sched_wake_all(&rcu->wait_q, 0, NULL)) {
+			z_reschedule(&rcu->lock, key);
+		} else {
+			k_spin_unlock(&rcu->lock, key);
+		}
+	}
+}
+
+int z_impl_k_rcu_read_lock(struct k_rcu *rcu)
+{
+	int phase;
+
+	for (;;) {
+		phase = (int)atomic_get(&rcu->phase);
+		atomic_inc(&rcu->readers[phase]);
+
+		if (atomic_get(&rcu->phase) == phase) {
+			return phase;
+		}
+
+		/* Raced with a phase flip, count in the new phase */
+		reader_exit(rcu, phase);
+	}
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_rcu_read_lock(struct k_rcu *rcu)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(rcu, K_OBJ_RCU));
+	return z_impl_k_rcu_read_lock(rcu);
+}
+#include <syscalls/k_rcu_read_lock_mrsh.c>
+#endif
+
+int z_impl_k_rcu_read_unlock(struct k_rcu *rcu, int token)
+{
+	CHECKIF((token != 0) && (token != 1)) {
+		return -EINVAL;
+	}
+
+	reader_exit(rcu, token);
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_rcu_read_unlock(struct k_rcu *rcu, int token)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(rcu, K_OBJ_RCU));
+	Z_OOPS(Z_SYSCALL_VERIFY_MSG((token == 0) || (token == 1),
+				    "invalid RCU token %d", token));
+	Z_OOPS(Z_SYSCALL_VERIFY_MSG(atomic_get(&rcu->readers[token]) > 0,
+				    "RCU domain %p has no readers", rcu));
+	return z_impl_k_rcu_read_unlock(rcu, token);
+}
+#include <syscalls/k_rcu_read_unlock_mrsh.c>
+#endif
+
+int z_impl_k_rcu_synchronize(struct k_rcu *rcu)
+{
+	k_spinlock_key_t key;
+	int old;
+
+	__ASSERT(!arch_is_in_isr(), "RCU grace periods cannot be waited for in ISRs");
+
+	key = k_spin_lock(&rcu->lock);
+
+	/* One grace period at a time */
+	while (atomic_get(&rcu->syncing) != 0) {
+		(void)z_pend_curr(&rcu->lock, key, &rcu->wait_q, K_FOREVER);
+		key = k_spin_lock(&rcu->lock);
+	}
+
+	atomic_set(&rcu->syncing, 1);
+
+	old = (int)atomic_get(&rcu->phase);
+	atomic_set(&rcu->phase, old ^ 1);
+
+	while (atomic_get(&rcu->readers[old]) != 0) {
+		(void)z_pend_curr(&rcu->lock, key, &rcu->wait_q, K_FOREVER);
+		key = k_spin_lock(&rcu->lock);
+	}
+
+	atomic_set(&rcu->syncing, 0);
+
+	/* Let the next grace period start */
+	if (z_sched_wake_all(&rcu->wait_q, 0, NULL)) {
+		z_reschedule(&rcu->lock, key);
+	} else {
+		k_spin_unlock(&rcu->lock, key);
+	}
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_rcu_synchronize(struct k_rcu *rcu)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(rcu, K_OBJ_RCU));
+	return z_impl_k_rcu_synchronize(rcu);
+}
+#include <syscalls/k_rcu_synchronize_mrsh.c>
+#endif
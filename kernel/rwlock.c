@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2023 Intel Corporation.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file @brief reader-writer lock kernel services
+ *
+ * The lock is either free, held by any number of readers or held by a
+ * single writer.  It is writer-preferring: readers also wait while a
+ * writer is waiting.  Ownership is handed over directly to the woken
+ * threads under the object lock, so nobody can sneak in between the
+ * release and the waiter running.  A write unlock lets all waiting
+ * readers in before the next writer, which keeps the two sides
+ * alternating under contention.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/kernel_structs.h>
+#include <zephyr/toolchain.h>
+#include <ksched.h>
+#include <zephyr/wait_q.h>
+#include <errno.h>
+#include <zephyr/syscall_handler.h>
+#include <zephyr/sys/check.h>
+
+int z_impl_k_rwlock_init(struct k_rwlock *rwlock)
+{
+	rwlock->writer = NULL;
+	rwlock->readers = 0U;
+
+	z_waitq_init(&rwlock->readers_wait_q);
+	z_waitq_init(&rwlock->writers_wait_q);
+
+	z_object_init(rwlock);
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_rwlock_init(struct k_rwlock *rwlock)
+{
+	Z_OOPS(Z_SYSCALL_OBJ_INIT(rwlock, K_OBJ_RWLOCK));
+	return z_impl_k_rwlock_init(rwlock);
+}
+#include <syscalls/k_rwlock_init_mrsh.c>
+#endif
+
+/* Let all waiting readers in, lock must be held */
+static bool wake_readers(struct k_rwlock *rwlock)
+{
+	unsigned int woken = z_sched_wake_many(&rwlock->readers_wait_q,
+					       UINT_MAX, 0, NULL);
+
+	rwlock->readers += woken;
+
+	return woken != 0U;
+}
+
+/* Hand the free lock to the best waiting writer, lock must be held */
+static bool wake_writer(struct k_rwlock *rwlock)
+{
+	struct k_thread *writer = z_unpend_first_thread(&rwlock->writers_wait_q);
+
+	if (writer == NULL) {
+		return false;
+	}
+
+	rwlock->writer = writer;
+	arch_thread_return_value_set(writer, 0);
+	z_ready_thread(writer);
+
+	return true;
+}
+
+int z_impl_k_rwlock_read_lock(struct k_rwlock *rwlock, k_timeout_t timeout)
+{
+	k_spinlock_key_t key = k_spin_lock(&rwlock->lock);
+
+	if (likely((rwlock->writer == NULL) &&
+		   (z_waitq_head(&rwlock->writers_wait_q) == NULL))) {
+		rwlock->readers++;
+		k_spin_unlock(&rwlock->lock, key);
+		return 0;
+	}
+
+	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		k_spin_unlock(&rwlock->lock, key);
+		return -EBUSY;
+	}
+
+	__ASSERT(!arch_is_in_isr(), "rwlock cannot be waited for in ISRs");
+
+	/* Woken up holding the lock for reading, see wake_readers() */
+	return z_pend_curr(&rwlock->lock, key, &rwlock->readers_wait_q,
+			   timeout);
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_rwlock_read_lock(struct k_rwlock *rwlock,
+					    k_timeout_t timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(rwlock, K_OBJ_RWLOCK));
+	return z_impl_k_rwlock_read_lock(rwlock, timeout);
+}
+#include <syscalls/k_rwlock_read_lock_mrsh.c>
+#endif
+
+int z_impl_k_rwlock_read_unlock(struct k_rwlock *rwlock)
+{
+	k_spinlock_key_t key = k_spin_lock(&rwlock->lock);
+
+	CHECKIF((rwlock->writer != NULL) || (rwlock->readers == 0U)) {
+		k_spin_unlock(&rwlock->lock, key);
+		return -EINVAL;
+	}
+
+	rwlock->readers--;
+
+	/* Readers only wait behind writers, but one that timed out
+	 * may have left them stranded
+	 */
+	if ((rwlock->readers == 0U) &&
+	    (wake_writer(rwlock) || wake_readers(rwlock))) {
+		z_reschedule(&rwlock->lock, key);
+	} else {
+		k_spin_unlock(&rwlock->lock, key);
+	}
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_rwlock_read_unlock(struct k_rwlock *rwlock)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(rwlock, K_OBJ_RWLOCK));
+	return z_impl_k_rwlock_read_unlock(rwlock);
+}
+#include <syscalls/k_rwlock_read_unlock_mrsh.c>
+#endif
+
+int z_impl_k_rwlock_write_lock(struct k_rwlock *rwlock, k_timeout_t timeout)
+{
+	int ret;
+	k_spinlock_key_t key;
+
+	__ASSERT(!arch_is_in_isr(), "rwlock cannot be written from ISRs");
+
+	key = k_spin_lock(&rwlock->lock);
+
+	if (likely((rwlock->writer == NULL) && (rwlock->readers == 0U))) {
+		rwlock->writer = _current;
+		k_spin_unlock(&rwlock->lock, key);
+		return 0;
+	}
+
+	__ASSERT(rwlock->writer != _current, "rwlock write lock is not recursive");
+
+	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		k_spin_unlock(&rwlock->lock, key);
+		return -EBUSY;
+	}
+
+	/* Woken up holding the lock for writing, see wake_writer() */
+	ret = z_pend_curr(&rwlock->lock, key, &rwlock->writers_wait_q, timeout);
+	if (ret == 0) {
+		return 0;
+	}
+
+	/* Timed out: readers held back only by us can go now */
+	key = k_spin_lock(&rwlock->lock);
+
+	if ((rwlock->writer == NULL) &&
+	    (z_waitq_head(&rwlock->writers_wait_q) == NULL) &&
+	    wake_readers(rwlock)) {
+		z_reschedule(&rwlock->lock, key);
+	} else {
+		k_spin_unlock(&rwlock->lock, key);
+	}
+
+	return ret;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_rwlock_write_lock(struct k_rwlock *rwlock,
+					     k_timeout_t timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(rwlock, K_OBJ_RWLOCK));
+	return z_impl_k_rwlock_write_lock(rwlock, timeout);
+}
+#include <syscalls/k_rwlock_write_lock_mrsh.c>
+#endif
+
+int z_impl_k_rwlock_write_unlock(struct k_rwlock *rwlock)
+{
+	k_spinlock_key_t key = k_spin_lock(&rwlock->lock);
+
+	CHECKIF(rwlock->writer != _current) {
+		k_spin_unlock(&rwlock->lock, key);
+		return -EPERM;
+	}
+
+	rwlock->writer = NULL;
+
+	if (wake_readers(rwlock) || wake_writer(rwlock)) {
+		z_reschedule(&rwlock->lock, key);
+	} else {
+		k_spin_unlock(&rwlock->lock, key);
+	}
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_rwlock_write_unlock(struct k_rwlock *rwlock)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(rwlock, K_OBJ_RWLOCK));
+	return z_impl_k_rwlock_write_unlock(rwlock);
+}
+#include <syscalls/k_rwlock_write_unlock_mrsh.c>
+#endif
@@ -38,6 +38,9 @@ LOG_MODULE_DECLARE(os, CONFIG_KERNEL_LOG_LEVEL);
 #define _priq_run_add		z_priq_mq_add
 #define _priq_run_remove	z_priq_mq_remove
 #define _priq_run_best		z_priq_mq_best
+#endif
+
+#if defined(CONFIG_SCHED_MULTIQ) || defined(CONFIG_WAITQ_MULTIQ)
 static ALWAYS_INLINE void z_priq_mq_add(struct _priq_mq *pq,
 					struct k_thread *thread);
 static ALWAYS_INLINE void z_priq_mq_remove(struct _priq_mq *pq,
@@ -48,6 +51,10 @@ static ALWAYS_INLINE void z_priq_mq_remove(struct _priq_mq *pq,
 #define z_priq_wait_add		z_priq_rb_add
 #define _priq_wait_remove	z_priq_rb_remove
 #define _priq_wait_best		z_priq_rb_best
+#elif defined(CONFIG_WAITQ_MULTIQ)
+#define z_priq_wait_add		z_priq_mq_add
+#define _priq_wait_remove	z_priq_mq_remove
+#define _priq_wait_best		z_priq_mq_best
 #elif defined(CONFIG_WAITQ_DUMB)
 #define z_priq_wait_add		z_priq_dumb_add
 #define _priq_wait_remove	z_priq_dumb_remove
@@ -213,6 +220,8 @@ static ALWAYS_INLINE void *thread_runq(struct k_thread *thread)
 	cpu = m == 0 ? 0 : u32_count_trailing_zeros(m);
 
 	return &_kernel.cpus[cpu].ready_q.runq;
+#elif defined(CONFIG_SCHED_CPU_RUNQ_STEAL)
+	return &_kernel.cpus[thread->base.runq_cpu].ready_q.runq;
 #else
 	return &_kernel.ready_q.runq;
 #endif
@@ -220,26 +229,102 @@ static ALWAYS_INLINE void *thread_runq(struct k_thread *thread)
 
 static ALWAYS_INLINE void *curr_cpu_runq(void)
 {
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) || defined(CONFIG_SCHED_CPU_RUNQ_STEAL)
 	return &arch_curr_cpu()->ready_q.runq;
 #else
 	return &_kernel.ready_q.runq;
 #endif
 }
 
+#ifdef CONFIG_SCHED_CPU_RUNQ_STEAL
+/* Pick the run queue a thread is placed on when it becomes runnable:
+ * the CPU it last ran on, so it stays cache-warm, unless its mask no
+ * longer allows that CPU.  A thread that never ran goes to the CPU
+ * making it runnable.  As with PIN_ONLY, a thread with an empty mask
+ * is parked on CPU 0 where nobody will ever pick it.
+ */
+static ALWAYS_INLINE unsigned int runq_home_cpu(struct k_thread *thread)
+{
+	unsigned int cpu = thread->base.cpu;
+
+	if (cpu == Z_THREAD_CPU_NONE) {
+		cpu = _current_cpu->id;
+	}
+
+#ifdef CONFIG_SCHED_CPU_MASK
+	uint32_t m = thread->base.cpu_mask;
+
+	if ((m & BIT(cpu)) == 0U) {
+		cpu = m == 0U ? 0 : u32_count_trailing_zeros(m);
+	}
+#endif
+
+	return cpu;
+}
+
+BUILD_ASSERT(CONFIG_MP_MAX_NUM_CPUS <= 32, "Too many CPUs for run queue mask");
+
+/* Look at the best thread of every other non-empty run queue that
+ * this CPU may run, and take it over the local choice if it has
+ * strictly higher priority or if there is no local choice at all.
+ * Ties stay local, which is what keeps threads on their home CPU when
+ * the system is evenly loaded.  The winner is simply returned; the
+ * caller dequeues it from its owner's queue as usual.  This runs
+ * under sched_spinlock, which guards every queue, and costs one
+ * lookup per CPU with queued threads on each pick.
+ */
+static struct k_thread *runq_steal(struct k_thread *best)
+{
+	uint32_t others = _kernel.runq_cpus & ~BIT(_current_cpu->id);
+
+	while (others != 0U) {
+		unsigned int i = u32_count_trailing_zeros(others);
+		struct k_thread *t;
+
+		others &= others - 1U;
+
+		t = _priq_run_best(&_kernel.cpus[i].ready_q.runq);
+		if ((t != NULL) &&
+		    ((best == NULL) || (z_sched_prio_cmp(t, best) > 0))) {
+			best = t;
+		}
+	}
+
+	return best;
+}
+#endif
+
 static ALWAYS_INLINE void runq_add(struct k_thread *thread)
 {
+#ifdef CONFIG_SCHED_CPU_RUNQ_STEAL
+	unsigned int cpu = runq_home_cpu(thread);
+
+	thread->base.runq_cpu = cpu;
+	_kernel.cpus[cpu].runq_len++;
+	_kernel.runq_cpus |= BIT(cpu);
+#endif
 	_priq_run_add(thread_runq(thread), thread);
 }
 
 static ALWAYS_INLINE void runq_remove(struct k_thread *thread)
 {
 	_priq_run_remove(thread_runq(thread), thread);
+#ifdef CONFIG_SCHED_CPU_RUNQ_STEAL
+	unsigned int cpu = thread->base.runq_cpu;
+
+	if (--_kernel.cpus[cpu].runq_len == 0U) {
+		_kernel.runq_cpus &= ~BIT(cpu);
+	}
+#endif
 }
 
 static ALWAYS_INLINE struct k_thread *runq_best(void)
 {
+#ifdef CONFIG_SCHED_CPU_RUNQ_STEAL
+	return runq_steal(_priq_run_best(curr_cpu_runq()));
+#else
 	return _priq_run_best(curr_cpu_runq());
+#endif
 }
 
 /* _current is never in the run queue until context switch on
@@ -601,7 +686,10 @@ static bool thread_active_elsewhere(struct k_thread *thread)
 	return false;
 }
 
-static void ready_thread(struct k_thread *thread)
+/* Put a ready thread in the run queue without making any scheduling
+ * decision, returns true if it was added.
+ */
+static bool queue_ready_thread(struct k_thread *thread)
 {
 #ifdef CONFIG_KERNEL_COHERENCE
 	__ASSERT_NO_MSG(arch_mem_coherent(thread));
@@ -614,6 +702,15 @@ static void ready_thread(struct k_thread *thread)
 		SYS_PORT_TRACING_OBJ_FUNC(k_thread, sched_ready, thread);
 
 		queue_thread(thread);
+		return true;
+	}
+
+	return false;
+}
+
+static void ready_thread(struct k_thread *thread)
+{
+	if (queue_ready_thread(thread)) {
 		update_cache(0);
 		flag_ipi();
 	}
@@ -924,6 +1021,16 @@ bool z_set_prio(struct k_thread *thread, int prio)
 				thread->base.prio = prio;
 			}
 			update_cache(1);
+		} else if (IS_ENABLED(CONFIG_WAITQ_MULTIQ) &&
+			   z_is_thread_pending(thread)) {
+			/* The multiqueue files pended threads by priority,
+			 * so move it to the list of its new level
+			 */
+			_wait_q_t *wait_q = pended_on_thread(thread);
+
+			_priq_wait_remove(&wait_q->waitq, thread);
+			thread->base.prio = prio;
+			z_priq_wait_add(&wait_q->waitq, thread);
 		} else {
 			thread->base.prio = prio;
 		}
@@ -1099,6 +1206,7 @@ void *z_get_next_switch_handle(void *interrupted)
 			arch_cohere_stacks(old_thread, interrupted, new_thread);
 
 			_current_cpu->swap_ok = 0;
+			new_thread->base.cpu = arch_curr_cpu()->id;
 			set_current(new_thread);
 
 #ifdef CONFIG_TIMESLICING
@@ -1225,7 +1333,7 @@ struct k_thread *z_priq_rb_best(struct _priq_rb *pq)
 	return thread;
 }
 
-#ifdef CONFIG_SCHED_MULTIQ
+#if defined(CONFIG_SCHED_MULTIQ) || defined(CONFIG_WAITQ_MULTIQ)
 # if (K_LOWEST_THREAD_PRIO - K_HIGHEST_THREAD_PRIO) > 31
 # error Too many priorities for multiqueue scheduler (max 32)
 # endif
@@ -1235,6 +1343,13 @@ static ALWAYS_INLINE void z_priq_mq_add(struct _priq_mq *pq,
 {
 	int priority_bit = thread->base.prio - K_HIGHEST_THREAD_PRIO;
 
+	/* Lists of empty levels are not kept initialized, which lets
+	 * wait queues be statically initialized to all zeroes
+	 */
+	if ((pq->bitmask & BIT(priority_bit)) == 0U) {
+		sys_dlist_init(&pq->queues[priority_bit]);
+	}
+
 	sys_dlist_append(&pq->queues[priority_bit], &thread->base.qnode_dlist);
 	pq->bitmask |= BIT(priority_bit);
 }
@@ -1267,6 +1382,25 @@ struct k_thread *z_priq_mq_best(struct _priq_mq *pq)
 	return thread;
 }
 
+/* Thread queued after @thread in priority order, or NULL */
+struct k_thread *z_priq_mq_next(struct _priq_mq *pq, struct k_thread *thread)
+{
+	int priority_bit = thread->base.prio - K_HIGHEST_THREAD_PRIO;
+	sys_dnode_t *n = sys_dlist_peek_next(&pq->queues[priority_bit],
+					     &thread->base.qnode_dlist);
+
+	if (n == NULL) {
+		/* First thread of the next non-empty, lower priority level */
+		unsigned int lower = pq->bitmask & ((~0U << priority_bit) << 1);
+
+		if (lower != 0U) {
+			n = sys_dlist_peek_head(&pq->queues[__builtin_ctz(lower)]);
+		}
+	}
+
+	return (n != NULL) ? CONTAINER_OF(n, struct k_thread, base.qnode_dlist) : NULL;
+}
+
 int z_unpend_all(_wait_q_t *wait_q)
 {
 	int need_sched = 0;
@@ -1290,7 +1424,7 @@ void init_ready_q(struct _ready_q *rq)
 		}
 	};
 #elif defined(CONFIG_SCHED_MULTIQ)
-	for (int i = 0; i < ARRAY_SIZE(_kernel.ready_q.runq.queues); i++) {
+	for (int i = 0; i < ARRAY_SIZE(rq->runq.queues); i++) {
 		sys_dlist_init(&rq->runq.queues[i]);
 	}
 #else
@@ -1300,7 +1434,7 @@ void init_ready_q(struct _ready_q *rq)
 
 void z_sched_init(void)
 {
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) || defined(CONFIG_SCHED_CPU_RUNQ_STEAL)
 	for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
 		init_ready_q(&_kernel.cpus[i].ready_q);
 	}
@@ -1635,6 +1769,24 @@ static int cpu_mask_mod(k_tid_t thread, uint32_t enable_mask, uint32_t disable_m
 		}
 	}
 
+#ifdef CONFIG_TIMEOUT_PER_CPU
+	/* Keep a pending thread's timeout on a CPU it may run on.  A
+	 * thread pending itself arms its timeout on the CPU it runs on,
+	 * which its mask allows, so only a mask change can move it away.
+	 * Mask bits above the last CPU are ignored.
+	 */
+	if (ret == 0) {
+		uint32_t mask = thread->base.cpu_mask &
+				BIT_MASK(CONFIG_MP_MAX_NUM_CPUS);
+
+		if ((mask != 0U) &&
+		    ((mask & BIT(thread->base.timeout.cpu)) == 0U)) {
+			z_timeout_migrate(&thread->base.timeout,
+					  u32_count_trailing_zeros(mask));
+		}
+	}
+#endif
+
 #if defined(CONFIG_ASSERT) && defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY)
 		int m = thread->base.cpu_mask;
 
@@ -1887,25 +2039,41 @@ static inline void z_vrfy_k_thread_abort(k_tid_t thread)
  * future scheduler.h API implementations
  */
 bool z_sched_wake(_wait_q_t *wait_q, int swap_retval, void *swap_data)
+{
+	return z_sched_wake_many(wait_q, 1U, swap_retval, swap_data) != 0U;
+}
+
+unsigned int z_sched_wake_many(_wait_q_t *wait_q, unsigned int max,
+			       int swap_retval, void *swap_data)
 {
 	struct k_thread *thread;
-	bool ret = false;
+	unsigned int woken = 0U;
+	bool queued = false;
 
 	LOCKED(&sched_spinlock) {
-		thread = _priq_wait_best(&wait_q->waitq);
+		while (woken < max) {
+			thread = _priq_wait_best(&wait_q->waitq);
+			if (thread == NULL) {
+				break;
+			}
 
-		if (thread != NULL) {
 			z_thread_return_value_set_with_data(thread,
 							    swap_retval,
 							    swap_data);
 			unpend_thread_no_timeout(thread);
 			(void)z_abort_thread_timeout(thread);
-			ready_thread(thread);
-			ret = true;
+			queued = queue_ready_thread(thread) || queued;
+			woken++;
+		}
+
+		/* One scheduling decision and IPI for the whole batch */
+		if (queued) {
+			update_cache(0);
+			flag_ipi();
 		}
 	}
 
-	return ret;
+	return woken;
 }
 
 int z_sched_wait(struct k_spinlock *lock, k_spinlock_key_t key,
@@ -19,6 +19,15 @@ static K_KERNEL_STACK_DEFINE(sys_work_q_stack,
 
 struct k_work_q k_sys_work_q;
 
+#if defined(CONFIG_WORKQUEUE_POOL) && (CONFIG_SYSTEM_WORKQUEUE_WORKERS > 1)
+#define SYS_WORK_Q_EXTRA_WORKERS (CONFIG_SYSTEM_WORKQUEUE_WORKERS - 1)
+
+static K_KERNEL_STACK_ARRAY_DEFINE(sys_work_q_worker_stacks,
+				   SYS_WORK_Q_EXTRA_WORKERS,
+				   CONFIG_SYSTEM_WORKQUEUE_STACK_SIZE);
+static struct k_work_q_worker sys_work_q_workers[SYS_WORK_Q_EXTRA_WORKERS];
+#endif
+
 static int k_sys_work_q_init(void)
 {
 	struct k_work_queue_config cfg = {
@@ -30,6 +39,15 @@ static int k_sys_work_q_init(void)
 			    sys_work_q_stack,
 			    K_KERNEL_STACK_SIZEOF(sys_work_q_stack),
 			    CONFIG_SYSTEM_WORKQUEUE_PRIORITY, &cfg);
+
+#if defined(CONFIG_WORKQUEUE_POOL) && (CONFIG_SYSTEM_WORKQUEUE_WORKERS > 1)
+	for (int i = 0; i < SYS_WORK_Q_EXTRA_WORKERS; i++) {
+		k_work_queue_add_worker(&k_sys_work_q, &sys_work_q_workers[i],
+					sys_work_q_worker_stacks[i],
+					K_KERNEL_STACK_SIZEOF(sys_work_q_worker_stacks[i]));
+	}
+#endif
+
 	return 0;
 }
 
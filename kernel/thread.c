@@ -542,6 +542,9 @@ char *z_setup_new_thread(struct k_thread *new_thread,
 	z_object_init(new_thread);
 	z_object_init(stack);
 	new_thread->stack_obj = stack;
+#ifdef CONFIG_USERSPACE_OBJ_CACHE
+	new_thread->obj_cache.gen = 0U;
+#endif
 	new_thread->syscall_frame = NULL;
 
 	/* Any given thread has access to itself */
@@ -807,6 +810,10 @@ void z_init_thread_base(struct _thread_base *thread_base, int priority,
 	thread_base->is_idle = 0;
 #endif
 
+#ifdef CONFIG_SCHED_CPU_RUNQ_STEAL
+	thread_base->cpu = Z_THREAD_CPU_NONE;
+#endif
+
 #ifdef CONFIG_TIMESLICE_PER_THREAD
 	thread_base->slice_ticks = 0;
 	thread_base->slice_expired = NULL;
@@ -11,10 +11,95 @@
 #include <zephyr/syscall_handler.h>
 #include <zephyr/drivers/timer/system_timer.h>
 #include <zephyr/sys_clock.h>
+#include <zephyr/app_memory/app_memdomain.h>
 
 static uint64_t curr_tick;
 
+#ifdef CONFIG_USERSPACE_TIME_PAGE
+#ifndef K_MEM_PARTITION_P_RW_U_RO
+#error "CONFIG_USERSPACE_TIME_PAGE needs a partition read-only for user mode"
+#endif
+
+/* Lives in its own partition, which user threads of every memory
+ * domain can read but not write, see z_uptime_ticks()
+ */
+K_APP_DMEM(z_time_partition) struct z_time_page z_time_page;
+
+/* Publish curr_tick, timeout_lock must be held */
+static void time_page_update(void)
+{
+	/* Odd while the update is in progress */
+	uint32_t seq = z_time_page.seq | 1U;
+
+	__atomic_store_n(&z_time_page.seq, seq, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+	z_time_page.ticks = curr_tick;
+	__atomic_store_n(&z_time_page.seq, seq + 1U, __ATOMIC_RELEASE);
+}
+#else
+static inline void time_page_update(void)
+{
+}
+#endif
+
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+/* Hierarchical timing wheel.  Each level has WHEEL_SLOTS lists and
+ * covers WHEEL_BITS bits of the absolute expiry tick, which is stored
+ * in the dticks field of the timeout.  A timeout lives at the level
+ * of the most significant digit in which its expiry differs from the
+ * wheel's base tick, so all entries at a given level share the upper
+ * digits of the base and lie strictly ahead of it.  Level zero slots
+ * therefore hold entries with an exact expiry, while entries at higher
+ * levels are "cascaded" down when time reaches the start of their
+ * slot.  Anything beyond the top level goes to an overflow list
+ * (tracked as the single slot of an extra level) that is rehashed
+ * each time the top level wraps.  Per-level bitmaps of the non-empty
+ * slots make finding the next event, adding and removing all
+ * O(WHEEL_LEVELS) regardless of the number of timeouts.
+ */
+#define WHEEL_BITS 6
+#define WHEEL_SLOTS BIT(WHEEL_BITS)
+#define WHEEL_MASK (WHEEL_SLOTS - 1)
+#define WHEEL_LEVELS CONFIG_TIMEOUT_WHEEL_LEVELS
+
+BUILD_ASSERT(WHEEL_SLOTS <= 64, "pending bitmaps are 64 bits wide");
+BUILD_ASSERT(WHEEL_BITS * WHEEL_LEVELS < 64, "wheel span exceeds tick range");
+
+struct timeout_wheel {
+#ifdef CONFIG_TIMEOUT_PER_CPU
+	struct k_spinlock lock;
+#endif
+	/* Tick the wheel contents are placed relative to.  It moves
+	 * when the wheel is serviced, and is brought up to the current
+	 * tick by announcements and insertions whenever nothing in the
+	 * wheel is due by then.
+	 */
+	uint64_t tick;
+	/* Slot lists are only valid when their pending bit is set, so
+	 * they need no static initialization.
+	 */
+	uint64_t pending[WHEEL_LEVELS + 1];
+	sys_dlist_t slots[WHEEL_LEVELS][WHEEL_SLOTS];
+	sys_dlist_t overflow;
+};
+
+#ifdef CONFIG_TIMEOUT_PER_CPU
+/* Each CPU arms timeouts in its own wheel under its own lock, so
+ * z_add_timeout()/z_abort_timeout() don't contend across CPUs.
+ * timeout_lock then only serializes sys_clock_announce() and timer
+ * programming, and readers of the tick count use tick_seq instead.
+ */
+#define NUM_WHEELS CONFIG_MP_MAX_NUM_CPUS
+
+static atomic_t tick_seq;
+#else
+#define NUM_WHEELS 1
+#endif
+
+static struct timeout_wheel wheels[NUM_WHEELS];
+#else
 static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
+#endif
 
 static struct k_spinlock timeout_lock;
 
@@ -36,6 +121,245 @@ static inline int z_vrfy_sys_clock_hw_cycles_per_sec_runtime_get(void)
 #endif /* CONFIG_USERSPACE */
 #endif /* CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME */
 
+#ifdef CONFIG_TIMEOUT_PER_CPU
+/* curr_tick and announce_remaining may only change inside a
+ * tick_update_begin()/tick_update_end() pair, with timeout_lock held.
+ */
+static inline void tick_update_begin(void)
+{
+	atomic_inc(&tick_seq);
+}
+
+static inline void tick_update_end(void)
+{
+	atomic_inc(&tick_seq);
+}
+#else
+static inline void tick_update_begin(void)
+{
+}
+
+static inline void tick_update_end(void)
+{
+}
+#endif
+
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+static inline unsigned int wheel_digit(uint64_t tick, int level)
+{
+	return (tick >> (level * WHEEL_BITS)) & WHEEL_MASK;
+}
+
+/* Level at which a timeout expiring at tick "expiry" lives, relative
+ * to the wheel base.  Returns WHEEL_LEVELS for the overflow list.
+ */
+static int wheel_level(struct timeout_wheel *w, uint64_t expiry)
+{
+	uint64_t diff = MAX(expiry, w->tick) ^ w->tick;
+
+	if (diff == 0U) {
+		return 0;
+	}
+
+	return MIN((63 - __builtin_clzll(diff)) / WHEEL_BITS, WHEEL_LEVELS);
+}
+
+static unsigned int wheel_index(struct timeout_wheel *w, int level,
+				uint64_t expiry)
+{
+	return level == WHEEL_LEVELS ? 0
+		: wheel_digit(MAX(expiry, w->tick), level);
+}
+
+static sys_dlist_t *wheel_list(struct timeout_wheel *w, int level,
+			       unsigned int idx)
+{
+	return level == WHEEL_LEVELS ? &w->overflow : &w->slots[level][idx];
+}
+
+static void wheel_add(struct timeout_wheel *w, struct _timeout *to)
+{
+	int level = wheel_level(w, to->dticks);
+	unsigned int idx = wheel_index(w, level, to->dticks);
+	sys_dlist_t *list = wheel_list(w, level, idx);
+
+	if ((w->pending[level] & BIT64(idx)) == 0U) {
+		sys_dlist_init(list);
+		w->pending[level] |= BIT64(idx);
+	}
+
+	sys_dlist_append(list, &to->node);
+}
+
+static void wheel_remove(struct timeout_wheel *w, struct _timeout *to)
+{
+	int level = wheel_level(w, to->dticks);
+	unsigned int idx = wheel_index(w, level, to->dticks);
+
+	sys_dlist_remove(&to->node);
+
+	if (sys_dlist_is_empty(wheel_list(w, level, idx))) {
+		w->pending[level] &= ~BIT64(idx);
+	}
+}
+
+/* Finds the next tick at or after the wheel base at which the wheel
+ * needs service: either the exact expiry of a level zero entry, or the
+ * start of a higher level slot that must be cascaded.  Entries at
+ * lower levels always precede those at higher ones, so the first
+ * non-empty level wins.
+ */
+static bool wheel_next_event(struct timeout_wheel *w, uint64_t *when,
+			     int *level)
+{
+	for (int l = 0; l < WHEEL_LEVELS; l++) {
+		unsigned int shift = l * WHEEL_BITS;
+		unsigned int digit = wheel_digit(w->tick, l);
+		uint64_t ahead = (l == 0) ? (~0ULL << digit)
+			: ((~0ULL << digit) << 1);
+		uint64_t bits = w->pending[l] & ahead;
+
+		if (bits != 0U) {
+			uint64_t span = BIT64(shift + WHEEL_BITS);
+
+			*when = (w->tick & ~(span - 1U)) |
+				((uint64_t)__builtin_ctzll(bits) << shift);
+			*level = l;
+			return true;
+		}
+	}
+
+	if (w->pending[WHEEL_LEVELS] != 0U) {
+		uint64_t span = BIT64(WHEEL_LEVELS * WHEEL_BITS);
+
+		*when = (w->tick | (span - 1U)) + 1U;
+		*level = WHEEL_LEVELS;
+		return true;
+	}
+
+	return false;
+}
+
+/* Moves the wheel base to "when", which must be the wheel's next
+ * event at "level".  Higher level slots (and the overflow list) are
+ * redistributed, with every entry landing at a strictly lower level,
+ * and NULL is returned.  For level zero the first expired timeout is
+ * removed and returned.
+ */
+static struct _timeout *wheel_service(struct timeout_wheel *w,
+				      uint64_t when, int level)
+{
+	unsigned int idx = wheel_index(w, level, when);
+	sys_dlist_t *list = wheel_list(w, level, idx);
+	sys_dlist_t tmp;
+	sys_dnode_t *node;
+
+	w->tick = when;
+
+	if (level == 0) {
+		struct _timeout *t = CONTAINER_OF(sys_dlist_peek_head(list),
+						  struct _timeout, node);
+
+		wheel_remove(w, t);
+		return t;
+	}
+
+	sys_dlist_init(&tmp);
+	while ((node = sys_dlist_get(list)) != NULL) {
+		sys_dlist_append(&tmp, node);
+	}
+	w->pending[level] &= ~BIT64(idx);
+
+	while ((node = sys_dlist_get(&tmp)) != NULL) {
+		wheel_add(w, CONTAINER_OF(node, struct _timeout, node));
+	}
+
+	return NULL;
+}
+
+/* Moves the wheel base up to "now" if the wheel needs no service
+ * until after it.  No slot start is crossed then, so every entry keeps
+ * its level and slot.  Otherwise timeouts armed after a long idle
+ * period would be placed relative to a stale base and cascade down
+ * through levels for time that has already passed.
+ */
+static void wheel_advance(struct timeout_wheel *w, uint64_t now)
+{
+	uint64_t when;
+	int level;
+
+	if ((now > w->tick) &&
+	    (!wheel_next_event(w, &when, &level) || (when > now))) {
+		w->tick = now;
+	}
+}
+
+#ifdef CONFIG_TIMEOUT_PER_CPU
+static inline struct timeout_wheel *timeout_wheel(const struct _timeout *t)
+{
+	return &wheels[t->cpu];
+}
+
+static inline k_spinlock_key_t wheel_lock(struct timeout_wheel *w)
+{
+	return k_spin_lock(&w->lock);
+}
+
+static inline void wheel_unlock(struct timeout_wheel *w, k_spinlock_key_t key)
+{
+	k_spin_unlock(&w->lock, key);
+}
+#else
+/* The single wheel is protected by timeout_lock itself */
+static inline struct timeout_wheel *timeout_wheel(const struct _timeout *t)
+{
+	ARG_UNUSED(t);
+
+	return &wheels[0];
+}
+
+static inline k_spinlock_key_t wheel_lock(struct timeout_wheel *w)
+{
+	ARG_UNUSED(w);
+
+	return (k_spinlock_key_t) { 0 };
+}
+
+static inline void wheel_unlock(struct timeout_wheel *w, k_spinlock_key_t key)
+{
+	ARG_UNUSED(w);
+	ARG_UNUSED(key);
+}
+#endif
+
+/* Earliest event over all wheels, must be called with timeout_lock */
+static struct timeout_wheel *next_event(uint64_t *when)
+{
+	struct timeout_wheel *next = NULL;
+
+	*when = UINT64_MAX;
+	for (int i = 0; i < NUM_WHEELS; i++) {
+		k_spinlock_key_t key = wheel_lock(&wheels[i]);
+		uint64_t ev;
+		int level;
+
+		if (wheel_next_event(&wheels[i], &ev, &level) && (ev < *when)) {
+			*when = ev;
+			next = &wheels[i];
+		}
+		wheel_unlock(&wheels[i], key);
+	}
+
+	return next;
+}
+
+#ifndef CONFIG_TIMEOUT_PER_CPU
+static void remove_timeout(struct _timeout *t)
+{
+	wheel_remove(timeout_wheel(t), t);
+}
+#endif
+#else
 static struct _timeout *first(void)
 {
 	sys_dnode_t *t = sys_dlist_peek_head(&timeout_list);
@@ -58,17 +382,47 @@ static void remove_timeout(struct _timeout *t)
 
 	sys_dlist_remove(&t->node);
 }
+#endif /* CONFIG_TIMEOUT_QUEUE_WHEEL */
 
 static int32_t elapsed(void)
 {
 	return announce_remaining == 0 ? sys_clock_elapsed() : 0U;
 }
 
+#ifdef CONFIG_TIMEOUT_PER_CPU
+/* Lock-free equivalent of reading curr_tick + elapsed() under
+ * timeout_lock, retried if an announcement updates them meanwhile.
+ */
+static uint64_t tick_now(void)
+{
+	atomic_val_t seq;
+	uint64_t t;
+
+	do {
+		seq = atomic_get(&tick_seq);
+		t = curr_tick + elapsed();
+	} while (((seq & 1) != 0) || (seq != atomic_get(&tick_seq)));
+
+	return t;
+}
+#endif
+
 static int32_t next_timeout(void)
 {
-	struct _timeout *to = first();
 	int32_t ticks_elapsed = elapsed();
 	int32_t ret;
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+	uint64_t when;
+
+	if ((next_event(&when) == NULL) ||
+	    ((int64_t)(when - curr_tick - ticks_elapsed) > (int64_t)INT_MAX)) {
+		ret = MAX_WAIT;
+	} else {
+		/* A wheel event may lag curr_tick on SMP, see below */
+		ret = MAX(0, (int64_t)(when - curr_tick) - ticks_elapsed);
+	}
+#else
+	struct _timeout *to = first();
 
 	if ((to == NULL) ||
 	    ((int64_t)(to->dticks - ticks_elapsed) > (int64_t)INT_MAX)) {
@@ -76,10 +430,189 @@ static int32_t next_timeout(void)
 	} else {
 		ret = MAX(0, to->dticks - ticks_elapsed);
 	}
+#endif
+
+	return ret;
+}
+
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+static uint64_t timeout_expiry(k_timeout_t timeout, uint64_t now)
+{
+	if (Z_TICK_ABS(timeout.ticks) >= 0) {
+		return MAX(now + 1, (uint64_t)Z_TICK_ABS(timeout.ticks));
+	}
+
+	return now + timeout.ticks + 1;
+}
+
+/* Adds a timeout to a wheel, returning true if that made the next
+ * event of the wheel earlier so the timer needs reprogramming.
+ */
+static bool wheel_insert(struct timeout_wheel *w, struct _timeout *to)
+{
+	uint64_t prev, when;
+	int level;
+
+	if (!wheel_next_event(w, &prev, &level)) {
+		prev = UINT64_MAX;
+	}
+
+	wheel_add(w, to);
+
+	return wheel_next_event(w, &when, &level) && (when < prev);
+}
+#endif
+
+#ifdef CONFIG_TIMEOUT_PER_CPU
+void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
+		   k_timeout_t timeout)
+{
+	if (K_TIMEOUT_EQ(timeout, K_FOREVER)) {
+		return;
+	}
+
+#ifdef CONFIG_KERNEL_COHERENCE
+	__ASSERT_NO_MSG(arch_mem_coherent(to));
+#endif
+
+	__ASSERT(!sys_dnode_is_linked(&to->node), "");
+	to->fn = fn;
+
+	/* Any wheel is correct, the local one just avoids sharing it.
+	 * The expiry may end up behind the base of a wheel that was
+	 * serviced concurrently; it then fires at the next announcement.
+	 */
+	unsigned int cpu = arch_curr_cpu()->id;
+	struct timeout_wheel *w = &wheels[cpu];
+	uint64_t now = tick_now();
+	bool reprogram;
+
+	to->dticks = timeout_expiry(timeout, now);
+
+	LOCKED(&w->lock) {
+		to->cpu = cpu;
+		wheel_advance(w, now);
+		reprogram = wheel_insert(w, to);
+	}
+
+	if (reprogram) {
+		LOCKED(&timeout_lock) {
+			sys_clock_set_timeout(next_timeout(), false);
+		}
+	}
+}
+
+int z_abort_timeout(struct _timeout *to)
+{
+	struct timeout_wheel *w;
+	k_spinlock_key_t key;
+	int ret = -EINVAL;
+
+	/* The owning CPU only changes under the wheel lock */
+	for (;;) {
+		w = timeout_wheel(to);
+		key = wheel_lock(w);
+		if (w == timeout_wheel(to)) {
+			break;
+		}
+		wheel_unlock(w, key);
+	}
+
+	if (sys_dnode_is_linked(&to->node)) {
+		wheel_remove(w, to);
+		ret = 0;
+	}
+
+	wheel_unlock(w, key);
 
 	return ret;
 }
 
+void z_timeout_migrate(struct _timeout *to, int cpu)
+{
+	struct timeout_wheel *dst;
+	struct timeout_wheel *src;
+	unsigned int key;
+	bool reprogram = false;
+
+	__ASSERT((cpu >= 0) && (cpu < NUM_WHEELS),
+		 "invalid CPU %d", cpu);
+	dst = &wheels[cpu];
+
+	/* Nest the two wheel locks in index order */
+	key = arch_irq_lock();
+	for (;;) {
+		src = timeout_wheel(to);
+		if (src == dst) {
+			arch_irq_unlock(key);
+			return;
+		}
+
+		k_spin_lock(src < dst ? &src->lock : &dst->lock);
+		k_spin_lock(src < dst ? &dst->lock : &src->lock);
+		if (src == timeout_wheel(to)) {
+			break;
+		}
+		k_spin_release(&src->lock);
+		k_spin_release(&dst->lock);
+	}
+
+	if (sys_dnode_is_linked(&to->node)) {
+		wheel_remove(src, to);
+		to->cpu = cpu;
+		reprogram = wheel_insert(dst, to);
+	} else {
+		to->cpu = cpu;
+	}
+
+	k_spin_release(&src->lock);
+	k_spin_release(&dst->lock);
+	arch_irq_unlock(key);
+
+	if (reprogram) {
+		LOCKED(&timeout_lock) {
+			sys_clock_set_timeout(next_timeout(), false);
+		}
+	}
+}
+
+/* Reads the expiry of an armed timeout, returns false if inactive */
+static bool timeout_expiry_get(const struct _timeout *timeout,
+			       uint64_t *expiry)
+{
+	struct timeout_wheel *w = timeout_wheel(timeout);
+	bool active = false;
+
+	LOCKED(&w->lock) {
+		active = !z_is_inactive_timeout(timeout);
+		*expiry = timeout->dticks;
+	}
+
+	return active;
+}
+
+k_ticks_t z_timeout_remaining(const struct _timeout *timeout)
+{
+	uint64_t expiry;
+
+	if (!timeout_expiry_get(timeout, &expiry)) {
+		return 0;
+	}
+
+	return expiry - tick_now();
+}
+
+k_ticks_t z_timeout_expires(const struct _timeout *timeout)
+{
+	uint64_t expiry;
+
+	if (!timeout_expiry_get(timeout, &expiry)) {
+		return tick_now();
+	}
+
+	return expiry;
+}
+#else
 void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 		   k_timeout_t timeout)
 {
@@ -95,6 +628,16 @@ void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 	to->fn = fn;
 
 	LOCKED(&timeout_lock) {
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+		uint64_t now = curr_tick + elapsed();
+
+		to->dticks = timeout_expiry(timeout, now);
+		wheel_advance(&wheels[0], now);
+
+		if (wheel_insert(&wheels[0], to)) {
+			sys_clock_set_timeout(next_timeout(), false);
+		}
+#else
 		struct _timeout *t;
 
 		if (IS_ENABLED(CONFIG_TIMEOUT_64BIT) &&
@@ -122,6 +665,7 @@ void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 		if (to == first()) {
 			sys_clock_set_timeout(next_timeout(), false);
 		}
+#endif
 	}
 }
 
@@ -148,12 +692,16 @@ static k_ticks_t timeout_rem(const struct _timeout *timeout)
 		return 0;
 	}
 
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+	ticks = timeout->dticks - curr_tick;
+#else
 	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
 		ticks += t->dticks;
 		if (timeout == t) {
 			break;
 		}
 	}
+#endif
 
 	return ticks - elapsed();
 }
@@ -179,6 +727,7 @@ k_ticks_t z_timeout_expires(const struct _timeout *timeout)
 
 	return ticks;
 }
+#endif /* CONFIG_TIMEOUT_PER_CPU */
 
 int32_t z_get_next_timeout_expiry(void)
 {
@@ -201,13 +750,59 @@ void sys_clock_announce(int32_t ticks)
 	 * and return.
 	 */
 	if (IS_ENABLED(CONFIG_SMP) && (announce_remaining != 0)) {
+		tick_update_begin();
 		announce_remaining += ticks;
+		tick_update_end();
 		k_spin_unlock(&timeout_lock, key);
 		return;
 	}
 
+	tick_update_begin();
 	announce_remaining = ticks;
+	tick_update_end();
+
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+	struct timeout_wheel *w;
+	uint64_t next;
+
+	/* Service the wheels in global expiry order.  With per-CPU
+	 * wheels another CPU may add an earlier event between finding
+	 * and servicing the next one, in which case just look again.
+	 * Such an event may even be slightly behind curr_tick, if it
+	 * raced with an announcement; it is then handled immediately.
+	 */
+	while (((w = next_event(&next)) != NULL) &&
+	       (next <= curr_tick + announce_remaining)) {
+		k_spinlock_key_t wkey = wheel_lock(w);
+		struct _timeout *t = NULL;
+		uint64_t when;
+		int level;
+		int dt;
+
+		if (!wheel_next_event(w, &when, &level) || (when != next)) {
+			wheel_unlock(w, wkey);
+			continue;
+		}
+
+		dt = (when > curr_tick) ? (int)(when - curr_tick) : 0;
+		tick_update_begin();
+		curr_tick += dt;
+		tick_update_end();
 
+		t = wheel_service(w, when, level);
+		wheel_unlock(w, wkey);
+
+		if (t != NULL) {
+			k_spin_unlock(&timeout_lock, key);
+			t->fn(t);
+			key = k_spin_lock(&timeout_lock);
+		}
+
+		tick_update_begin();
+		announce_remaining -= dt;
+		tick_update_end();
+	}
+#else
 	struct _timeout *t = first();
 
 	for (t = first();
@@ -228,9 +823,22 @@ void sys_clock_announce(int32_t ticks)
 	if (t != NULL) {
 		t->dticks -= announce_remaining;
 	}
+#endif
 
+	tick_update_begin();
 	curr_tick += announce_remaining;
 	announce_remaining = 0;
+	tick_update_end();
+	time_page_update();
+
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+	for (int i = 0; i < NUM_WHEELS; i++) {
+		k_spinlock_key_t wkey = wheel_lock(&wheels[i]);
+
+		wheel_advance(&wheels[i], curr_tick);
+		wheel_unlock(&wheels[i], wkey);
+	}
+#endif
 
 	sys_clock_set_timeout(next_timeout(), false);
 
@@ -245,9 +853,13 @@ int64_t sys_clock_tick_get(void)
 {
 	uint64_t t = 0U;
 
+#ifdef CONFIG_TIMEOUT_PER_CPU
+	t = tick_now();
+#else
 	LOCKED(&timeout_lock) {
 		t = curr_tick + elapsed();
 	}
+#endif
 	return t;
 }
 
@@ -340,7 +952,54 @@ uint64_t sys_clock_timeout_end_calc(k_timeout_t timeout)
 #ifdef CONFIG_ZTEST
 void z_impl_sys_clock_tick_set(uint64_t tick)
 {
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+	/* Expiries are absolute, so shift them to keep the remaining
+	 * time of pending timeouts unchanged, as with the delta list.
+	 */
+	LOCKED(&timeout_lock) {
+		for (int i = 0; i < NUM_WHEELS; i++) {
+			struct timeout_wheel *w = &wheels[i];
+			k_spinlock_key_t key = wheel_lock(w);
+			sys_dlist_t tmp;
+			sys_dnode_t *node;
+
+			sys_dlist_init(&tmp);
+			for (int l = 0; l <= WHEEL_LEVELS; l++) {
+				for (int j = 0; j < WHEEL_SLOTS; j++) {
+					if ((w->pending[l] & BIT64(j)) == 0U) {
+						continue;
+					}
+
+					while ((node = sys_dlist_get(wheel_list(w, l, j)))
+					       != NULL) {
+						sys_dlist_append(&tmp, node);
+					}
+				}
+				w->pending[l] = 0U;
+			}
+
+			w->tick = tick;
+			while ((node = sys_dlist_get(&tmp)) != NULL) {
+				struct _timeout *t = CONTAINER_OF(node, struct _timeout, node);
+
+				t->dticks += tick - curr_tick;
+				wheel_add(w, t);
+			}
+
+			wheel_unlock(w, key);
+		}
+
+		tick_update_begin();
+		curr_tick = tick;
+		tick_update_end();
+		time_page_update();
+
+		sys_clock_set_timeout(next_timeout(), false);
+	}
+#else
 	curr_tick = tick;
+	time_page_update();
+#endif
 }
 
 void z_vrfy_sys_clock_tick_set(uint64_t tick)
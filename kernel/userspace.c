@@ -27,6 +27,10 @@
 K_APPMEM_PARTITION_DEFINE(z_libc_partition);
 #endif
 
+#ifdef CONFIG_USERSPACE_TIME_PAGE
+K_APPMEM_PARTITION_DEFINE(z_time_partition);
+#endif
+
 /* TODO: Find a better place to put this. Since we pull the entire
  * lib..__modules__crypto__mbedtls.a  globals into app shared memory
  * section, we can't put this in zephyr_init.c of the mbedtls module.
@@ -110,6 +114,61 @@ uint8_t *z_priv_stack_find(k_thread_stack_t *stack)
 }
 #endif /* CONFIG_GEN_PRIV_STACKS */
 
+#ifdef CONFIG_USERSPACE_OBJ_CACHE
+BUILD_ASSERT(IS_POWER_OF_TWO(CONFIG_USERSPACE_OBJ_CACHE_SIZE),
+	     "CONFIG_USERSPACE_OBJ_CACHE_SIZE must be a power of two");
+
+/* Bumped whenever object metadata is freed, which invalidates the
+ * object caches of all threads. Starts at 1 so that the zeroed cache
+ * of a new thread is never valid.
+ */
+static atomic_t obj_cache_gen = ATOMIC_INIT(1);
+
+static inline void obj_cache_invalidate(void)
+{
+	atomic_inc(&obj_cache_gen);
+}
+
+struct z_object *z_object_find_cached(const void *obj)
+{
+	struct _thread_obj_cache *cache;
+	struct z_object *ko;
+	uint32_t gen;
+	unsigned int idx;
+
+	if (arch_is_in_isr() || (_current == NULL)) {
+		return z_object_find(obj);
+	}
+
+	cache = &_current->obj_cache;
+	gen = (uint32_t)atomic_get(&obj_cache_gen);
+	idx = ((uintptr_t)obj / sizeof(void *)) &
+	      (CONFIG_USERSPACE_OBJ_CACHE_SIZE - 1U);
+
+	if (cache->gen != gen) {
+		(void)memset(cache->obj, 0, sizeof(cache->obj));
+		cache->gen = gen;
+	} else if ((cache->obj[idx] == obj) && (obj != NULL)) {
+		return cache->ko[idx];
+	}
+
+	/* Only hits are cached, the metadata of an object that is not
+	 * found yet may still be allocated
+	 */
+	ko = z_object_find(obj);
+	if (ko != NULL) {
+		cache->obj[idx] = obj;
+		cache->ko[idx] = ko;
+	}
+
+	return ko;
+}
+#else
+static inline void obj_cache_invalidate(void)
+{
+}
+#endif /* CONFIG_USERSPACE_OBJ_CACHE */
+
 #ifdef CONFIG_DYNAMIC_OBJECTS
 
 /*
@@ -404,6 +463,8 @@ void k_object_free(void *obj)
 		if (dyn->kobj.type == K_OBJ_THREAD) {
 			thread_idx_free(dyn->kobj.data.thread_id);
 		}
+
+		obj_cache_invalidate();
 	}
 	k_spin_unlock(&objfree_lock, key);
 
@@ -462,6 +523,19 @@ static unsigned int thread_index_get(struct k_thread *thread)
 	return ko->data.thread_id;
 }
 
+static unsigned int current_index_get(void)
+{
+	struct z_object *ko;
+
+	ko = z_object_find_cached(_current);
+
+	if (ko == NULL) {
+		return -1;
+	}
+
+	return ko->data.thread_id;
+}
+
 static void unref_check(struct z_object *ko, uintptr_t index)
 {
 	k_spinlock_key_t key = k_spin_lock(&obj_lock);
@@ -510,6 +584,7 @@ static void unref_check(struct z_object *ko, uintptr_t index)
 
 	rb_remove(&obj_rb_tree, &dyn->node);
 	sys_dlist_remove(&dyn->dobj_list);
+	obj_cache_invalidate();
 	k_free(dyn);
 out:
 #endif
@@ -582,7 +657,7 @@ static int thread_perms_test(struct z_object *ko)
 		return 1;
 	}
 
-	index = thread_index_get(_current);
+	index = current_index_get();
 	if (index != -1) {
 		return sys_bitfield_test_bit((mem_addr_t)&ko->perms, index);
 	}
@@ -77,6 +77,228 @@ static inline void init_flusher(struct z_work_flusher *flusher)
 	k_work_init(&flusher->work, handle_flush);
 }
 
+/* Work queue pools.
+ *
+ * Every worker of a queue has its own list of pending items: the queue
+ * thread works queue->pending, additional workers their own list.  An
+ * item that is running always belongs to the worker running it, so
+ * re-submission and flushers go to that worker's list, which keeps an
+ * item from running twice at once and flushers behind the item they
+ * wait for.  Everything else may be taken by any worker.
+ *
+ * Without CONFIG_WORKQUEUE_POOL the queue thread is the only worker and
+ * these reduce to the single queue->pending list.
+ */
+
+/* Get the pending list of the calling thread if it's one of the queue's
+ * workers, NULL otherwise.
+ *
+ * Invoked with work lock held.
+ */
+static inline sys_slist_t *current_pending_locked(struct k_work_q *queue)
+{
+	if (k_is_in_isr()) {
+		return NULL;
+	}
+
+	if (_current == &queue->thread) {
+		return &queue->pending;
+	}
+
+#ifdef CONFIG_WORKQUEUE_POOL
+	struct k_work_q_worker *worker;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&queue->workers, worker, node) {
+		if (_current == &worker->thread) {
+			return &worker->pending;
+		}
+	}
+#endif
+
+	return NULL;
+}
+
+/* Get the pending list of the worker running a work item.
+ *
+ * Invoked with work lock held.
+ */
+static inline sys_slist_t *running_pending_locked(struct k_work_q *queue,
+						  struct k_work *work)
+{
+#ifdef CONFIG_WORKQUEUE_POOL
+	struct k_work_q_worker *worker;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&queue->workers, worker, node) {
+		if (worker->running == work) {
+			return &worker->pending;
+		}
+	}
+#endif
+
+	return &queue->pending;
+}
+
+/* Get the pending list a work item is queued on, or NULL.
+ *
+ * Invoked with work lock held.
+ */
+static sys_slist_t *queued_pending_locked(struct k_work_q *queue,
+					  struct k_work *work)
+{
+	struct k_work *wn;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&queue->pending, wn, node) {
+		if (wn == work) {
+			return &queue->pending;
+		}
+	}
+
+#ifdef CONFIG_WORKQUEUE_POOL
+	struct k_work_q_worker *worker;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&queue->workers, worker, node) {
+		SYS_SLIST_FOR_EACH_CONTAINER(&worker->pending, wn, node) {
+			if (wn == work) {
+				return &worker->pending;
+			}
+		}
+	}
+#endif
+
+	return NULL;
+}
+
+/* Test whether no work is pending on any worker of a queue.
+ *
+ * Invoked with work lock held.
+ */
+static inline bool queue_empty_locked(struct k_work_q *queue)
+{
+#ifdef CONFIG_WORKQUEUE_POOL
+	struct k_work_q_worker *worker;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&queue->workers, worker, node) {
+		if (!sys_slist_is_empty(&worker->pending)) {
+			return false;
+		}
+	}
+#endif
+
+	return sys_slist_is_empty(&queue->pending);
+}
+
+#ifdef CONFIG_WORKQUEUE_POOL
+/* Test whether any worker of a queue is running an item.
+ *
+ * Invoked with work lock held.
+ */
+static bool queue_running_locked(struct k_work_q *queue)
+{
+	struct k_work_q_worker *worker;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&queue->workers, worker, node) {
+		if (worker->running != NULL) {
+			return true;
+		}
+	}
+
+	return queue->running != NULL;
+}
+
+/* Take the first item of another worker's pending list, unless it has
+ * to stay with that worker: a flusher, an item a flusher waits behind,
+ * or an item that was re-submitted while it is still running.
+ *
+ * Invoked with work lock held.
+ */
+static sys_snode_t *steal_locked(sys_slist_t *pending)
+{
+	sys_snode_t *node = sys_slist_peek_head(pending);
+	sys_snode_t *next;
+	struct k_work *work;
+
+	if (node == NULL) {
+		return NULL;
+	}
+
+	work = CONTAINER_OF(node, struct k_work, node);
+	next = sys_slist_peek_next(node);
+
+	if ((work->handler == handle_flush) ||
+	    flag_test(&work->flags, K_WORK_RUNNING_BIT) ||
+	    ((next != NULL) &&
+	     (CONTAINER_OF(next, struct k_work, node)->handler == handle_flush))) {
+		return NULL;
+	}
+
+	return sys_slist_get(pending);
+}
+
+/* Find an item for an idle worker on the lists of the other workers.
+ *
+ * Invoked with work lock held.
+ */
+static sys_snode_t *queue_steal_locked(struct k_work_q *queue,
+				       sys_slist_t *own)
+{
+	struct k_work_q_worker *worker;
+	sys_snode_t *stolen = NULL;
+
+	if (own != &queue->pending) {
+		stolen = steal_locked(&queue->pending);
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&queue->workers, worker, node) {
+		if (stolen != NULL) {
+			break;
+		}
+
+		if (own != &worker->pending) {
+			stolen = steal_locked(&worker->pending);
+		}
+	}
+
+	return stolen;
+}
+#endif /* CONFIG_WORKQUEUE_POOL */
+
+/* Pick the pending list a new submission goes to.
+ *
+ * Invoked with work lock held.
+ */
+static inline sys_slist_t *submit_pending_locked(struct k_work_q *queue,
+						 struct k_work *work)
+{
+#ifdef CONFIG_WORKQUEUE_POOL
+	struct k_work_q_worker *worker;
+	sys_slist_t *pending;
+
+	/* Rerun by the same worker so it can't overlap itself */
+	if (flag_test(&work->flags, K_WORK_RUNNING_BIT)) {
+		return running_pending_locked(queue, work);
+	}
+
+	/* Chained work stays with the worker submitting it */
+	pending = current_pending_locked(queue);
+	if (pending != NULL) {
+		return pending;
+	}
+
+	/* Anything else is spread over the workers round robin */
+	worker = queue->next_worker;
+	if (worker == NULL) {
+		queue->next_worker = SYS_SLIST_PEEK_HEAD_CONTAINER(&queue->workers,
+								   worker, node);
+		return &queue->pending;
+	}
+
+	queue->next_worker = SYS_SLIST_PEEK_NEXT_CONTAINER(worker, node);
+	return &worker->pending;
+#else
+	return &queue->pending;
+#endif
+}
+
 /* List of pending cancellations. */
 static sys_slist_t pending_cancels;
 
@@ -172,23 +394,17 @@ static void queue_flusher_locked(struct k_work_q *queue,
 				 struct k_work *work,
 				 struct z_work_flusher *flusher)
 {
-	bool in_list = false;
-	struct k_work *wn;
-
 	/* Determine whether the work item is still queued. */
-	SYS_SLIST_FOR_EACH_CONTAINER(&queue->pending, wn, node) {
-		if (wn == work) {
-			in_list = true;
-			break;
-		}
-	}
+	sys_slist_t *pending = queued_pending_locked(queue, work);
 
 	init_flusher(flusher);
-	if (in_list) {
-		sys_slist_insert(&queue->pending, &work->node,
+	if (pending != NULL) {
+		sys_slist_insert(pending, &work->node,
 				 &flusher->work.node);
 	} else {
-		sys_slist_prepend(&queue->pending, &flusher->work.node);
+		/* Running: flush right after it on the same worker */
+		sys_slist_prepend(running_pending_locked(queue, work),
+				  &flusher->work.node);
 	}
 }
 
@@ -203,7 +419,15 @@ static inline void queue_remove_locked(struct k_work_q *queue,
 				       struct k_work *work)
 {
 	if (flag_test_and_clear(&work->flags, K_WORK_QUEUED_BIT)) {
+#ifdef CONFIG_WORKQUEUE_POOL
+		sys_slist_t *pending = queued_pending_locked(queue, work);
+
+		if (pending != NULL) {
+			(void)sys_slist_find_and_remove(pending, &work->node);
+		}
+#else
 		(void)sys_slist_find_and_remove(&queue->pending, &work->node);
+#endif
 	}
 }
 
@@ -213,6 +437,11 @@ static inline void queue_remove_locked(struct k_work_q *queue,
  * will not be a reschedule point.  Callers should yield after the lock is
  * released where appropriate (generally if this returns true).
  *
+ * In a pool all workers sleep on the queue's notifyq.  Work may have
+ * been put on the list of a particular worker, which may be the only one
+ * allowed to take it (see steal_locked()), so every idle worker is woken
+ * to look at its own list and for something to steal.
+ *
  * @param queue to be notified.  If this is null no notification is required.
  *
  * @return true if and only if the queue was notified and woken, i.e. a
@@ -223,7 +452,11 @@ static inline bool notify_queue_locked(struct k_work_q *queue)
 	bool rv = false;
 
 	if (queue != NULL) {
+#ifdef CONFIG_WORKQUEUE_POOL
+		rv = z_sched_wake_all(&queue->notifyq, 0, NULL);
+#else
 		rv = z_sched_wake(&queue->notifyq, 0, NULL);
+#endif
 	}
 
 	return rv;
@@ -256,7 +489,7 @@ static inline int queue_submit_locked(struct k_work_q *queue,
 	}
 
 	int ret = -EBUSY;
-	bool chained = (_current == &queue->thread) && !k_is_in_isr();
+	bool chained = (current_pending_locked(queue) != NULL);
 	bool draining = flag_test(&queue->flags, K_WORK_QUEUE_DRAIN_BIT);
 	bool plugged = flag_test(&queue->flags, K_WORK_QUEUE_PLUGGED_BIT);
 
@@ -274,7 +507,8 @@ static inline int queue_submit_locked(struct k_work_q *queue,
 	} else if (plugged && !draining) {
 		ret = -EBUSY;
 	} else {
-		sys_slist_append(&queue->pending, &work->node);
+		sys_slist_append(submit_pending_locked(queue, work),
+				 &work->node);
 		ret = 1;
 		(void)notify_queue_locked(queue);
 	}
@@ -595,10 +829,25 @@ bool k_work_cancel_sync(struct k_work *work,
 /* Loop executed by a work queue thread.
  *
  * @param workq_ptr pointer to the work queue structure
+ * @param worker_ptr pointer to the k_work_q_worker structure, or NULL for
+ * the queue thread
  */
-static void work_queue_main(void *workq_ptr, void *p2, void *p3)
+static void work_queue_main(void *workq_ptr, void *worker_ptr, void *p3)
 {
 	struct k_work_q *queue = (struct k_work_q *)workq_ptr;
+	sys_slist_t *pending = &queue->pending;
+
+#ifdef CONFIG_WORKQUEUE_POOL
+	struct k_work_q_worker *worker = worker_ptr;
+	struct k_work **running = &queue->running;
+
+	if (worker != NULL) {
+		pending = &worker->pending;
+		running = &worker->running;
+	}
+#else
+	ARG_UNUSED(worker_ptr);
+#endif
 
 	while (true) {
 		sys_snode_t *node;
@@ -608,7 +857,12 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 		bool yield;
 
 		/* Check for and prepare any new work. */
-		node = sys_slist_get(&queue->pending);
+		node = sys_slist_get(pending);
+#ifdef CONFIG_WORKQUEUE_POOL
+		if (node == NULL) {
+			node = queue_steal_locked(queue, pending);
+		}
+#endif
 		if (node != NULL) {
 			/* Mark that there's some work active that's
 			 * not on the pending list.
@@ -631,12 +885,20 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 			 * This means that if node is not NULL, then work will not be NULL.
 			 */
 			handler = work->handler;
-		} else if (flag_test_and_clear(&queue->flags,
+#ifdef CONFIG_WORKQUEUE_POOL
+			*running = work;
+#endif
+		} else if (!flag_test(&queue->flags, K_WORK_QUEUE_BUSY_BIT) &&
+			   queue_empty_locked(queue) &&
+			   flag_test_and_clear(&queue->flags,
 					       K_WORK_QUEUE_DRAIN_BIT)) {
-			/* Not busy and draining: move threads waiting for
-			 * drain to ready state.  The held spinlock inhibits
-			 * immediate reschedule; released threads get their
-			 * chance when this invokes z_sched_wait() below.
+			/* Not busy, nothing pending and draining: move
+			 * threads waiting for drain to ready state.  In a
+			 * pool, other workers may still hold items this one
+			 * can't steal, the last one to empty its list releases
+			 * the waiters.  The held spinlock inhibits immediate
+			 * reschedule; released threads get their chance when
+			 * this invokes z_sched_wait() below.
 			 *
 			 * We don't touch K_WORK_QUEUE_PLUGGABLE, so getting
 			 * here doesn't mean that the queue will allow new
@@ -679,7 +941,15 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 			finalize_cancel_locked(work);
 		}
 
+#ifdef CONFIG_WORKQUEUE_POOL
+		/* Busy until the last worker is done */
+		*running = NULL;
+		if (!queue_running_locked(queue)) {
+			flag_clear(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
+		}
+#else
 		flag_clear(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
+#endif
 		yield = !flag_test(&queue->flags, K_WORK_QUEUE_NO_YIELD_BIT);
 		k_spin_unlock(&lock, key);
 
@@ -720,6 +990,12 @@ void k_work_queue_start(struct k_work_q *queue,
 	z_waitq_init(&queue->notifyq);
 	z_waitq_init(&queue->drainq);
 
+#ifdef CONFIG_WORKQUEUE_POOL
+	queue->running = NULL;
+	sys_slist_init(&queue->workers);
+	queue->next_worker = NULL;
+#endif
+
 	if ((cfg != NULL) && cfg->no_yield) {
 		flags |= K_WORK_QUEUE_NO_YIELD;
 	}
@@ -743,6 +1019,38 @@ void k_work_queue_start(struct k_work_q *queue,
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work_queue, start, queue);
 }
 
+#ifdef CONFIG_WORKQUEUE_POOL
+void k_work_queue_add_worker(struct k_work_q *queue,
+			     struct k_work_q_worker *worker,
+			     k_thread_stack_t *stack,
+			     size_t stack_size)
+{
+	__ASSERT_NO_MSG(queue);
+	__ASSERT_NO_MSG(worker);
+	__ASSERT_NO_MSG(stack);
+	__ASSERT_NO_MSG(flag_test(&queue->flags, K_WORK_QUEUE_STARTED_BIT));
+
+	sys_slist_init(&worker->pending);
+	worker->running = NULL;
+
+	(void)k_thread_create(&worker->thread, stack, stack_size,
+			      work_queue_main, queue, worker, NULL,
+			      queue->thread.base.prio, 0, K_FOREVER);
+
+#ifdef CONFIG_THREAD_NAME
+	k_thread_name_set(&worker->thread, k_thread_name_get(&queue->thread));
+#endif
+
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	sys_slist_append(&queue->workers, &worker->node);
+
+	k_spin_unlock(&lock, key);
+
+	k_thread_start(&worker->thread);
+}
+#endif /* CONFIG_WORKQUEUE_POOL */
+
 int k_work_queue_drain(struct k_work_q *queue,
 		       bool plug)
 {
@@ -757,7 +1065,7 @@ int k_work_queue_drain(struct k_work_q *queue,
 	if (((flags_get(&queue->flags)
 	      & (K_WORK_QUEUE_BUSY | K_WORK_QUEUE_DRAIN)) != 0U)
 	    || plug
-	    || !sys_slist_is_empty(&queue->pending)) {
+	    || !queue_empty_locked(queue)) {
 		flag_set(&queue->flags, K_WORK_QUEUE_DRAIN_BIT);
 		if (plug) {
 			flag_set(&queue->flags, K_WORK_QUEUE_PLUGGED_BIT);
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/sys/condvar.h>
+
+#ifdef CONFIG_USERSPACE
+/* Waiters sleep on the sequence number they saw before releasing the mutex,
+ * so that a signal sent between the release and the wait is not lost: the
+ * sequence number changed and k_futex_wait() returns at once.
+ */
+static void seq_bump(atomic_t *val)
+{
+	atomic_val_t old_value;
+
+	/* Futex values are compared as int */
+	do {
+		old_value = atomic_get(val);
+	} while (!atomic_cas(val, old_value, (old_value + 1) & INT_MAX));
+}
+
+int sys_condvar_init(struct sys_condvar *condvar)
+{
+	atomic_set(&condvar->futex.val, 0);
+	atomic_set(&condvar->waiters, 0);
+
+	return 0;
+}
+
+int sys_condvar_signal(struct sys_condvar *condvar)
+{
+	int ret;
+
+	seq_bump(&condvar->futex.val);
+
+	if (atomic_get(&condvar->waiters) == 0) {
+		return 0;
+	}
+
+	ret = k_futex_wake(&condvar->futex, false);
+
+	return ret < 0 ? ret : 0;
+}
+
+int sys_condvar_broadcast(struct sys_condvar *condvar)
+{
+	seq_bump(&condvar->futex.val);
+
+	if (atomic_get(&condvar->waiters) == 0) {
+		return 0;
+	}
+
+	return k_futex_wake(&condvar->futex, true);
+}
+
+int sys_condvar_wait(struct sys_condvar *condvar, struct sys_mutex *mutex,
+		     k_timeout_t timeout)
+{
+	atomic_val_t seq;
+	int ret, lock_ret;
+
+	atomic_inc(&condvar->waiters);
+	seq = atomic_get(&condvar->futex.val);
+
+	ret = sys_mutex_unlock(mutex);
+	if (ret != 0) {
+		atomic_dec(&condvar->waiters);
+		return ret;
+	}
+
+	ret = k_futex_wait(&condvar->futex, (int)seq, timeout);
+	atomic_dec(&condvar->waiters);
+
+	if (ret == -ETIMEDOUT) {
+		ret = -EAGAIN;
+	} else if (ret == -EAGAIN) {
+		/* Signaled before we got to sleep */
+		ret = 0;
+	} else {
+		;
+	}
+
+	lock_ret = sys_mutex_lock(mutex, K_FOREVER);
+
+	return lock_ret != 0 ? lock_ret : ret;
+}
+#else
+int sys_condvar_init(struct sys_condvar *condvar)
+{
+	return k_condvar_init(&condvar->kernel_condvar);
+}
+
+int sys_condvar_signal(struct sys_condvar *condvar)
+{
+	return k_condvar_signal(&condvar->kernel_condvar);
+}
+
+int sys_condvar_broadcast(struct sys_condvar *condvar)
+{
+	return k_condvar_broadcast(&condvar->kernel_condvar);
+}
+
+int sys_condvar_wait(struct sys_condvar *condvar, struct sys_mutex *mutex,
+		     k_timeout_t timeout)
+{
+	return k_condvar_wait(&condvar->kernel_condvar, &mutex->kernel_mutex,
+			      timeout);
+}
+#endif
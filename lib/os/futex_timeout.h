@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef ZEPHYR_LIB_OS_FUTEX_TIMEOUT_H_
+#define ZEPHYR_LIB_OS_FUTEX_TIMEOUT_H_
+
+/*
+ * Timeout bookkeeping for the futex based locks, which may retry
+ * k_futex_wait() several times for a single lock call. This runs in user
+ * mode, so time comes from k_uptime_ticks() rather than the timeout code.
+ */
+
+#include <zephyr/kernel.h>
+
+/* Start of a wait, only looked at for relative timeouts */
+static inline int64_t z_futex_wait_start(k_timeout_t timeout)
+{
+	if (K_TIMEOUT_EQ(timeout, K_FOREVER) ||
+	    K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		return 0;
+	}
+
+	return k_uptime_ticks();
+}
+
+/* What is left of @a timeout since @a start, K_NO_WAIT once it expired */
+static inline k_timeout_t z_futex_wait_left(k_timeout_t timeout, int64_t start)
+{
+	int64_t left;
+
+	if (K_TIMEOUT_EQ(timeout, K_FOREVER) ||
+	    K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		return timeout;
+	}
+
+#ifdef CONFIG_TIMEOUT_64BIT
+	/* Absolute timeouts are deadlines already */
+	if (Z_TICK_ABS(timeout.ticks) >= 0) {
+		return timeout;
+	}
+#endif
+
+	left = (int64_t)timeout.ticks - (k_uptime_ticks() - start);
+
+	return (left > 0) ? K_TICKS(left) : K_NO_WAIT;
+}
+
+#endif /* ZEPHYR_LIB_OS_FUTEX_TIMEOUT_H_ */
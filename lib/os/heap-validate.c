@@ -56,7 +56,7 @@ static inline void check_nexts(struct z_heap *h, int bidx)
 {
 	struct z_heap_bucket *b = &h->buckets[bidx];
 
-	bool emptybit = (h->avail_buckets & BIT(bidx)) == 0;
+	bool emptybit = !bucket_avail(h, bidx);
 	bool emptylist = b->next == 0;
 	bool empties_match = emptybit == emptylist;
 
@@ -83,6 +83,14 @@ static void get_alloc_info(struct z_heap *h, size_t *alloc_bytes,
 			*free_bytes += chunksz_to_bytes(h, chunk_size(h, c));
 		}
 	}
+
+#ifdef CONFIG_SYS_HEAP_CACHE
+	/* Chunks parked in the per-CPU magazines are free for the user */
+	size_t cached = heap_cache_info(h, NULL, NULL);
+
+	*alloc_bytes -= cached;
+	*free_bytes += cached;
+#endif
 }
 
 bool sys_heap_validate(struct sys_heap *heap)
@@ -138,7 +146,7 @@ bool sys_heap_validate(struct sys_heap *heap)
 			set_chunk_used(h, c, true);
 		}
 
-		bool empty = (h->avail_buckets & BIT(b)) == 0;
+		bool empty = !bucket_avail(h, b);
 		bool zero = n == 0;
 
 		if (empty != zero) {
@@ -150,6 +158,17 @@ bool sys_heap_validate(struct sys_heap *heap)
 		}
 	}
 
+#ifdef CONFIG_SYS_HEAP_TLSF
+	/* Each first level bit must summarize its second level row */
+	for (int fl = 0; fl <= bucket_idx(h, h->end_chunk) / HEAP_SL_COUNT; fl++) {
+		bool row = sl_bitmaps(h)[fl] != 0U;
+
+		if (row != ((h->avail_buckets & BIT(fl)) != 0U)) {
+			return false;
+		}
+	}
+#endif
+
 	/*
 	 * Walk through the chunks linearly again, verifying that all chunks
 	 * but solo headers are now USED (i.e. all free blocks were found
@@ -350,7 +369,7 @@ void sys_heap_stress(void *(*alloc_fn)(void *arg, size_t bytes),
  */
 void heap_print_info(struct z_heap *h, bool dump_chunks)
 {
-	int i, nb_buckets = bucket_idx(h, h->end_chunk) + 1;
+	int i, nb_buckets = bucket_count(h, h->end_chunk);
 	size_t free_bytes, allocated_bytes, total, overhead;
 
 	printk("Heap at %p contains %d units in %d buckets\n\n",
@@ -374,7 +393,7 @@ void heap_print_info(struct z_heap *h, bool dump_chunks)
 		}
 		if (count) {
 			printk("%9d %12d %12d %12d %12zd\n",
-			       i, (1 << i) - 1 + min_chunk_size(h), count,
+			       i, bucket_min_size(h, i), count,
 			       largest, chunksz_to_bytes(h, largest));
 		}
 	}
@@ -421,8 +440,15 @@ int sys_heap_runtime_stats_get(struct sys_heap *heap,
 	}
 
 	stats->free_bytes = heap->heap->free_bytes;
-	stats->allocated_bytes = heap->heap->allocated_bytes;
-	stats->max_allocated_bytes = heap->heap->max_allocated_bytes;
+	stats->allocated_bytes = atomic_get(&heap->heap->allocated_bytes);
+	stats->max_allocated_bytes = atomic_get(&heap->heap->max_allocated_bytes);
+
+#ifdef CONFIG_SYS_HEAP_CACHE
+	size_t cached = heap_cache_info(heap->heap, &stats->cache_hits,
+					&stats->cache_misses);
+
+	stats->free_bytes += cached;
+#endif
 
 	return 0;
 }
@@ -433,7 +459,8 @@ int sys_heap_runtime_stats_reset_max(struct sys_heap *heap)
 		return -EINVAL;
 	}
 
-	heap->heap->max_allocated_bytes = heap->heap->allocated_bytes;
+	atomic_set(&heap->heap->max_allocated_bytes,
+		   atomic_get(&heap->heap->allocated_bytes));
 
 	return 0;
 }
@@ -14,10 +14,23 @@
 #endif
 
 #ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+/* The allocation counters are atomic because the heap cache fast
+ * path hands out and takes back chunks without the heap lock.
+ */
 static inline void increase_allocated_bytes(struct z_heap *h, size_t num_bytes)
 {
-	h->allocated_bytes += num_bytes;
-	h->max_allocated_bytes = MAX(h->max_allocated_bytes, h->allocated_bytes);
+	atomic_val_t now = atomic_add(&h->allocated_bytes, num_bytes) + num_bytes;
+	atomic_val_t max = atomic_get(&h->max_allocated_bytes);
+
+	while (now > max &&
+	       !atomic_cas(&h->max_allocated_bytes, max, now)) {
+		max = atomic_get(&h->max_allocated_bytes);
+	}
+}
+
+static inline void decrease_allocated_bytes(struct z_heap *h, size_t num_bytes)
+{
+	(void)atomic_sub(&h->allocated_bytes, num_bytes);
 }
 #endif
 
@@ -31,17 +44,41 @@ static void *chunk_mem(struct z_heap *h, chunkid_t c)
 	return ret;
 }
 
+static void set_bucket_avail(struct z_heap *h, int bidx, bool avail)
+{
+#ifdef CONFIG_SYS_HEAP_TLSF
+	int fl = bidx / HEAP_SL_COUNT;
+	uint32_t *slmap = &sl_bitmaps(h)[fl];
+
+	if (avail) {
+		*slmap |= BIT(bidx % HEAP_SL_COUNT);
+		h->avail_buckets |= BIT(fl);
+	} else {
+		*slmap &= ~BIT(bidx % HEAP_SL_COUNT);
+		if (*slmap == 0U) {
+			h->avail_buckets &= ~BIT(fl);
+		}
+	}
+#else
+	if (avail) {
+		h->avail_buckets |= BIT(bidx);
+	} else {
+		h->avail_buckets &= ~BIT(bidx);
+	}
+#endif
+}
+
 static void free_list_remove_bidx(struct z_heap *h, chunkid_t c, int bidx)
 {
 	struct z_heap_bucket *b = &h->buckets[bidx];
 
 	CHECK(!chunk_used(h, c));
 	CHECK(b->next != 0);
-	CHECK(h->avail_buckets & BIT(bidx));
+	CHECK(bucket_avail(h, bidx));
 
 	if (next_free_chunk(h, c) == c) {
 		/* this is the last chunk */
-		h->avail_buckets &= ~BIT(bidx);
+		set_bucket_avail(h, bidx, false);
 		b->next = 0;
 	} else {
 		chunkid_t first = prev_free_chunk(h, c),
@@ -70,15 +107,15 @@ static void free_list_add_bidx(struct z_heap *h, chunkid_t c, int bidx)
 	struct z_heap_bucket *b = &h->buckets[bidx];
 
 	if (b->next == 0U) {
-		CHECK((h->avail_buckets & BIT(bidx)) == 0);
+		CHECK(!bucket_avail(h, bidx));
 
 		/* Empty list, first item */
-		h->avail_buckets |= BIT(bidx);
+		set_bucket_avail(h, bidx, true);
 		b->next = c;
 		set_prev_free_chunk(h, c, c);
 		set_next_free_chunk(h, c, c);
 	} else {
-		CHECK(h->avail_buckets & BIT(bidx));
+		CHECK(bucket_avail(h, bidx));
 
 		/* Insert before (!) the "next" pointer */
 		chunkid_t second = b->next;
@@ -160,6 +197,10 @@ static chunkid_t mem_to_chunkid(struct z_heap *h, void *p)
 	return (mem - chunk_header_bytes(h) - base) / CHUNK_UNIT;
 }
 
+#ifdef CONFIG_SYS_HEAP_CACHE
+static bool cache_put(struct z_heap *h, chunkid_t c);
+#endif
+
 void sys_heap_free(struct sys_heap *heap, void *mem)
 {
 	if (mem == NULL) {
@@ -184,16 +225,22 @@ void sys_heap_free(struct sys_heap *heap, void *mem)
 		 "corrupted heap bounds (buffer overflow?) for memory at %p",
 		 mem);
 
-	set_chunk_used(h, c, false);
-#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
-	h->allocated_bytes -= chunksz_to_bytes(h, chunk_size(h, c));
-#endif
-
 #ifdef CONFIG_SYS_HEAP_LISTENER
 	heap_listener_notify_free(HEAP_ID_FROM_POINTER(heap), mem,
 				  chunksz_to_bytes(h, chunk_size(h, c)));
 #endif
 
+#ifdef CONFIG_SYS_HEAP_CACHE
+	if (cache_put(h, c)) {
+		return;
+	}
+#endif
+
+	set_chunk_used(h, c, false);
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	decrease_allocated_bytes(h, chunksz_to_bytes(h, chunk_size(h, c)));
+#endif
+
 	free_chunk(h, c);
 }
 
@@ -215,6 +262,47 @@ static chunkid_t alloc_chunk(struct z_heap *h, chunksz_t sz)
 
 	CHECK(bi <= bucket_idx(h, h->end_chunk));
 
+#ifdef CONFIG_SYS_HEAP_TLSF
+	/* The head of the request's own bucket is the closest fit on
+	 * offer, if it happens to be big enough.
+	 */
+	if (b->next != 0U && chunk_size(h, b->next) >= sz) {
+		chunkid_t c = b->next;
+
+		free_list_remove_bidx(h, c, bi);
+		return c;
+	}
+
+	/* Otherwise anything from a higher bucket fits: take the
+	 * smallest non-empty one, first in the same row then in the
+	 * next non-empty row.
+	 */
+	int fl = (bi + 1) / HEAP_SL_COUNT;
+	int nb_rows = (bucket_count(h, h->end_chunk) - 1) / HEAP_SL_COUNT + 1;
+
+	if (fl >= nb_rows) {
+		return 0;
+	}
+
+	uint32_t slmask = sl_bitmaps(h)[fl] & ~BIT_MASK((bi + 1) % HEAP_SL_COUNT);
+
+	if (slmask == 0U) {
+		uint32_t flmask = h->avail_buckets & ~BIT_MASK(fl + 1);
+
+		if (flmask == 0U) {
+			return 0;
+		}
+		fl = __builtin_ctz(flmask);
+		slmask = sl_bitmaps(h)[fl];
+	}
+
+	int minbucket = fl * HEAP_SL_COUNT + __builtin_ctz(slmask);
+	chunkid_t c = h->buckets[minbucket].next;
+
+	free_list_remove_bidx(h, c, minbucket);
+	CHECK(chunk_size(h, c) >= sz);
+	return c;
+#else
 	/* First try a bounded count of items from the minimal bucket
 	 * size.  These may not fit, trying (e.g.) three means that
 	 * (assuming that chunk sizes are evenly distributed[1]) we
@@ -258,8 +346,334 @@ static chunkid_t alloc_chunk(struct z_heap *h, chunksz_t sz)
 	}
 
 	return 0;
+#endif
+}
+
+#ifdef CONFIG_SYS_HEAP_CACHE
+
+/* Payload sizes of the cached classes.  Requests are rounded up to
+ * the next class, so the steps are kept close enough to waste at most
+ * a third of a block.
+ */
+static const uint16_t cache_class_bytes[HEAP_CACHE_CLASSES] = {
+	16, 32, 48, 64, 96, 128, 192, 256
+};
+
+/* Refills and flushes move half a magazine at a time */
+#define CACHE_BATCH MAX(1, CONFIG_SYS_HEAP_CACHE_DEPTH / 2)
+
+static size_t magazines_offset(struct z_heap *h, chunksz_t heap_sz)
+{
+	return ROUND_UP(heap_meta_bytes(h, heap_sz),
+			__alignof__(struct z_heap_magazine));
+}
+
+static bool cache_fits(chunksz_t heap_sz)
+{
+	return sizeof(struct z_heap_magazine) * HEAP_CACHE_MAGAZINES * 8
+		<= (size_t)heap_sz * CHUNK_UNIT;
+}
+
+static struct z_heap_magazine *heap_magazines(struct z_heap *h)
+{
+	if (!cache_fits(h->end_chunk)) {
+		return NULL;
+	}
+	return (void *)((uint8_t *)h + magazines_offset(h, h->end_chunk));
+}
+
+static int cache_class(size_t bytes)
+{
+	for (int i = 0; i < HEAP_CACHE_CLASSES; i++) {
+		if (bytes <= cache_class_bytes[i]) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+static int cache_chunk_class(struct z_heap *h, chunksz_t sz)
+{
+	for (int i = 0; i < HEAP_CACHE_CLASSES; i++) {
+		if (bytes_to_chunksz(h, cache_class_bytes[i]) == sz) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+/* Magazine for the given class on the current CPU.  Being migrated
+ * right after picking it is harmless: every magazine has its own lock
+ * and any of them can serve any request.  User threads can't take
+ * spinlocks, so they always go straight to the heap.
+ */
+static struct z_heap_magazine *cache_magazine(struct z_heap *h, int cls)
+{
+	struct z_heap_magazine *m = heap_magazines(h);
+	unsigned int cpu = 0;
+
+	if (m == NULL || cls < 0 || k_is_user_context()) {
+		return NULL;
+	}
+#ifdef CONFIG_SMP
+	cpu = arch_curr_cpu()->id;
+#endif
+	return &m[cpu * HEAP_CACHE_CLASSES + cls];
+}
+
+/* Returns a magazine chunk to the heap proper.  Runtime statistics
+ * only count chunks handed to callers, so nothing to account here.
+ */
+static void cache_release(struct z_heap *h, chunkid_t c)
+{
+	set_chunk_used(h, c, false);
+	free_chunk(h, c);
+}
+
+/* Carves a batch of class sized chunks out of a single free chunk,
+ * stocking the magazine with all but the first, which is returned.
+ * Falls back to a single chunk when memory is tight.
+ */
+static chunkid_t cache_refill(struct z_heap *h, struct z_heap_magazine *m,
+			      int cls)
+{
+	chunksz_t sz = bytes_to_chunksz(h, cache_class_bytes[cls]);
+	int n = CACHE_BATCH;
+	chunkid_t c = alloc_chunk(h, sz * n);
+
+	if (c == 0U) {
+		n = 1;
+		c = alloc_chunk(h, sz);
+		if (c == 0U) {
+			return 0;
+		}
+	}
+
+	if (chunk_size(h, c) > sz * n) {
+		split_chunks(h, c, c + sz * n);
+		free_list_add(h, c + sz * n);
+	}
+
+	for (int i = n - 1; i > 0; i--) {
+		split_chunks(h, c, c + sz * i);
+		set_chunk_used(h, c + sz * i, true);
+		m->chunks[m->count++] = c + sz * i;
+	}
+	set_chunk_used(h, c, true);
+
+	return c;
+}
+
+/* Hands the oldest half of a full magazine back to the heap */
+static void cache_flush(struct z_heap *h, struct z_heap_magazine *m)
+{
+	for (int i = 0; i < CACHE_BATCH; i++) {
+		cache_release(h, m->chunks[i]);
+	}
+	m->count -= CACHE_BATCH;
+	memmove(&m->chunks[0], &m->chunks[CACHE_BATCH],
+		m->count * sizeof(m->chunks[0]));
+}
+
+/* Slow path, heap lock held: pop, or refill on a miss */
+static chunkid_t cache_get(struct z_heap *h, struct z_heap_magazine *m,
+			   int cls)
+{
+	k_spinlock_key_t key = k_spin_lock(&m->lock);
+	chunkid_t c;
+
+	if (m->count > 0U) {
+		c = m->chunks[--m->count];
+		m->hits++;
+	} else {
+		c = cache_refill(h, m, cls);
+		m->misses++;
+	}
+
+	k_spin_unlock(&m->lock, key);
+
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	if (c != 0U) {
+		increase_allocated_bytes(h, chunksz_to_bytes(h, chunk_size(h, c)));
+	}
+#endif
+	return c;
+}
+
+/* Slow path, heap lock held: push, flushing first if full */
+static bool cache_put(struct z_heap *h, chunkid_t c)
+{
+	struct z_heap_magazine *m;
+	k_spinlock_key_t key;
+
+	m = cache_magazine(h, cache_chunk_class(h, chunk_size(h, c)));
+	if (m == NULL) {
+		return false;
+	}
+
+	key = k_spin_lock(&m->lock);
+	if (m->count == CONFIG_SYS_HEAP_CACHE_DEPTH) {
+		cache_flush(h, m);
+	}
+	m->chunks[m->count++] = c;
+	k_spin_unlock(&m->lock, key);
+
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	decrease_allocated_bytes(h, chunksz_to_bytes(h, chunk_size(h, c)));
+#endif
+	return true;
+}
+
+/* Empties every magazine of every CPU back into the heap so that
+ * a failing allocation gets to see all free memory.  Returns true if
+ * anything was released.
+ */
+static bool cache_drain(struct z_heap *h)
+{
+	struct z_heap_magazine *m = heap_magazines(h);
+	bool drained = false;
+
+	if (m == NULL || k_is_user_context()) {
+		return false;
+	}
+
+	for (int i = 0; i < HEAP_CACHE_MAGAZINES; i++) {
+		k_spinlock_key_t key = k_spin_lock(&m[i].lock);
+
+		drained = drained || (m[i].count > 0U);
+		while (m[i].count > 0U) {
+			cache_release(h, m[i].chunks[--m[i].count]);
+		}
+		k_spin_unlock(&m[i].lock, key);
+	}
+
+	return drained;
+}
+
+size_t heap_cache_info(struct z_heap *h, size_t *hits, size_t *misses)
+{
+	struct z_heap_magazine *m = heap_magazines(h);
+	size_t bytes = 0, nhits = 0, nmisses = 0;
+
+	for (int i = 0; m != NULL && i < HEAP_CACHE_MAGAZINES; i++) {
+		chunksz_t sz = bytes_to_chunksz(h,
+			cache_class_bytes[i % HEAP_CACHE_CLASSES]);
+
+		bytes += m[i].count * chunksz_to_bytes(h, sz);
+		nhits += m[i].hits;
+		nmisses += m[i].misses;
+	}
+
+	if (hits != NULL) {
+		*hits = nhits;
+	}
+	if (misses != NULL) {
+		*misses = nmisses;
+	}
+	return bytes;
+}
+
+void *sys_heap_cache_alloc(struct sys_heap *heap, size_t align, size_t bytes)
+{
+	struct z_heap *h = heap->heap;
+	struct z_heap_magazine *m;
+	k_spinlock_key_t key;
+	chunkid_t c = 0;
+	void *mem;
+
+	/* Magazine chunks only carry the natural chunk alignment */
+	if (bytes == 0U || (align & (align - 1)) != 0U ||
+	    align > chunk_header_bytes(h)) {
+		return NULL;
+	}
+
+	m = cache_magazine(h, cache_class(bytes));
+	if (m == NULL) {
+		return NULL;
+	}
+
+	key = k_spin_lock(&m->lock);
+	if (m->count > 0U) {
+		c = m->chunks[--m->count];
+		m->hits++;
+	}
+	k_spin_unlock(&m->lock, key);
+
+	if (c == 0U) {
+		return NULL;
+	}
+
+	mem = chunk_mem(h, c);
+
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	/* Cached chunks count as free; this one is now the caller's */
+	increase_allocated_bytes(h, chunksz_to_bytes(h, chunk_size(h, c)));
+#endif
+
+#ifdef CONFIG_SYS_HEAP_LISTENER
+	heap_listener_notify_alloc(HEAP_ID_FROM_POINTER(heap), mem,
+				   chunksz_to_bytes(h, chunk_size(h, c)));
+#endif
+
+	IF_ENABLED(CONFIG_MSAN, (__msan_allocated_memory(mem, bytes)));
+	return mem;
 }
 
+bool sys_heap_cache_free(struct sys_heap *heap, void *mem)
+{
+	struct z_heap *h = heap->heap;
+	struct z_heap_magazine *m;
+	k_spinlock_key_t key;
+	bool cached = false;
+
+	if (mem == NULL) {
+		return true;
+	}
+
+	chunkid_t c = mem_to_chunkid(h, mem);
+
+	__ASSERT(chunk_used(h, c),
+		 "unexpected heap state (double-free?) for memory at %p", mem);
+	__ASSERT(left_chunk(h, right_chunk(h, c)) == c,
+		 "corrupted heap bounds (buffer overflow?) for memory at %p",
+		 mem);
+
+	m = cache_magazine(h, cache_chunk_class(h, chunk_size(h, c)));
+	if (m == NULL) {
+		return false;
+	}
+
+#if defined(CONFIG_SYS_HEAP_RUNTIME_STATS) || defined(CONFIG_SYS_HEAP_LISTENER)
+	/* Once parked, the chunk may be flushed back and merged by
+	 * another CPU, so take its size while it is still ours.
+	 */
+	size_t chunk_bytes = chunksz_to_bytes(h, chunk_size(h, c));
+#endif
+
+	key = k_spin_lock(&m->lock);
+	if (m->count < CONFIG_SYS_HEAP_CACHE_DEPTH) {
+		m->chunks[m->count++] = c;
+		cached = true;
+	}
+	k_spin_unlock(&m->lock, key);
+
+	if (!cached) {
+		return false;
+	}
+
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	decrease_allocated_bytes(h, chunk_bytes);
+#endif
+
+#ifdef CONFIG_SYS_HEAP_LISTENER
+	heap_listener_notify_free(HEAP_ID_FROM_POINTER(heap), mem, chunk_bytes);
+#endif
+
+	return true;
+}
+
+#endif /* CONFIG_SYS_HEAP_CACHE */
+
 void *sys_heap_alloc(struct sys_heap *heap, size_t bytes)
 {
 	struct z_heap *h = heap->heap;
@@ -269,8 +683,32 @@ void *sys_heap_alloc(struct sys_heap *heap, size_t bytes)
 		return NULL;
 	}
 
+#ifdef CONFIG_SYS_HEAP_CACHE
+	int cls = cache_class(bytes);
+	struct z_heap_magazine *m = cache_magazine(h, cls);
+
+	if (m != NULL) {
+		chunkid_t c = cache_get(h, m, cls);
+
+		if (c != 0U) {
+			mem = chunk_mem(h, c);
+#ifdef CONFIG_SYS_HEAP_LISTENER
+			heap_listener_notify_alloc(HEAP_ID_FROM_POINTER(heap), mem,
+						   chunksz_to_bytes(h, chunk_size(h, c)));
+#endif
+			IF_ENABLED(CONFIG_MSAN, (__msan_allocated_memory(mem, bytes)));
+			return mem;
+		}
+	}
+#endif
+
 	chunksz_t chunk_sz = bytes_to_chunksz(h, bytes);
 	chunkid_t c = alloc_chunk(h, chunk_sz);
+#ifdef CONFIG_SYS_HEAP_CACHE
+	if (c == 0U && cache_drain(h)) {
+		c = alloc_chunk(h, chunk_sz);
+	}
+#endif
 	if (c == 0U) {
 		return NULL;
 	}
@@ -335,6 +773,11 @@ void *sys_heap_aligned_alloc(struct sys_heap *heap, size_t align, size_t bytes)
 	chunksz_t padded_sz = bytes_to_chunksz(h, bytes + align - gap);
 	chunkid_t c0 = alloc_chunk(h, padded_sz);
 
+#ifdef CONFIG_SYS_HEAP_CACHE
+	if (c0 == 0 && cache_drain(h)) {
+		c0 = alloc_chunk(h, padded_sz);
+	}
+#endif
 	if (c0 == 0) {
 		return NULL;
 	}
@@ -413,8 +856,8 @@ void *sys_heap_aligned_realloc(struct sys_heap *heap, void *ptr,
 #endif
 
 #ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
-		h->allocated_bytes -=
-			(chunk_size(h, c) - chunks_need) * CHUNK_UNIT;
+		decrease_allocated_bytes(h,
+			(chunk_size(h, c) - chunks_need) * CHUNK_UNIT);
 #endif
 
 		split_chunks(h, c, c + chunks_need);
@@ -513,19 +956,33 @@ void sys_heap_init(struct sys_heap *heap, void *mem, size_t bytes)
 
 #ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
 	h->free_bytes = 0;
-	h->allocated_bytes = 0;
-	h->max_allocated_bytes = 0;
+	atomic_set(&h->allocated_bytes, 0);
+	atomic_set(&h->max_allocated_bytes, 0);
 #endif
 
-	int nb_buckets = bucket_idx(h, heap_sz) + 1;
-	chunksz_t chunk0_size = chunksz(sizeof(struct z_heap) +
-				     nb_buckets * sizeof(struct z_heap_bucket));
+	int nb_buckets = bucket_count(h, heap_sz);
+	chunksz_t chunk0_size = chunksz(heap_meta_bytes(h, heap_sz));
+
+#ifdef CONFIG_SYS_HEAP_CACHE
+	if (cache_fits(heap_sz)) {
+		struct z_heap_magazine *m = heap_magazines(h);
+
+		chunk0_size = chunksz(magazines_offset(h, heap_sz) +
+				      HEAP_CACHE_MAGAZINES * sizeof(*m));
+		memset(m, 0, HEAP_CACHE_MAGAZINES * sizeof(*m));
+	}
+#endif
 
 	__ASSERT(chunk0_size + min_chunk_size(h) <= heap_sz, "heap size is too small");
 
 	for (int i = 0; i < nb_buckets; i++) {
 		h->buckets[i].next = 0;
 	}
+#ifdef CONFIG_SYS_HEAP_TLSF
+	for (int i = 0; i <= (nb_buckets - 1) / HEAP_SL_COUNT; i++) {
+		sl_bitmaps(h)[i] = 0;
+	}
+#endif
 
 	/* chunk containing our struct z_heap */
 	set_chunk_size(h, 0, chunk0_size);
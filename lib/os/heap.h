@@ -71,12 +71,34 @@ struct z_heap {
 	uint32_t avail_buckets;
 #ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
 	size_t free_bytes;
-	size_t allocated_bytes;
-	size_t max_allocated_bytes;
+	/* Also updated by the lockless heap cache fast path */
+	atomic_t allocated_bytes;
+	atomic_t max_allocated_bytes;
 #endif
 	struct z_heap_bucket buckets[0];
 };
 
+#ifdef CONFIG_SYS_HEAP_CACHE
+/* Per-CPU magazines of ready-to-use chunks for small allocations.
+ * Each CPU owns one magazine per size class.  The array lives in
+ * chunk0 right after the bucket list heads, and only exists on heaps
+ * large enough that it costs no more than 1/8 of the heap.  Chunks
+ * sitting in a magazine are marked used, so the rest of the heap code
+ * sees them as ordinary allocations.
+ */
+#define HEAP_CACHE_CLASSES 8
+
+struct z_heap_magazine {
+	struct k_spinlock lock;
+	uint32_t hits;
+	uint32_t misses;
+	uint16_t count;
+	chunkid_t chunks[CONFIG_SYS_HEAP_CACHE_DEPTH];
+};
+
+#define HEAP_CACHE_MAGAZINES (CONFIG_MP_MAX_NUM_CPUS * HEAP_CACHE_CLASSES)
+#endif
+
 static inline bool big_heap_chunks(chunksz_t chunks)
 {
 	if (IS_ENABLED(CONFIG_SYS_HEAP_SMALL_ONLY)) {
@@ -247,12 +269,87 @@ static inline size_t chunksz_to_bytes(struct z_heap *h, chunksz_t chunksz_in)
 	return chunksz_in * CHUNK_UNIT - chunk_header_bytes(h);
 }
 
+#ifdef CONFIG_SYS_HEAP_TLSF
+/* Two-level segregated fit: each power-of-two size range (first
+ * level) is split linearly into HEAP_SL_COUNT sub-buckets (second
+ * level).  Ranges too small to split get one bucket per size.  The
+ * avail_buckets word tracks non-empty first level rows, and a per-row
+ * bitmap stored after the buckets tracks non-empty sub-buckets, so
+ * finding a fitting free chunk is two find-first-set operations.
+ */
+#define HEAP_SL_BITS CONFIG_SYS_HEAP_TLSF_SL_BITS
+#define HEAP_SL_COUNT (1 << HEAP_SL_BITS)
+
+static inline int bucket_idx(struct z_heap *h, chunksz_t sz)
+{
+	unsigned int usable_sz = sz - min_chunk_size(h) + 1;
+	int msb = 31 - __builtin_clz(usable_sz);
+
+	if (msb < HEAP_SL_BITS) {
+		return usable_sz;
+	}
+	return (msb - HEAP_SL_BITS + 1) * HEAP_SL_COUNT +
+		(usable_sz >> (msb - HEAP_SL_BITS)) - HEAP_SL_COUNT;
+}
+
+/* Smallest chunk size stored in a bucket */
+static inline chunksz_t bucket_min_size(struct z_heap *h, int bidx)
+{
+	int fl = bidx / HEAP_SL_COUNT, sl = bidx % HEAP_SL_COUNT;
+	unsigned int usable_sz = fl == 0 ? sl : (HEAP_SL_COUNT + sl) << (fl - 1);
+
+	return usable_sz - 1 + min_chunk_size(h);
+}
+#else
 static inline int bucket_idx(struct z_heap *h, chunksz_t sz)
 {
 	unsigned int usable_sz = sz - min_chunk_size(h) + 1;
 	return 31 - __builtin_clz(usable_sz);
 }
 
+static inline chunksz_t bucket_min_size(struct z_heap *h, int bidx)
+{
+	return (1 << bidx) - 1 + min_chunk_size(h);
+}
+#endif
+
+static inline int bucket_count(struct z_heap *h, chunksz_t heap_sz)
+{
+	return bucket_idx(h, heap_sz) + 1;
+}
+
+/* Bytes of chunk0 metadata: struct z_heap and the bucket heads (plus
+ * the second level bitmaps with CONFIG_SYS_HEAP_TLSF)
+ */
+static inline size_t heap_meta_bytes(struct z_heap *h, chunksz_t heap_sz)
+{
+	int nb_buckets = bucket_count(h, heap_sz);
+	size_t bytes = sizeof(struct z_heap) +
+		       nb_buckets * sizeof(struct z_heap_bucket);
+
+#ifdef CONFIG_SYS_HEAP_TLSF
+	bytes += ((nb_buckets - 1) / HEAP_SL_COUNT + 1) * sizeof(uint32_t);
+#endif
+	return bytes;
+}
+
+#ifdef CONFIG_SYS_HEAP_TLSF
+static inline uint32_t *sl_bitmaps(struct z_heap *h)
+{
+	return (uint32_t *)&h->buckets[bucket_count(h, h->end_chunk)];
+}
+
+static inline bool bucket_avail(struct z_heap *h, int bidx)
+{
+	return (sl_bitmaps(h)[bidx / HEAP_SL_COUNT] & BIT(bidx % HEAP_SL_COUNT)) != 0;
+}
+#else
+static inline bool bucket_avail(struct z_heap *h, int bidx)
+{
+	return (h->avail_buckets & BIT(bidx)) != 0;
+}
+#endif
+
 static inline bool size_too_big(struct z_heap *h, size_t bytes)
 {
 	/*
@@ -265,4 +362,11 @@ static inline bool size_too_big(struct z_heap *h, size_t bytes)
 /* For debugging */
 void heap_print_info(struct z_heap *h, bool dump_chunks);
 
+#ifdef CONFIG_SYS_HEAP_CACHE
+/* Returns the bytes held in the per-CPU magazines.  Hit and miss
+ * totals are returned through the optional pointers.
+ */
+size_t heap_cache_info(struct z_heap *h, size_t *hits, size_t *misses);
+#endif
+
 #endif /* ZEPHYR_INCLUDE_LIB_OS_HEAP_H_ */
@@ -9,6 +9,8 @@
 #include <zephyr/syscall_handler.h>
 #include <zephyr/kernel_structs.h>
 
+#include "futex_timeout.h"
+
 static struct k_mutex *get_k_mutex(struct sys_mutex *mutex)
 {
 	struct z_object *obj;
@@ -72,3 +74,90 @@ static inline int z_vrfy_z_sys_mutex_kernel_unlock(struct sys_mutex *mutex)
 	return z_impl_z_sys_mutex_kernel_unlock(mutex);
 }
 #include <syscalls/z_sys_mutex_kernel_unlock_mrsh.c>
+
+#ifdef CONFIG_SYS_MUTEX_FUTEX
+/* Futex values, as described in "Futexes Are Tricky" by Ulrich Drepper */
+#define SYS_MUTEX_UNLOCKED	0
+#define SYS_MUTEX_LOCKED	1
+#define SYS_MUTEX_CONTENDED	2
+
+int z_sys_mutex_futex_lock(struct sys_mutex *mutex, k_timeout_t timeout)
+{
+	struct k_thread *self = k_current_get();
+	atomic_t old_value;
+	int64_t start;
+	k_timeout_t left;
+	int ret;
+
+	if (mutex->owner == self) {
+		mutex->lock_count++;
+		return 0;
+	}
+
+	/* Uncontended, no syscall */
+	if (atomic_cas(&mutex->futex.val, SYS_MUTEX_UNLOCKED,
+		       SYS_MUTEX_LOCKED)) {
+		goto locked;
+	}
+
+	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		return -EBUSY;
+	}
+
+	/* Mark the mutex contended, so the owner wakes us up on unlock. If
+	 * it was released in between, we own it, just contended. Another
+	 * thread may grab it before we wake up, so every retry only waits
+	 * for what is left of the timeout.
+	 */
+	start = z_futex_wait_start(timeout);
+	old_value = atomic_set(&mutex->futex.val, SYS_MUTEX_CONTENDED);
+	while (old_value != SYS_MUTEX_UNLOCKED) {
+		left = z_futex_wait_left(timeout, start);
+		if (K_TIMEOUT_EQ(left, K_NO_WAIT)) {
+			return -EAGAIN;
+		}
+
+		ret = k_futex_wait(&mutex->futex, SYS_MUTEX_CONTENDED, left);
+		if (ret == -ETIMEDOUT) {
+			return -EAGAIN;
+		} else if (ret != 0 && ret != -EAGAIN) {
+			return ret;
+		}
+
+		old_value = atomic_set(&mutex->futex.val, SYS_MUTEX_CONTENDED);
+	}
+
+locked:
+	mutex->owner = self;
+	mutex->lock_count = 1U;
+
+	return 0;
+}
+
+int z_sys_mutex_futex_unlock(struct sys_mutex *mutex)
+{
+	if (atomic_get(&mutex->futex.val) == SYS_MUTEX_UNLOCKED) {
+		return -EINVAL;
+	}
+
+	if (mutex->owner != k_current_get()) {
+		return -EPERM;
+	}
+
+	if (--mutex->lock_count > 0U) {
+		return 0;
+	}
+
+	mutex->owner = NULL;
+
+	/* Uncontended, no syscall */
+	if (atomic_dec(&mutex->futex.val) != SYS_MUTEX_CONTENDED) {
+		return 0;
+	}
+
+	atomic_set(&mutex->futex.val, SYS_MUTEX_UNLOCKED);
+	(void)k_futex_wake(&mutex->futex, false);
+
+	return 0;
+}
+#endif /* CONFIG_SYS_MUTEX_FUTEX */
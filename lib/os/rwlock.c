@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/sys/rwlock.h>
+
+#include "futex_timeout.h"
+
+#ifdef CONFIG_USERSPACE
+/* Futex value layout, kept within a positive int since futex values are
+ * compared as int
+ */
+#define SYS_RWLOCK_WRITER	BIT(30)
+#define SYS_RWLOCK_WAITERS	BIT(29)
+#define SYS_RWLOCK_READERS	(SYS_RWLOCK_WAITERS - 1)
+
+/* Sleep until the lock value changes from @a value, after flagging that
+ * there are waiters so that the next unlock wakes us up. Callers loop, so
+ * only what is left of the timeout since @a start is waited for.
+ */
+static int rwlock_wait(struct sys_rwlock *rwlock, atomic_val_t value,
+		       k_timeout_t timeout, int64_t start)
+{
+	k_timeout_t left;
+	int ret;
+
+	left = z_futex_wait_left(timeout, start);
+	if (K_TIMEOUT_EQ(left, K_NO_WAIT)) {
+		return -EAGAIN;
+	}
+
+	if ((value & SYS_RWLOCK_WAITERS) == 0 &&
+	    !atomic_cas(&rwlock->futex.val, value,
+			value | SYS_RWLOCK_WAITERS)) {
+		/* Changed under us, look again */
+		return 0;
+	}
+
+	ret = k_futex_wait(&rwlock->futex, (int)(value | SYS_RWLOCK_WAITERS),
+			   left);
+	if (ret == -ETIMEDOUT) {
+		return -EAGAIN;
+	} else if (ret == -EAGAIN) {
+		return 0;
+	} else {
+		return ret;
+	}
+}
+
+int sys_rwlock_init(struct sys_rwlock *rwlock)
+{
+	atomic_set(&rwlock->futex.val, 0);
+
+	return 0;
+}
+
+int sys_rwlock_read_lock(struct sys_rwlock *rwlock, k_timeout_t timeout)
+{
+	int64_t start = -1;
+	atomic_val_t value;
+	int ret;
+
+	for (;;) {
+		value = atomic_get(&rwlock->futex.val);
+
+		/* Readers wait behind writers and any other waiter */
+		if ((value & (SYS_RWLOCK_WRITER | SYS_RWLOCK_WAITERS)) == 0) {
+			__ASSERT((value & SYS_RWLOCK_READERS) !=
+				 SYS_RWLOCK_READERS, "too many readers");
+
+			if (atomic_cas(&rwlock->futex.val, value, value + 1)) {
+				return 0;
+			}
+			continue;
+		}
+
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			return -EBUSY;
+		}
+
+		/* Only clock the wait once we have to sleep */
+		if (start < 0) {
+			start = z_futex_wait_start(timeout);
+		}
+
+		ret = rwlock_wait(rwlock, value, timeout, start);
+		if (ret != 0) {
+			return ret;
+		}
+	}
+}
+
+int sys_rwlock_read_unlock(struct sys_rwlock *rwlock)
+{
+	atomic_val_t old_value, new_value;
+
+	do {
+		old_value = atomic_get(&rwlock->futex.val);
+		if ((old_value & SYS_RWLOCK_READERS) == 0) {
+			return -EINVAL;
+		}
+
+		new_value = old_value - 1;
+		if ((new_value & SYS_RWLOCK_READERS) == 0) {
+			new_value = 0;
+		}
+	} while (!atomic_cas(&rwlock->futex.val, old_value, new_value));
+
+	/* Last reader out lets the waiters race for the lock */
+	if (new_value == 0 && (old_value & SYS_RWLOCK_WAITERS) != 0) {
+		(void)k_futex_wake(&rwlock->futex, true);
+	}
+
+	return 0;
+}
+
+int sys_rwlock_write_lock(struct sys_rwlock *rwlock, k_timeout_t timeout)
+{
+	int64_t start = -1;
+	atomic_val_t value;
+	int ret;
+
+	for (;;) {
+		value = atomic_get(&rwlock->futex.val);
+
+		/* Keep the waiters flag, others may still be asleep */
+		if ((value & ~SYS_RWLOCK_WAITERS) == 0) {
+			if (atomic_cas(&rwlock->futex.val, value,
+				       value | SYS_RWLOCK_WRITER)) {
+				return 0;
+			}
+			continue;
+		}
+
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			return -EBUSY;
+		}
+
+		/* Only clock the wait once we have to sleep */
+		if (start < 0) {
+			start = z_futex_wait_start(timeout);
+		}
+
+		ret = rwlock_wait(rwlock, value, timeout, start);
+		if (ret != 0) {
+			return ret;
+		}
+	}
+}
+
+int sys_rwlock_write_unlock(struct sys_rwlock *rwlock)
+{
+	atomic_val_t old_value;
+
+	do {
+		old_value = atomic_get(&rwlock->futex.val);
+		if ((old_value & SYS_RWLOCK_WRITER) == 0) {
+			return -EPERM;
+		}
+	} while (!atomic_cas(&rwlock->futex.val, old_value, 0));
+
+	if ((old_value & SYS_RWLOCK_WAITERS) != 0) {
+		(void)k_futex_wake(&rwlock->futex, true);
+	}
+
+	return 0;
+}
+#else
+int sys_rwlock_init(struct sys_rwlock *rwlock)
+{
+	return k_rwlock_init(&rwlock->kernel_rwlock);
+}
+
+int sys_rwlock_read_lock(struct sys_rwlock *rwlock, k_timeout_t timeout)
+{
+	return k_rwlock_read_lock(&rwlock->kernel_rwlock, timeout);
+}
+
+int sys_rwlock_read_unlock(struct sys_rwlock *rwlock)
+{
+	return k_rwlock_read_unlock(&rwlock->kernel_rwlock);
+}
+
+int sys_rwlock_write_lock(struct sys_rwlock *rwlock, k_timeout_t timeout)
+{
+	return k_rwlock_write_lock(&rwlock->kernel_rwlock, timeout);
+}
+
+int sys_rwlock_write_unlock(struct sys_rwlock *rwlock)
+{
+	return k_rwlock_write_unlock(&rwlock->kernel_rwlock);
+}
+#endif
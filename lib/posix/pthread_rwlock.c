@@ -11,11 +11,7 @@
 #define INITIALIZED 1
 #define NOT_INITIALIZED 0
 
-#define CONCURRENT_READER_LIMIT  (CONFIG_MAX_PTHREAD_COUNT + 1)
-
 int64_t timespec_to_timeoutms(const struct timespec *abstime);
-static uint32_t read_lock_acquire(pthread_rwlock_t *rwlock, int32_t timeout);
-static uint32_t write_lock_acquire(pthread_rwlock_t *rwlock, int32_t timeout);
 
 /**
  * @brief Initialize read-write lock object.
@@ -25,11 +21,7 @@ static uint32_t write_lock_acquire(pthread_rwlock_t *rwlock, int32_t timeout);
 int pthread_rwlock_init(pthread_rwlock_t *rwlock,
 			const pthread_rwlockattr_t *attr)
 {
-	k_sem_init(&rwlock->rd_sem, CONCURRENT_READER_LIMIT,
-		   CONCURRENT_READER_LIMIT);
-	k_sem_init(&rwlock->wr_sem, 1, 1);
-	k_sem_init(&rwlock->reader_active, 1, 1);
-	rwlock->wr_owner = NULL;
+	k_rwlock_init(&rwlock->lock);
 	rwlock->status = INITIALIZED;
 	return 0;
 }
@@ -45,7 +37,7 @@ int pthread_rwlock_destroy(pthread_rwlock_t *rwlock)
 		return EINVAL;
 	}
 
-	if (rwlock->wr_owner != NULL) {
+	if (rwlock->lock.writer != NULL) {
 		return EBUSY;
 	}
 
@@ -57,11 +49,20 @@ int pthread_rwlock_destroy(pthread_rwlock_t *rwlock)
 	return EINVAL;
 }
 
+static int timed_timeout(const struct timespec *abstime, k_timeout_t *timeout)
+{
+	if (abstime->tv_nsec < 0 || abstime->tv_nsec > NSEC_PER_SEC) {
+		return EINVAL;
+	}
+
+	*timeout = SYS_TIMEOUT_MS((int32_t)timespec_to_timeoutms(abstime));
+	return 0;
+}
+
 /**
  * @brief Lock a read-write lock object for reading.
  *
- * API behaviour is unpredictable if number of concurrent reader
- * lock held is greater than CONCURRENT_READER_LIMIT.
+ * Waiting writers take precedence over new readers.
  *
  * See IEEE 1003.1
  */
@@ -71,43 +72,30 @@ int pthread_rwlock_rdlock(pthread_rwlock_t *rwlock)
 		return EINVAL;
 	}
 
-	return read_lock_acquire(rwlock, SYS_FOREVER_MS);
+	return k_rwlock_read_lock(&rwlock->lock, K_FOREVER) == 0 ? 0 : EBUSY;
 }
 
 /**
  * @brief Lock a read-write lock object for reading within specific time.
  *
- * API behaviour is unpredictable if number of concurrent reader
- * lock held is greater than CONCURRENT_READER_LIMIT.
- *
  * See IEEE 1003.1
  */
 int pthread_rwlock_timedrdlock(pthread_rwlock_t *rwlock,
 			       const struct timespec *abstime)
 {
-	int32_t timeout;
-	uint32_t ret = 0U;
+	k_timeout_t timeout;
 
-	if (rwlock->status == NOT_INITIALIZED || abstime->tv_nsec < 0 ||
-	    abstime->tv_nsec > NSEC_PER_SEC) {
+	if (rwlock->status == NOT_INITIALIZED ||
+	    timed_timeout(abstime, &timeout) != 0) {
 		return EINVAL;
 	}
 
-	timeout = (int32_t) timespec_to_timeoutms(abstime);
-
-	if (read_lock_acquire(rwlock, timeout) != 0U) {
-		ret = ETIMEDOUT;
-	}
-
-	return ret;
+	return k_rwlock_read_lock(&rwlock->lock, timeout) == 0 ? 0 : ETIMEDOUT;
 }
 
 /**
  * @brief Lock a read-write lock object for reading immediately.
  *
- * API behaviour is unpredictable if number of concurrent reader
- * lock held is greater than CONCURRENT_READER_LIMIT.
- *
  * See IEEE 1003.1
  */
 int pthread_rwlock_tryrdlock(pthread_rwlock_t *rwlock)
@@ -116,15 +104,12 @@ int pthread_rwlock_tryrdlock(pthread_rwlock_t *rwlock)
 		return EINVAL;
 	}
 
-	return read_lock_acquire(rwlock, 0);
+	return k_rwlock_read_lock(&rwlock->lock, K_NO_WAIT) == 0 ? 0 : EBUSY;
 }
 
 /**
  * @brief Lock a read-write lock object for writing.
  *
- * Write lock does not have priority over reader lock,
- * threads get lock based on priority.
- *
  * See IEEE 1003.1
  */
 int pthread_rwlock_wrlock(pthread_rwlock_t *rwlock)
@@ -133,43 +118,30 @@ int pthread_rwlock_wrlock(pthread_rwlock_t *rwlock)
 		return EINVAL;
 	}
 
-	return write_lock_acquire(rwlock, SYS_FOREVER_MS);
+	return k_rwlock_write_lock(&rwlock->lock, K_FOREVER) == 0 ? 0 : EBUSY;
 }
 
 /**
  * @brief Lock a read-write lock object for writing within specific time.
  *
- * Write lock does not have priority over reader lock,
- * threads get lock based on priority.
- *
  * See IEEE 1003.1
  */
 int pthread_rwlock_timedwrlock(pthread_rwlock_t *rwlock,
 			       const struct timespec *abstime)
 {
-	int32_t timeout;
-	uint32_t ret = 0U;
+	k_timeout_t timeout;
 
-	if (rwlock->status == NOT_INITIALIZED || abstime->tv_nsec < 0 ||
-	    abstime->tv_nsec > NSEC_PER_SEC) {
+	if (rwlock->status == NOT_INITIALIZED ||
+	    timed_timeout(abstime, &timeout) != 0) {
 		return EINVAL;
 	}
 
-	timeout = (int32_t) timespec_to_timeoutms(abstime);
-
-	if (write_lock_acquire(rwlock, timeout) != 0U) {
-		ret = ETIMEDOUT;
-	}
-
-	return ret;
+	return k_rwlock_write_lock(&rwlock->lock, timeout) == 0 ? 0 : ETIMEDOUT;
 }
 
 /**
  * @brief Lock a read-write lock object for writing immediately.
  *
- * Write lock does not have priority over reader lock,
- * threads get lock based on priority.
- *
  * See IEEE 1003.1
  */
 int pthread_rwlock_trywrlock(pthread_rwlock_t *rwlock)
@@ -178,7 +150,7 @@ int pthread_rwlock_trywrlock(pthread_rwlock_t *rwlock)
 		return EINVAL;
 	}
 
-	return write_lock_acquire(rwlock, 0);
+	return k_rwlock_write_lock(&rwlock->lock, K_NO_WAIT) == 0 ? 0 : EBUSY;
 }
 
 /**
@@ -189,73 +161,17 @@ int pthread_rwlock_trywrlock(pthread_rwlock_t *rwlock)
  */
 int pthread_rwlock_unlock(pthread_rwlock_t *rwlock)
 {
+	int ret;
+
 	if (rwlock->status == NOT_INITIALIZED) {
 		return EINVAL;
 	}
 
-	if (k_current_get() == rwlock->wr_owner) {
-		/* Write unlock */
-		rwlock->wr_owner = NULL;
-		k_sem_give(&rwlock->reader_active);
-		k_sem_give(&rwlock->wr_sem);
+	if (rwlock->lock.writer == k_current_get()) {
+		ret = k_rwlock_write_unlock(&rwlock->lock);
 	} else {
-		/* Read unlock */
-		if (k_sem_count_get(&rwlock->rd_sem) ==
-				    (CONCURRENT_READER_LIMIT - 1)) {
-			/* Last read lock, unlock writer */
-			k_sem_give(&rwlock->reader_active);
-		}
-
-		k_sem_give(&rwlock->rd_sem);
-	}
-	return 0;
-}
-
-
-static uint32_t read_lock_acquire(pthread_rwlock_t *rwlock, int32_t timeout)
-{
-	uint32_t ret = 0U;
-
-	if (k_sem_take(&rwlock->wr_sem, SYS_TIMEOUT_MS(timeout)) == 0) {
-		k_sem_take(&rwlock->reader_active, K_NO_WAIT);
-		k_sem_take(&rwlock->rd_sem, K_NO_WAIT);
-		k_sem_give(&rwlock->wr_sem);
-	} else {
-		ret = EBUSY;
+		ret = k_rwlock_read_unlock(&rwlock->lock);
 	}
 
-	return ret;
-}
-
-static uint32_t write_lock_acquire(pthread_rwlock_t *rwlock, int32_t timeout)
-{
-	uint32_t ret = 0U;
-	int64_t elapsed_time, st_time = k_uptime_get();
-	k_timeout_t k_timeout;
-
-	k_timeout = SYS_TIMEOUT_MS(timeout);
-
-	/* waiting for release of write lock */
-	if (k_sem_take(&rwlock->wr_sem, k_timeout) == 0) {
-		/* update remaining timeout time for 2nd sem */
-		if (timeout != SYS_FOREVER_MS) {
-			elapsed_time = k_uptime_get() - st_time;
-			timeout = timeout <= elapsed_time ? 0 :
-				  timeout - elapsed_time;
-		}
-
-		k_timeout = SYS_TIMEOUT_MS(timeout);
-
-		/* waiting for reader to complete operation */
-		if (k_sem_take(&rwlock->reader_active, k_timeout) == 0) {
-			rwlock->wr_owner = k_current_get();
-		} else {
-			k_sem_give(&rwlock->wr_sem);
-			ret = EBUSY;
-		}
-
-	} else {
-		ret = EBUSY;
-	}
-	return ret;
+	return ret == 0 ? 0 : EPERM;
 }
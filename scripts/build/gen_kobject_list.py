@@ -107,6 +107,8 @@ kobjects = OrderedDict([
     ("sys_mutex", (None, True, False)),
     ("k_futex", (None, True, False)),
     ("k_condvar", (None, False, True)),
+    ("k_rwlock", (None, False, True)),
+    ("k_rcu", (None, False, True)),
     ("k_event", ("CONFIG_EVENTS", False, True)),
     ("ztest_suite_node", ("CONFIG_ZTEST", True, False)),
     ("ztest_suite_stats", ("CONFIG_ZTEST", True, False)),
@@ -177,6 +179,10 @@ sys_mutex_counter = 0
 futex_counter = 0
 stack_counter = 0
 
+# Kernel object types to be treated as regular structs, so that the kernel
+# objects they contain are found instead
+ignored_kobjects = set()
+
 # Global type environment. Populated by pass 1.
 type_env = {}
 extern_env = {}
@@ -396,7 +402,7 @@ def analyze_die_struct(die):
     if not size:
         return
 
-    if name in kobjects:
+    if name in kobjects and name not in ignored_kobjects:
         type_env[offset] = KobjectType(offset, name, size)
     elif name in subsystems:
         type_env[offset] = KobjectType(offset, name, size, api=True)
@@ -532,6 +538,11 @@ def find_kobjects(elf, syms):
     user_stack_start = syms["z_user_stacks_start"]
     user_stack_end = syms["z_user_stacks_end"]
 
+    # Futex based sys_mutexes are not backed by a k_mutex, the k_futex
+    # inside them is the kernel object
+    if "CONFIG_SYS_MUTEX_FUTEX" in syms:
+        ignored_kobjects.add("sys_mutex")
+
     di = elf.get_dwarf_info()
 
     variables = []
@@ -0,0 +1,122 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2023 Intel Corporation
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""Turn the output of the "perf dump" shell command into folded stacks.
+
+The output has one line per distinct stack, "thread;caller;function count",
+which is what flamegraph.pl and speedscope expect. Addresses are resolved
+with the symbol table of the Zephyr ELF file. Everything in the input that
+is not a perf dump line, e.g. the rest of a console log, is ignored.
+"""
+
+import argparse
+import bisect
+import collections
+import re
+import sys
+
+from elftools.elf.elffile import ELFFile
+
+
+PERF_LINE = re.compile(r"perf: (thread|sample) (.*)$")
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(allow_abbrev=False)
+
+    parser.add_argument("elf", help="Zephyr ELF file (zephyr.elf)")
+    parser.add_argument("infile", nargs="?", default="-",
+            help="Console log containing a perf dump, default stdin")
+    parser.add_argument("--no-thread", action="store_true",
+            help="Do not use the thread as the root of the stacks")
+
+    return parser.parse_args()
+
+
+class Symbols:
+    def __init__(self, path):
+        funcs = []
+
+        with open(path, "rb") as f:
+            elf = ELFFile(f)
+            symtab = elf.get_section_by_name(".symtab")
+            if symtab is None:
+                sys.exit(f"ERROR: {path} has no symbol table")
+
+            for sym in symtab.iter_symbols():
+                if sym["st_info"]["type"] != "STT_FUNC":
+                    continue
+                # Thumb functions have the lowest bit set
+                start = sym["st_value"] & ~1
+                funcs.append((start, start + max(sym["st_size"], 1),
+                              sym.name))
+
+        funcs.sort()
+        self.starts = [func[0] for func in funcs]
+        self.funcs = funcs
+
+    def lookup(self, addr):
+        i = bisect.bisect_right(self.starts, addr) - 1
+        if i >= 0:
+            start, end, name = self.funcs[i]
+            if addr < end:
+                return name
+
+        return f"0x{addr:x}"
+
+
+def main():
+    args = parse_args()
+    symbols = Symbols(args.elf)
+
+    infile = sys.stdin if args.infile == "-" else open(args.infile, "r")
+
+    threads = {0: "[interrupts]"}
+    samples = []
+
+    for line in infile:
+        m = PERF_LINE.search(line.strip())
+        if not m:
+            continue
+
+        fields = m.group(2).split(maxsplit=1)
+        if m.group(1) == "thread":
+            addr = int(fields[0], 16)
+            name = fields[1] if len(fields) > 1 else "-"
+            threads[addr] = name if name != "-" else f"0x{addr:x}"
+        else:
+            samples.append([int(field, 16) for field in fields[0:1] +
+                            fields[1].split()])
+
+    stacks = collections.Counter()
+
+    for thread, pc, lr in samples:
+        frames = []
+
+        if not args.no_thread:
+            frames.append(threads.get(thread, f"0x{thread:x}"))
+
+        if pc == 0:
+            # No program counter on this architecture
+            frames.append("[unknown]")
+        else:
+            func = symbols.lookup(pc)
+            # The return address only tells something if the sample
+            # hit a leaf function, which did not save it yet
+            if lr != 0:
+                caller = symbols.lookup(lr & ~1)
+                if caller != func:
+                    frames.append(caller)
+            frames.append(func)
+
+        stacks[";".join(frames)] += 1
+
+    for stack, count in sorted(stacks.items()):
+        print(f"{stack} {count}")
+
+
+if __name__ == "__main__":
+    main()
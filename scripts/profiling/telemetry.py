@@ -0,0 +1,154 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2023 Intel Corporation
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""Decode the binary records written by the thread telemetry subsystem.
+
+The input is the raw byte stream of a telemetry backend: the file written by
+the posix or file system backends, or a capture of the telemetry UART or RTT
+channel. Bytes which are not part of a valid record are skipped, so a capture
+may start in the middle of a record.
+
+For every snapshot, the CPU time of each CPU and the CPU share, switch rate
+and stack usage of each thread since the previous snapshot are printed.
+"""
+
+import argparse
+import struct
+import sys
+
+
+MAGIC = b"ZT"
+VERSION = 1
+
+RECORD_SNAPSHOT = 0
+RECORD_THREAD_NAMES = 1
+
+HDR = struct.Struct("<2sBBHHI")
+SNAPSHOT = struct.Struct("<IIBBH")
+CPU = struct.Struct("<III")
+THREAD = struct.Struct("<IQIIIbB")
+THREAD_NAME = struct.Struct("<IB")
+CRC = struct.Struct("<H")
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(allow_abbrev=False)
+
+    parser.add_argument("infile", nargs="?", default="-",
+            help="Telemetry byte stream, default stdin")
+
+    return parser.parse_args()
+
+
+def crc16_ccitt(data, crc=0xffff):
+    # Same as crc16_ccitt() in lib/os/crc16_sw.c
+    for byte in data:
+        e = (crc ^ byte) & 0xff
+        f = (e ^ (e << 4)) & 0xff
+        crc = ((crc >> 8) ^ (f << 8) ^ (f << 3) ^ (f >> 4)) & 0xffff
+    return crc
+
+
+def records(data):
+    pos = 0
+
+    while True:
+        pos = data.find(MAGIC, pos)
+        if pos < 0 or pos + HDR.size > len(data):
+            return
+
+        _, version, rtype, length, seq, uptime = HDR.unpack_from(data, pos)
+        end = pos + HDR.size + length
+        if version != VERSION or end + CRC.size > len(data):
+            pos += 1
+            continue
+
+        (crc,) = CRC.unpack_from(data, end)
+        if crc != crc16_ccitt(data[pos:end]):
+            pos += 1
+            continue
+
+        yield rtype, seq, uptime, data[pos + HDR.size:end]
+        pos = end + CRC.size
+
+
+class Decoder:
+    def __init__(self):
+        self.names = {}
+        self.prev = {}
+
+    def names_record(self, payload):
+        pos = 0
+        while pos + THREAD_NAME.size <= len(payload):
+            tid, length = THREAD_NAME.unpack_from(payload, pos)
+            pos += THREAD_NAME.size
+            self.names[tid] = payload[pos:pos + length].decode(errors="replace")
+            pos += length
+
+    def snapshot_record(self, uptime, payload):
+        hz, interval, num_cpus, num_threads, dropped = \
+            SNAPSHOT.unpack_from(payload)
+        pos = SNAPSHOT.size
+
+        interval_ms = interval * 1000 / hz if hz else 0
+        print(f"[{uptime / 1000:10.3f}] interval {interval_ms:.1f} ms")
+
+        for cpu in range(num_cpus):
+            busy, idle, isr = CPU.unpack_from(payload, pos)
+            pos += CPU.size
+            total = max(interval, 1)
+            print(f"  cpu{cpu} busy {busy * 100 / total:5.1f}% "
+                  f"idle {idle * 100 / total:5.1f}% "
+                  f"isr {isr * 100 / total:5.1f}%")
+
+        print(f"  {'thread':<20} {'cpu':>6} {'switch/s':>9} "
+              f"{'stack':>13} {'prio':>5}")
+
+        prev = self.prev
+        self.prev = {}
+        total = max(interval * num_cpus, 1)
+
+        for _ in range(num_threads):
+            tid, cycles, switches, size, used, prio, _state = \
+                THREAD.unpack_from(payload, pos)
+            pos += THREAD.size
+            self.prev[tid] = (cycles, switches)
+
+            name = self.names.get(tid) or f"0x{tid:08x}"
+            if tid in prev:
+                share = f"{(cycles - prev[tid][0]) * 100 / total:5.1f}%"
+                rate = (switches - prev[tid][1]) * 1000 / max(interval_ms, 1)
+                rate = f"{rate:9.0f}"
+            else:
+                share = f"{'-':>6}"
+                rate = f"{'-':>9}"
+
+            print(f"  {name:<20} {share} {rate} "
+                  f"{used:>6}/{size:<6} {prio:>5}")
+
+        if dropped:
+            print(f"  ({dropped} threads left out)")
+
+
+def main():
+    args = parse_args()
+
+    if args.infile == "-":
+        data = sys.stdin.buffer.read()
+    else:
+        with open(args.infile, "rb") as f:
+            data = f.read()
+
+    decoder = Decoder()
+    for rtype, _seq, uptime, payload in records(data):
+        if rtype == RECORD_SNAPSHOT:
+            decoder.snapshot_record(uptime, payload)
+        elif rtype == RECORD_THREAD_NAMES:
+            decoder.names_record(payload)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/** @file
+ *  @brief Sampling profiler
+ *
+ *  Samples are taken from the expiry function of a kernel timer, which
+ *  runs in the system timer interrupt, and written to a ring buffer
+ *  without taking a lock: that interrupt is the only writer, and the
+ *  buffer is only read back once sampling has been stopped.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/debug/perf.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/util.h>
+#include <errno.h>
+
+static struct perf_sample samples[CONFIG_PROFILING_PERF_BUFFER_SIZE];
+
+/* Number of samples taken since sampling was started */
+static atomic_t taken;
+static atomic_t running;
+
+static void perf_sample_fn(struct k_timer *timer)
+{
+	uint32_t n = (uint32_t)atomic_inc(&taken);
+	struct perf_sample *sample = &samples[n % ARRAY_SIZE(samples)];
+
+	ARG_UNUSED(timer);
+
+	sample->thread = k_current_get();
+	sample->pc = 0U;
+	sample->lr = 0U;
+
+#ifdef CONFIG_ARCH_HAS_PERF_SAMPLE
+	if (!arch_perf_sample_get(&sample->pc, &sample->lr)) {
+		sample->thread = NULL;
+	}
+#endif
+}
+
+static K_TIMER_DEFINE(perf_timer, perf_sample_fn, NULL);
+
+int perf_start(uint32_t frequency)
+{
+	k_timeout_t period;
+
+	if ((frequency == 0U) ||
+	    (frequency > CONFIG_SYS_CLOCK_TICKS_PER_SEC)) {
+		return -EINVAL;
+	}
+
+	if (!atomic_cas(&running, 0, 1)) {
+		return -EALREADY;
+	}
+
+	atomic_set(&taken, 0);
+
+	period = K_TICKS(CONFIG_SYS_CLOCK_TICKS_PER_SEC / frequency);
+	k_timer_start(&perf_timer, period, period);
+
+	return 0;
+}
+
+int perf_stop(void)
+{
+	if (atomic_get(&running) == 0) {
+		return -EALREADY;
+	}
+
+	k_timer_stop(&perf_timer);
+	atomic_set(&running, 0);
+
+	return 0;
+}
+
+uint32_t perf_samples_taken(void)
+{
+	return (uint32_t)atomic_get(&taken);
+}
+
+int perf_foreach(perf_sample_cb_t cb, void *user_data)
+{
+	uint32_t n;
+	uint32_t count;
+
+	if (atomic_get(&running) != 0) {
+		return -EBUSY;
+	}
+
+	n = perf_samples_taken();
+	count = MIN(n, ARRAY_SIZE(samples));
+
+	for (uint32_t i = n - count; i != n; i++) {
+		cb(&samples[i % ARRAY_SIZE(samples)], user_data);
+	}
+
+	return (int)count;
+}
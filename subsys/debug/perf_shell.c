@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/** @file
+ *  @brief Sampling profiler shell commands
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/debug/perf.h>
+#include <stdlib.h>
+
+#define PERF_DEFAULT_FREQ MIN(100, CONFIG_SYS_CLOCK_TICKS_PER_SEC)
+
+struct perf_report {
+	const struct shell *sh;
+	struct k_thread *thread;
+	uint32_t count;
+	uint32_t total;
+	uint32_t listed;
+};
+
+static int perf_parse_freq(const struct shell *sh, size_t argc, char **argv,
+			   size_t idx, uint32_t *freq)
+{
+	*freq = PERF_DEFAULT_FREQ;
+
+	if (argc > idx) {
+		*freq = strtoul(argv[idx], NULL, 10);
+	}
+
+	if ((*freq == 0U) || (*freq > CONFIG_SYS_CLOCK_TICKS_PER_SEC)) {
+		shell_error(sh, "frequency must be between 1 and %d Hz",
+			    CONFIG_SYS_CLOCK_TICKS_PER_SEC);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+static int cmd_perf_start(const struct shell *sh, size_t argc, char **argv)
+{
+	uint32_t freq;
+	int ret;
+
+	ret = perf_parse_freq(sh, argc, argv, 1, &freq);
+	if (ret != 0) {
+		return ret;
+	}
+
+	ret = perf_start(freq);
+	if (ret != 0) {
+		shell_error(sh, "cannot start sampling (%d)", ret);
+	}
+
+	return ret;
+}
+
+static int cmd_perf_stop(const struct shell *sh, size_t argc, char **argv)
+{
+	int ret;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	ret = perf_stop();
+	if (ret != 0) {
+		shell_error(sh, "sampling is not running");
+		return ret;
+	}
+
+	shell_print(sh, "%u samples taken", perf_samples_taken());
+
+	return 0;
+}
+
+static int cmd_perf_record(const struct shell *sh, size_t argc, char **argv)
+{
+	uint32_t duration = strtoul(argv[1], NULL, 10);
+	uint32_t freq;
+	int ret;
+
+	ret = perf_parse_freq(sh, argc, argv, 2, &freq);
+	if (ret != 0) {
+		return ret;
+	}
+
+	ret = perf_start(freq);
+	if (ret != 0) {
+		shell_error(sh, "cannot start sampling (%d)", ret);
+		return ret;
+	}
+
+	k_msleep(duration);
+
+	return cmd_perf_stop(sh, 1, argv);
+}
+
+static void perf_count_cb(const struct perf_sample *sample, void *user_data)
+{
+	struct perf_report *report = user_data;
+
+	if (sample->thread == report->thread) {
+		report->count++;
+	}
+}
+
+static void perf_report_line(struct perf_report *report, const char *name,
+			     const char *usage)
+{
+	report->count = 0U;
+	(void)perf_foreach(perf_count_cb, report);
+
+	if (report->count == 0U) {
+		return;
+	}
+
+	report->listed += report->count;
+
+	shell_print(report->sh, " %-20s %8u %6u%% %s", name, report->count,
+		    (report->count * 100U) / report->total, usage);
+}
+
+static void perf_report_thread(const struct k_thread *cthread,
+			       void *user_data)
+{
+	struct perf_report *report = user_data;
+	struct k_thread *thread = (struct k_thread *)cthread;
+	const char *tname = k_thread_name_get(thread);
+	char name[24];
+	char usage[8] = "";
+
+	if ((tname == NULL) || (tname[0] == '\0')) {
+		snprintk(name, sizeof(name), "%p", thread);
+		tname = name;
+	}
+
+#ifdef CONFIG_SCHED_THREAD_USAGE
+	k_thread_runtime_stats_t rt_stats_thread;
+	k_thread_runtime_stats_t rt_stats_all;
+
+	/* Measured share of the CPU since boot, for comparison */
+	if ((k_thread_runtime_stats_get(thread, &rt_stats_thread) == 0) &&
+	    (k_thread_runtime_stats_all_get(&rt_stats_all) == 0) &&
+	    (rt_stats_all.execution_cycles != 0U)) {
+		snprintk(usage, sizeof(usage), "%3u%%",
+			 (unsigned int)((rt_stats_thread.execution_cycles * 100U) /
+					rt_stats_all.execution_cycles));
+	}
+#endif
+
+	report->thread = thread;
+	perf_report_line(report, tname, usage);
+}
+
+static int cmd_perf_report(const struct shell *sh, size_t argc, char **argv)
+{
+	struct perf_report report = { .sh = sh };
+	int ret;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	ret = perf_foreach(perf_count_cb, &report);
+	if (ret < 0) {
+		shell_error(sh, "sampling is running");
+		return ret;
+	}
+
+	if (ret == 0) {
+		shell_print(sh, "no samples");
+		return 0;
+	}
+
+	report.total = (uint32_t)ret;
+
+	shell_print(sh, " %-20s %8s %7s %s", "thread", "samples", "share",
+		    IS_ENABLED(CONFIG_SCHED_THREAD_USAGE) ? "cpu" : "");
+
+	report.thread = NULL;
+	perf_report_line(&report, "[interrupts]", "");
+
+	k_thread_foreach(perf_report_thread, &report);
+
+	/* Whatever is left was sampled in threads which are gone */
+	if (report.listed != report.total) {
+		shell_print(sh, " %-20s %8u %6u%%", "[exited]",
+			    report.total - report.listed,
+			    ((report.total - report.listed) * 100U) /
+			    report.total);
+	}
+
+	return 0;
+}
+
+static void perf_dump_thread(const struct k_thread *cthread, void *user_data)
+{
+	const struct shell *sh = user_data;
+	const char *tname = k_thread_name_get((k_tid_t)cthread);
+
+	shell_print(sh, "perf: thread %lx %s", (unsigned long)cthread,
+		    ((tname != NULL) && (tname[0] != '\0')) ? tname : "-");
+}
+
+static void perf_dump_sample(const struct perf_sample *sample,
+			     void *user_data)
+{
+	const struct shell *sh = user_data;
+
+	shell_print(sh, "perf: sample %lx %lx %lx",
+		    (unsigned long)sample->thread, (unsigned long)sample->pc,
+		    (unsigned long)sample->lr);
+}
+
+static int cmd_perf_dump(const struct shell *sh, size_t argc, char **argv)
+{
+	int ret;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	ret = perf_foreach(perf_dump_sample, (void *)sh);
+	if (ret < 0) {
+		shell_error(sh, "sampling is running");
+		return ret;
+	}
+
+	k_thread_foreach(perf_dump_thread, (void *)sh);
+	shell_print(sh, "perf: end %d %u", ret, perf_samples_taken());
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_perf,
+	SHELL_CMD_ARG(start, NULL, "Start sampling. [frequency Hz]",
+		      cmd_perf_start, 1, 1),
+	SHELL_CMD(stop, NULL, "Stop sampling.", cmd_perf_stop),
+	SHELL_CMD_ARG(record, NULL,
+		      "Sample for a while. <duration ms> [frequency Hz]",
+		      cmd_perf_record, 2, 1),
+	SHELL_CMD(report, NULL, "Print samples per thread.", cmd_perf_report),
+	SHELL_CMD(dump, NULL,
+		  "Dump samples for scripts/profiling/stackcollapse.py.",
+		  cmd_perf_dump),
+	SHELL_SUBCMD_SET_END /* Array terminated. */
+);
+
+SHELL_CMD_REGISTER(perf, &sub_perf, "Sampling profiler commands", NULL);
@@ -0,0 +1,340 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/** @file
+ *  @brief Thread telemetry
+ *
+ * Snapshots are taken by a thread at the lowest application priority,
+ * woken up by a kernel timer. Threads are walked without locking
+ * interrupts, so that scanning their stacks for the high-water mark
+ * does not delay anything else; the sampled threads pay nothing beyond
+ * the runtime statistics bookkeeping the kernel does anyway.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/debug/telemetry.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/crc.h>
+#include <ksched.h>
+#include <errno.h>
+#include <string.h>
+
+#ifdef CONFIG_THREAD_NAME
+#define TELEMETRY_NAME_MAX_LEN (CONFIG_THREAD_MAX_NAME_LEN - 1)
+#else
+#define TELEMETRY_NAME_MAX_LEN 0
+#endif
+
+#define TELEMETRY_SNAPSHOT_MAX_LEN					\
+	(sizeof(struct telemetry_snapshot) +				\
+	 (CONFIG_MP_MAX_NUM_CPUS * sizeof(struct telemetry_cpu)) +	\
+	 (CONFIG_TELEMETRY_MAX_THREADS * sizeof(struct telemetry_thread)))
+
+#define TELEMETRY_NAMES_MAX_LEN						\
+	(CONFIG_TELEMETRY_MAX_THREADS *					\
+	 (sizeof(struct telemetry_thread_name) + TELEMETRY_NAME_MAX_LEN))
+
+#define TELEMETRY_RECORD_MAX_LEN					\
+	(sizeof(struct telemetry_record_hdr) +				\
+	 MAX(TELEMETRY_SNAPSHOT_MAX_LEN, TELEMETRY_NAMES_MAX_LEN) +	\
+	 sizeof(uint16_t))
+
+BUILD_ASSERT(TELEMETRY_RECORD_MAX_LEN <= UINT16_MAX,
+	     "telemetry record length does not fit its header");
+
+struct telemetry_collect {
+	uint8_t *pos;
+	uint16_t threads;
+	uint16_t dropped;
+	/* Identifies the set of threads */
+	uint32_t hash;
+};
+
+/* Per CPU cycle counts at the previous snapshot */
+struct telemetry_cpu_prev {
+	uint64_t busy;
+	uint64_t idle;
+};
+
+static K_MUTEX_DEFINE(telemetry_lock);
+static uint8_t record[TELEMETRY_RECORD_MAX_LEN];
+static uint16_t record_seq;
+static uint32_t last_stamp;
+static uint32_t names_hash;
+static struct telemetry_cpu_prev cpu_prev[CONFIG_MP_MAX_NUM_CPUS];
+
+static K_SEM_DEFINE(telemetry_sem, 0, 1);
+static atomic_t telemetry_running;
+
+static void telemetry_collect_cpus(uint8_t *pos, uint32_t now,
+				   uint32_t interval)
+{
+	unsigned int num_cpus = arch_num_cpus();
+
+	/* Stay on this CPU while comparing against it */
+	k_sched_lock();
+
+	for (unsigned int i = 0; i < num_cpus; i++) {
+		struct _cpu *cpu = &_kernel.cpus[i];
+		k_thread_runtime_stats_t stats;
+		struct telemetry_cpu entry;
+		uint32_t busy, idle, start;
+
+		z_sched_cpu_usage(i, &stats);
+
+		/* Only the current CPU brings the usage of the thread it
+		 * runs up to date. For the others, count what has been
+		 * running since their last context switch, and remember
+		 * it was counted.
+		 */
+		start = cpu->usage0;
+		if ((cpu != _current_cpu) && (start != 0U)) {
+			if (cpu->current == cpu->idle_thread) {
+				stats.idle_cycles += now - start;
+			} else {
+				stats.total_cycles += now - start;
+			}
+		}
+
+		busy = (uint32_t)(stats.total_cycles - cpu_prev[i].busy);
+		idle = (uint32_t)(stats.idle_cycles - cpu_prev[i].idle);
+		cpu_prev[i].busy = stats.total_cycles;
+		cpu_prev[i].idle = stats.idle_cycles;
+
+		if (pos == NULL) {
+			continue;
+		}
+
+		entry.busy = sys_cpu_to_le32(busy);
+		entry.idle = sys_cpu_to_le32(idle);
+		entry.isr = sys_cpu_to_le32(((busy + idle) < interval) ?
+					    interval - (busy + idle) : 0U);
+		memcpy(pos, &entry, sizeof(entry));
+		pos += sizeof(entry);
+	}
+
+	k_sched_unlock();
+}
+
+static void telemetry_collect_thread(const struct k_thread *cthread,
+				     void *user_data)
+{
+	struct telemetry_collect *collect = user_data;
+	struct k_thread *thread = (struct k_thread *)cthread;
+	struct telemetry_thread entry = { 0 };
+	k_thread_runtime_stats_t stats;
+	uint32_t id = (uint32_t)(uintptr_t)thread;
+	size_t unused;
+
+	if (collect->threads == CONFIG_TELEMETRY_MAX_THREADS) {
+		collect->dropped++;
+		return;
+	}
+
+	collect->threads++;
+	collect->hash = (collect->hash * 31U) + id;
+
+	entry.id = sys_cpu_to_le32(id);
+
+	if (k_thread_runtime_stats_get(thread, &stats) == 0) {
+		entry.cycles = sys_cpu_to_le64(stats.execution_cycles);
+	}
+
+#ifdef CONFIG_SCHED_THREAD_USAGE_ANALYSIS
+	entry.switches = sys_cpu_to_le32(thread->base.usage.num_windows);
+#endif
+
+	entry.stack_size = sys_cpu_to_le32(thread->stack_info.size);
+	if (k_thread_stack_space_get(thread, &unused) == 0) {
+		entry.stack_used =
+			sys_cpu_to_le32(thread->stack_info.size - unused);
+	}
+
+	entry.prio = (int8_t)thread->base.prio;
+	entry.state = thread->base.thread_state;
+
+	memcpy(collect->pos, &entry, sizeof(entry));
+	collect->pos += sizeof(entry);
+}
+
+#ifdef CONFIG_THREAD_NAME
+static void telemetry_collect_name(const struct k_thread *cthread,
+				   void *user_data)
+{
+	struct telemetry_collect *collect = user_data;
+	struct telemetry_thread_name entry;
+	const char *name = k_thread_name_get((k_tid_t)cthread);
+
+	if (collect->threads == CONFIG_TELEMETRY_MAX_THREADS) {
+		return;
+	}
+
+	collect->threads++;
+
+	entry.id = sys_cpu_to_le32((uint32_t)(uintptr_t)cthread);
+	entry.len = (name != NULL) ? strnlen(name, TELEMETRY_NAME_MAX_LEN) : 0U;
+
+	memcpy(collect->pos, &entry, sizeof(entry));
+	collect->pos += sizeof(entry);
+
+	if (entry.len > 0U) {
+		memcpy(collect->pos, name, entry.len);
+		collect->pos += entry.len;
+	}
+}
+#endif
+
+static void telemetry_emit(uint8_t type, size_t length)
+{
+	struct telemetry_record_hdr hdr = {
+		.magic = { TELEMETRY_MAGIC0, TELEMETRY_MAGIC1 },
+		.version = TELEMETRY_VERSION,
+		.type = type,
+		.length = sys_cpu_to_le16(length),
+		.seq = sys_cpu_to_le16(record_seq),
+		.uptime = sys_cpu_to_le32(k_uptime_get_32()),
+	};
+
+	record_seq++;
+	length += sizeof(hdr);
+
+	memcpy(record, &hdr, sizeof(hdr));
+	sys_put_le16(crc16_ccitt(0xffff, record, length), &record[length]);
+	length += sizeof(uint16_t);
+
+	STRUCT_SECTION_FOREACH(telemetry_backend, backend) {
+		backend->api->output(backend, record, length);
+	}
+}
+
+int telemetry_snapshot(void)
+{
+	uint8_t *payload = &record[sizeof(struct telemetry_record_hdr)];
+	struct telemetry_collect collect = { 0 };
+	struct telemetry_snapshot snap;
+	unsigned int num_cpus = arch_num_cpus();
+	uint32_t now, interval;
+	int count;
+
+	STRUCT_SECTION_COUNT(telemetry_backend, &count);
+	if (count == 0) {
+		return -ENODEV;
+	}
+
+	k_mutex_lock(&telemetry_lock, K_FOREVER);
+
+	now = k_cycle_get_32();
+	interval = now - last_stamp;
+	last_stamp = now;
+
+	telemetry_collect_cpus(payload + sizeof(snap), now, interval);
+
+	collect.pos = payload + sizeof(snap) +
+		      (num_cpus * sizeof(struct telemetry_cpu));
+	k_thread_foreach_unlocked(telemetry_collect_thread, &collect);
+
+	snap.cycles_per_sec = sys_cpu_to_le32(sys_clock_hw_cycles_per_sec());
+	snap.interval = sys_cpu_to_le32(interval);
+	snap.num_cpus = num_cpus;
+	snap.num_threads = collect.threads;
+	snap.dropped = sys_cpu_to_le16(collect.dropped);
+	memcpy(payload, &snap, sizeof(snap));
+
+	telemetry_emit(TELEMETRY_RECORD_SNAPSHOT, collect.pos - payload);
+
+#ifdef CONFIG_THREAD_NAME
+	/* Names only go out when threads come or go */
+	if (collect.hash != names_hash) {
+		names_hash = collect.hash;
+
+		collect.pos = payload;
+		collect.threads = 0U;
+		k_thread_foreach_unlocked(telemetry_collect_name, &collect);
+
+		telemetry_emit(TELEMETRY_RECORD_THREAD_NAMES,
+			       collect.pos - payload);
+	}
+#endif
+
+	k_mutex_unlock(&telemetry_lock);
+
+	return 0;
+}
+
+static void telemetry_timer_expiry(struct k_timer *timer)
+{
+	k_sem_give(&telemetry_sem);
+}
+
+static K_TIMER_DEFINE(telemetry_timer, telemetry_timer_expiry, NULL);
+
+int telemetry_start(uint32_t period_ms)
+{
+	/* Cycle counts in snapshots are 32-bit */
+	if ((period_ms == 0U) ||
+	    (k_ms_to_cyc_ceil64(period_ms) > UINT32_MAX)) {
+		return -EINVAL;
+	}
+
+	if (!atomic_cas(&telemetry_running, 0, 1)) {
+		return -EALREADY;
+	}
+
+	k_timer_start(&telemetry_timer, K_MSEC(period_ms), K_MSEC(period_ms));
+
+	return 0;
+}
+
+int telemetry_stop(void)
+{
+	if (!atomic_cas(&telemetry_running, 1, 0)) {
+		return -EALREADY;
+	}
+
+	k_timer_stop(&telemetry_timer);
+
+	return 0;
+}
+
+static void telemetry_thread(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		k_sem_take(&telemetry_sem, K_FOREVER);
+		(void)telemetry_snapshot();
+	}
+}
+
+K_THREAD_DEFINE(telemetry, CONFIG_TELEMETRY_STACK_SIZE, telemetry_thread,
+		NULL, NULL, NULL, K_LOWEST_APPLICATION_THREAD_PRIO, 0, 0);
+
+static int telemetry_init(void)
+{
+	STRUCT_SECTION_FOREACH(telemetry_backend, backend) {
+		if (backend->api->init != NULL) {
+			(void)backend->api->init(backend);
+		}
+	}
+
+	/* The first snapshot covers the time since now */
+	k_mutex_lock(&telemetry_lock, K_FOREVER);
+	last_stamp = k_cycle_get_32();
+	telemetry_collect_cpus(NULL, last_stamp, 0U);
+	k_mutex_unlock(&telemetry_lock);
+
+	if (CONFIG_TELEMETRY_PERIOD > 0) {
+		return telemetry_start(CONFIG_TELEMETRY_PERIOD);
+	}
+
+	return 0;
+}
+
+SYS_INIT(telemetry_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/fs/fs.h>
+#include <zephyr/debug/telemetry.h>
+
+static struct fs_file_t telemetry_file;
+static bool telemetry_file_open;
+
+static void telemetry_backend_fs_output(const struct telemetry_backend *backend,
+					const uint8_t *data, size_t length)
+{
+	ARG_UNUSED(backend);
+
+	/* The file system is usually mounted by the application, after
+	 * the backends were initialized, so open the file on first use
+	 */
+	if (!telemetry_file_open) {
+		fs_file_t_init(&telemetry_file);
+		if (fs_open(&telemetry_file, CONFIG_TELEMETRY_BACKEND_FS_FILE,
+			    FS_O_CREATE | FS_O_WRITE | FS_O_APPEND) != 0) {
+			return;
+		}
+		telemetry_file_open = true;
+	}
+
+	if (fs_write(&telemetry_file, data, length) == (ssize_t)length) {
+		(void)fs_sync(&telemetry_file);
+	}
+}
+
+static const struct telemetry_backend_api telemetry_backend_fs_api = {
+	.output = telemetry_backend_fs_output,
+};
+
+TELEMETRY_BACKEND_DEFINE(telemetry_backend_fs, telemetry_backend_fs_api);
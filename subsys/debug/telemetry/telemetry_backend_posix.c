@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <soc.h>
+#include <stdio.h>
+#include <errno.h>
+#include <zephyr/kernel.h>
+#include <zephyr/arch/posix/posix_trace.h>
+#include <cmdline.h>
+#include <zephyr/debug/telemetry.h>
+
+static FILE *out_stream;
+static const char *file_name;
+
+static int telemetry_backend_posix_init(const struct telemetry_backend *backend)
+{
+	ARG_UNUSED(backend);
+
+	if (file_name == NULL) {
+		file_name = "telemetry.bin";
+	}
+
+	out_stream = fopen(file_name, "wb");
+	if (out_stream == NULL) {
+		posix_print_warning("Cannot open telemetry file %s\n",
+				    file_name);
+		return -EIO;
+	}
+
+	return 0;
+}
+
+static void telemetry_backend_posix_output(const struct telemetry_backend *backend,
+					   const uint8_t *data, size_t length)
+{
+	ARG_UNUSED(backend);
+
+	if (out_stream == NULL) {
+		return;
+	}
+
+	fwrite(data, length, 1, out_stream);
+	fflush(out_stream);
+}
+
+static const struct telemetry_backend_api telemetry_backend_posix_api = {
+	.init = telemetry_backend_posix_init,
+	.output = telemetry_backend_posix_output,
+};
+
+TELEMETRY_BACKEND_DEFINE(telemetry_backend_posix, telemetry_backend_posix_api);
+
+static void telemetry_backend_posix_option(void)
+{
+	static struct args_struct_t telemetry_backend_option[] = {
+		{
+			.manual = false,
+			.is_mandatory = false,
+			.is_switch = false,
+			.option = "telemetry-file",
+			.name = "file_name",
+			.type = 's',
+			.dest = (void *)&file_name,
+			.call_when_found = NULL,
+			.descript = "File name for telemetry output.",
+		},
+		ARG_TABLE_ENDMARKER
+	};
+
+	native_add_command_line_opts(telemetry_backend_option);
+}
+
+NATIVE_TASK(telemetry_backend_posix_option, PRE_BOOT_1, 1);
@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/debug/telemetry.h>
+#include <SEGGER_RTT.h>
+
+static uint8_t rtt_up_buf[CONFIG_TELEMETRY_BACKEND_RTT_BUFFER_SIZE];
+
+static int telemetry_backend_rtt_init(const struct telemetry_backend *backend)
+{
+	ARG_UNUSED(backend);
+
+	/* Records which do not fit are dropped whole, the host only ever
+	 * sees complete ones
+	 */
+	SEGGER_RTT_ConfigUpBuffer(CONFIG_TELEMETRY_BACKEND_RTT_BUFFER,
+				  "telemetry", rtt_up_buf, sizeof(rtt_up_buf),
+				  SEGGER_RTT_MODE_NO_BLOCK_SKIP);
+
+	return 0;
+}
+
+static void telemetry_backend_rtt_output(const struct telemetry_backend *backend,
+					 const uint8_t *data, size_t length)
+{
+	ARG_UNUSED(backend);
+
+	(void)SEGGER_RTT_Write(CONFIG_TELEMETRY_BACKEND_RTT_BUFFER, data,
+			       length);
+}
+
+static const struct telemetry_backend_api telemetry_backend_rtt_api = {
+	.init = telemetry_backend_rtt_init,
+	.output = telemetry_backend_rtt_output,
+};
+
+TELEMETRY_BACKEND_DEFINE(telemetry_backend_rtt, telemetry_backend_rtt_api);
@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/uart.h>
+#include <zephyr/debug/telemetry.h>
+#include <errno.h>
+
+static const struct device *const telemetry_uart_dev =
+	DEVICE_DT_GET(DT_CHOSEN(zephyr_telemetry_uart));
+
+static int telemetry_backend_uart_init(const struct telemetry_backend *backend)
+{
+	ARG_UNUSED(backend);
+
+	if (!device_is_ready(telemetry_uart_dev)) {
+		return -ENODEV;
+	}
+
+	return 0;
+}
+
+static void telemetry_backend_uart_output(const struct telemetry_backend *backend,
+					  const uint8_t *data, size_t length)
+{
+	ARG_UNUSED(backend);
+
+	for (size_t i = 0; i < length; i++) {
+		uart_poll_out(telemetry_uart_dev, data[i]);
+	}
+}
+
+static const struct telemetry_backend_api telemetry_backend_uart_api = {
+	.init = telemetry_backend_uart_init,
+	.output = telemetry_backend_uart_output,
+};
+
+TELEMETRY_BACKEND_DEFINE(telemetry_backend_uart, telemetry_backend_uart_api);
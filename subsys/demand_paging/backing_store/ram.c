@@ -25,25 +25,21 @@
  * 2) A backing store that has limited storage space, and is not sufficiently
  *    large to hold clean copies of all mapped memory.
  *
- * This backing store is an example of the latter case. However, locations
- * are freed as soon as pages are paged in, in
- * k_mem_paging_backing_store_page_finalize().
- * This implies that all data pages are treated as dirty as
- * Z_PAGE_FRAME_BACKED is never set, even if the data page was paged out before
- * and not modified since then.
+ * This backing store is an example of the latter case. Without the page
+ * cleaner, locations are freed as soon as pages are paged in, in
+ * k_mem_paging_backing_store_page_finalize(), so all data pages are treated
+ * as dirty.
  *
- * An optimization a real backing store will want is have
- * k_mem_paging_backing_store_page_finalize() note the storage location of
- * a paged-in data page in a custom field of its associated z_page_frame, and
- * set the Z_PAGE_FRAME_BACKED bit. Invocations of
- * k_mem_paging_backing_store_location_get() will have logic to return
- * the previous clean page location instead of allocating
- * a new one if Z_PAGE_FRAME_BACKED is set.
+ * With CONFIG_DEMAND_PAGING_PAGE_CLEANER, locations are not freed when pages
+ * are paged in: k_mem_paging_backing_store_page_finalize() notes the storage
+ * location of a paged-in data page and sets the Z_PAGE_FRAME_BACKED bit, so
+ * that it can later be evicted without being written out if it wasn't
+ * modified. The page cleaner also leaves clean copies of still loaded data
+ * pages behind.
  *
- * This will, however, require the implementation of a clean page
- * eviction algorithm, to free backing store locations for loaded data pages
- * as the backing store fills up, and clear the Z_PAGE_FRAME_BACKED bit
- * appropriately.
+ * When the backing store is full, the location of a clean copy is taken
+ * back from its page frame, clearing its Z_PAGE_FRAME_BACKED bit. Free
+ * locations and clean copies together always leave room for a page fault.
  *
  * All of this logic is local to the backing store implementation; from the
  * core kernel's perspective the only change is that Z_PAGE_FRAME_BACKED
@@ -55,6 +51,14 @@ static char backing_store[CONFIG_MMU_PAGE_SIZE *
 static struct k_mem_slab backing_slabs;
 static unsigned int free_slabs;
 
+/* Location of the clean copy of each page frame with Z_PAGE_FRAME_BACKED */
+static uintptr_t frame_location[Z_NUM_PAGE_FRAMES];
+
+static inline size_t frame_index(struct z_page_frame *pf)
+{
+	return pf - z_page_frames;
+}
+
 static void *location_to_slab(uintptr_t location)
 {
 	__ASSERT(location % CONFIG_MMU_PAGE_SIZE == 0,
@@ -81,6 +85,43 @@ static uintptr_t slab_to_location(void *slab)
 	return offset;
 }
 
+static bool clean_copy_reclaimable(struct z_page_frame *pf)
+{
+	return z_page_frame_is_backed(pf) && z_page_frame_is_mapped(pf) &&
+	       !z_page_frame_is_busy(pf);
+}
+
+static unsigned int clean_copies_count(void)
+{
+	uintptr_t phys;
+	struct z_page_frame *pf;
+	unsigned int count = 0U;
+
+	Z_PAGE_FRAME_FOREACH(phys, pf) {
+		if (clean_copy_reclaimable(pf)) {
+			count++;
+		}
+	}
+
+	return count;
+}
+
+static bool clean_copy_reclaim(uintptr_t *location)
+{
+	uintptr_t phys;
+	struct z_page_frame *pf;
+
+	Z_PAGE_FRAME_FOREACH(phys, pf) {
+		if (clean_copy_reclaimable(pf)) {
+			pf->flags &= ~Z_PAGE_FRAME_BACKED;
+			*location = frame_location[frame_index(pf)];
+			return true;
+		}
+	}
+
+	return false;
+}
+
 int k_mem_paging_backing_store_location_get(struct z_page_frame *pf,
 					    uintptr_t *location,
 					    bool page_fault)
@@ -88,15 +129,31 @@ int k_mem_paging_backing_store_location_get(struct z_page_frame *pf,
 	int ret;
 	void *slab;
 
-	if ((!page_fault && free_slabs == 1) || free_slabs == 0) {
+	if (z_page_frame_is_backed(pf)) {
+		/* Using up a clean copy must still leave room for a
+		 * page fault
+		 */
+		if (!page_fault && (free_slabs + clean_copies_count()) < 2U) {
+			return -ENOMEM;
+		}
+
+		*location = frame_location[frame_index(pf)];
+		return 0;
+	}
+
+	if (free_slabs > (page_fault ? 0U : 1U)) {
+		ret = k_mem_slab_alloc(&backing_slabs, &slab, K_NO_WAIT);
+		__ASSERT(ret == 0, "slab count mismatch");
+		(void)ret;
+		*location = slab_to_location(slab);
+		free_slabs--;
+	} else if (!page_fault && (free_slabs + clean_copies_count()) < 2U) {
+		return -ENOMEM;
+	} else if (!clean_copy_reclaim(location)) {
 		return -ENOMEM;
 	}
 
-	ret = k_mem_slab_alloc(&backing_slabs, &slab, K_NO_WAIT);
-	__ASSERT(ret == 0, "slab count mismatch");
-	(void)ret;
-	*location = slab_to_location(slab);
-	free_slabs--;
+	frame_location[frame_index(pf)] = *location;
 
 	return 0;
 }
@@ -115,6 +172,19 @@ void k_mem_paging_backing_store_page_out(uintptr_t location)
 		     CONFIG_MMU_PAGE_SIZE);
 }
 
+void k_mem_paging_backing_store_page_out_batch(struct z_page_frame *const *pfs,
+					       const uintptr_t *locations,
+					       size_t count)
+{
+	/* The data pages are still mapped, no need to go through the
+	 * scratch page
+	 */
+	for (size_t i = 0; i < count; i++) {
+		(void)memcpy(location_to_slab(locations[i]), pfs[i]->addr,
+			     CONFIG_MMU_PAGE_SIZE);
+	}
+}
+
 void k_mem_paging_backing_store_page_in(uintptr_t location)
 {
 	(void)memcpy(Z_SCRATCH_PAGE, location_to_slab(location),
@@ -124,7 +194,13 @@ void k_mem_paging_backing_store_page_in(uintptr_t location)
 void k_mem_paging_backing_store_page_finalize(struct z_page_frame *pf,
 					      uintptr_t location)
 {
+#ifdef CONFIG_DEMAND_PAGING_PAGE_CLEANER
+	/* Keep the data page as a clean copy */
+	frame_location[frame_index(pf)] = location;
+	pf->flags |= Z_PAGE_FRAME_BACKED;
+#else
 	k_mem_paging_backing_store_location_free(location);
+#endif
 }
 
 void k_mem_paging_backing_store_init(void)
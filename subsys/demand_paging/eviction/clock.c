@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * CLOCK eviction algorithm for demand paging, with working set tracking
+ */
+#include <zephyr/kernel.h>
+#include <mmu.h>
+#include <kernel_arch_interface.h>
+
+/* Page frames are treated as a circular list swept by a clock hand. Every
+ * frame the hand passes has its accessed state sampled and cleared, and if
+ * it was set, the current time is recorded as the last time the frame was
+ * referenced. A frame referenced within the working set window is part of
+ * the working set and is only evicted as a last resort.
+ *
+ * When selecting a page to evict, the hand stops at the first clean page
+ * outside of the working set. Dirty pages outside of the working set come
+ * next, since they cost a page-out. If the whole working set fits in
+ * memory this is enough; otherwise the least recently referenced page is
+ * evicted.
+ *
+ * Unlike the NRU algorithm, nothing is done periodically: the hand only
+ * moves when a page needs to be evicted, and usually not very far.
+ */
+
+/* Time, in ticks, each page frame was last seen referenced */
+static uint32_t last_ref[Z_NUM_PAGE_FRAMES];
+
+/* Index of the next page frame to look at */
+static size_t hand;
+
+struct z_page_frame *k_mem_paging_eviction_select(bool *dirty_ptr)
+{
+	uint32_t now = (uint32_t)k_uptime_ticks();
+	uint32_t window = k_ms_to_ticks_ceil32(CONFIG_EVICTION_CLOCK_WORKING_SET);
+	struct z_page_frame *dirty_pf = NULL, *oldest_pf = NULL, *pf;
+	bool oldest_dirty = false;
+	uint32_t oldest_age = 0U;
+	uintptr_t flags;
+
+	for (size_t n = 0; n < Z_NUM_PAGE_FRAMES; n++) {
+		size_t idx = hand;
+		uint32_t age;
+		bool dirty;
+
+		hand = (hand + 1U) % Z_NUM_PAGE_FRAMES;
+		pf = &z_page_frames[idx];
+
+		if (!z_page_frame_is_evictable(pf)) {
+			continue;
+		}
+
+		/* Sample and clear the accessed state in one go */
+		flags = arch_page_info_get(pf->addr, NULL, true);
+		dirty = (flags & ARCH_DATA_PAGE_DIRTY) != 0UL;
+
+		/* Implies a mismatch with page frame ontology and page
+		 * tables
+		 */
+		__ASSERT((flags & ARCH_DATA_PAGE_LOADED) != 0U,
+			 "non-present page, %s",
+			 ((flags & ARCH_DATA_PAGE_NOT_MAPPED) != 0U) ?
+			 "un-mapped" : "paged out");
+
+		if ((flags & ARCH_DATA_PAGE_ACCESSED) != 0UL) {
+			/* Second chance */
+			last_ref[idx] = now;
+		}
+
+		age = now - last_ref[idx];
+		if (age >= window) {
+			if (!dirty) {
+				/* Clean and outside of the working set */
+				*dirty_ptr = false;
+				return pf;
+			}
+
+			if (dirty_pf == NULL) {
+				dirty_pf = pf;
+			}
+		}
+
+		if ((oldest_pf == NULL) || (age > oldest_age)) {
+			oldest_pf = pf;
+			oldest_age = age;
+			oldest_dirty = dirty;
+		}
+	}
+
+	if (dirty_pf != NULL) {
+		*dirty_ptr = true;
+		return dirty_pf;
+	}
+
+	/* Shouldn't ever happen unless every page is pinned */
+	__ASSERT(oldest_pf != NULL, "no page to evict");
+
+	*dirty_ptr = oldest_dirty;
+
+	return oldest_pf;
+}
+
+void k_mem_paging_eviction_init(void)
+{
+}
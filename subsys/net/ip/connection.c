@@ -18,6 +18,7 @@ LOG_MODULE_REGISTER(net_conn, CONFIG_NET_CONN_LOG_LEVEL);
 
 #include <errno.h>
 #include <zephyr/sys/util.h>
+#include <zephyr/sys/hash_function.h>
 
 #include <zephyr/net/net_core.h>
 #include <zephyr/net/net_pkt.h>
@@ -59,11 +60,87 @@ LOG_MODULE_REGISTER(net_conn, CONFIG_NET_CONN_LOG_LEVEL);
 
 #define NET_CONN_RANK(_flags)		(_flags & 0x78)
 
+/** Both addresses and ports specified, the connection only matches one
+ * 4-tuple.
+ */
+#define NET_CONN_RANK_FULL		0x78
+
 static struct net_conn conns[CONFIG_NET_MAX_CONN];
 
 static sys_slist_t conn_unused;
 static sys_slist_t conn_used;
 
+/* Connections net_conn_input() has to check one by one */
+static sys_slist_t conn_scan;
+
+#if defined(CONFIG_NET_CONN_HASH)
+/* Connections matching a single UDP or TCP 4-tuple, by hash of the tuple */
+static sys_slist_t conn_hash[CONFIG_NET_CONN_HASH_BUCKETS];
+
+struct conn_hash_key {
+	uint8_t remote[NET_IPV6_ADDR_SIZE];
+	uint8_t local[NET_IPV6_ADDR_SIZE];
+	uint16_t remote_port;
+	uint16_t local_port;
+	uint8_t proto;
+	uint8_t family;
+} __packed;
+
+/* Addresses and ports in network byte order */
+static sys_slist_t *conn_hash_bucket(uint8_t proto, uint8_t family,
+				     const uint8_t *remote,
+				     const uint8_t *local,
+				     uint16_t remote_port,
+				     uint16_t local_port)
+{
+	size_t addr_len = (family == AF_INET6) ? NET_IPV6_ADDR_SIZE :
+						 NET_IPV4_ADDR_SIZE;
+	struct conn_hash_key key = {
+		.remote_port = remote_port,
+		.local_port = local_port,
+		.proto = proto,
+		.family = family,
+	};
+
+	memcpy(key.remote, remote, addr_len);
+	memcpy(key.local, local, addr_len);
+
+	return &conn_hash[sys_hash32_murmur3(&key, sizeof(key)) %
+			  CONFIG_NET_CONN_HASH_BUCKETS];
+}
+
+static const uint8_t *conn_addr_raw(struct sockaddr *addr)
+{
+	if (IS_ENABLED(CONFIG_NET_IPV6) && addr->sa_family == AF_INET6) {
+		return (const uint8_t *)&net_sin6(addr)->sin6_addr;
+	}
+
+	return (const uint8_t *)&net_sin(addr)->sin_addr;
+}
+
+static bool conn_is_hashed(struct net_conn *conn)
+{
+	return (conn->proto == IPPROTO_UDP || conn->proto == IPPROTO_TCP) &&
+	       (conn->family == AF_INET || conn->family == AF_INET6) &&
+	       NET_CONN_RANK(conn->flags) == NET_CONN_RANK_FULL;
+}
+#endif /* CONFIG_NET_CONN_HASH */
+
+static sys_slist_t *conn_demux_list(struct net_conn *conn)
+{
+#if defined(CONFIG_NET_CONN_HASH)
+	if (conn_is_hashed(conn)) {
+		return conn_hash_bucket(conn->proto, conn->family,
+					conn_addr_raw(&conn->remote_addr),
+					conn_addr_raw(&conn->local_addr),
+					net_sin(&conn->remote_addr)->sin_port,
+					net_sin(&conn->local_addr)->sin_port);
+	}
+#endif
+
+	return &conn_scan;
+}
+
 #if (CONFIG_NET_CONN_LOG_LEVEL >= LOG_LEVEL_DBG)
 static inline
 void conn_register_debug(struct net_conn *conn,
@@ -141,6 +218,7 @@ static void conn_set_used(struct net_conn *conn)
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 	sys_slist_prepend(&conn_used, &conn->node);
+	sys_slist_prepend(conn_demux_list(conn), &conn->demux_node);
 	k_mutex_unlock(&conn_lock);
 }
 
@@ -397,6 +475,7 @@ int net_conn_unregister(struct net_conn_handle *handle)
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 	sys_slist_find_and_remove(&conn_used, &conn->node);
+	sys_slist_find_and_remove(conn_demux_list(conn), &conn->demux_node);
 	k_mutex_unlock(&conn_lock);
 
 	conn_set_unused(conn);
@@ -477,6 +556,52 @@ static bool conn_addr_cmp(struct net_pkt *pkt,
 	return true;
 }
 
+#if defined(CONFIG_NET_CONN_HASH)
+/* Look for the connection bound to the 4-tuple of a unicast packet */
+static struct net_conn *conn_hash_find(struct net_pkt *pkt,
+				       union net_ip_header *ip_hdr,
+				       uint8_t proto, uint16_t src_port,
+				       uint16_t dst_port)
+{
+	uint8_t family = net_pkt_family(pkt);
+	const uint8_t *src, *dst;
+	size_t addr_len;
+	struct net_conn *conn;
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && family == AF_INET6) {
+		src = ip_hdr->ipv6->src;
+		dst = ip_hdr->ipv6->dst;
+		addr_len = NET_IPV6_ADDR_SIZE;
+	} else {
+		src = ip_hdr->ipv4->src;
+		dst = ip_hdr->ipv4->dst;
+		addr_len = NET_IPV4_ADDR_SIZE;
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(conn_hash_bucket(proto, family, src, dst,
+						      src_port, dst_port),
+				     conn, demux_node) {
+		if (conn->proto != proto || conn->family != family ||
+		    net_sin(&conn->remote_addr)->sin_port != src_port ||
+		    net_sin(&conn->local_addr)->sin_port != dst_port ||
+		    memcmp(conn_addr_raw(&conn->remote_addr), src, addr_len) ||
+		    memcmp(conn_addr_raw(&conn->local_addr), dst, addr_len)) {
+			continue;
+		}
+
+		if (conn->context != NULL &&
+		    net_context_is_bound_to_iface(conn->context) &&
+		    net_pkt_iface(pkt) != net_context_get_iface(conn->context)) {
+			continue; /* wrong interface */
+		}
+
+		return conn;
+	}
+
+	return NULL;
+}
+#endif /* CONFIG_NET_CONN_HASH */
+
 static inline void conn_send_icmp_error(struct net_pkt *pkt)
 {
 	if (IS_ENABLED(CONFIG_NET_DISABLE_ICMP_DESTINATION_UNREACHABLE)) {
@@ -634,7 +759,23 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		}
 	}
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&conn_used, conn, node) {
+#if defined(CONFIG_NET_CONN_HASH)
+	/* A connection bound to the 4-tuple of the packet is the best
+	 * possible match, only look further if there is none.
+	 */
+	if (IS_ENABLED(CONFIG_NET_IP) &&
+	    (pkt_family == AF_INET || pkt_family == AF_INET6) &&
+	    (proto == IPPROTO_UDP || proto == IPPROTO_TCP) &&
+	    !is_mcast_pkt && !is_bcast_pkt) {
+		best_match = conn_hash_find(pkt, ip_hdr, proto, src_port,
+					    dst_port);
+		if (best_match) {
+			goto deliver;
+		}
+	}
+#endif
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&conn_scan, conn, demux_node) {
 		/* Is the candidate connection matching the packet's interface? */
 		if (conn->context != NULL &&
 		    net_context_is_bound_to_iface(conn->context) &&
@@ -806,6 +947,9 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		return NET_OK;
 	}
 
+#if defined(CONFIG_NET_CONN_HASH)
+deliver:
+#endif
 	if (best_match) {
 		NET_DBG("[%p] match found cb %p ud %p rank 0x%02x", best_match, best_match->cb,
 			best_match->user_data, best_match->flags);
@@ -856,6 +1000,13 @@ void net_conn_init(void)
 
 	sys_slist_init(&conn_unused);
 	sys_slist_init(&conn_used);
+	sys_slist_init(&conn_scan);
+
+#if defined(CONFIG_NET_CONN_HASH)
+	for (i = 0; i < ARRAY_SIZE(conn_hash); i++) {
+		sys_slist_init(&conn_hash[i]);
+	}
+#endif
 
 	for (i = 0; i < CONFIG_NET_MAX_CONN; i++) {
 		sys_slist_prepend(&conn_unused, &conns[i].node);
@@ -54,6 +54,9 @@ struct net_conn {
 	/** Internal slist node */
 	sys_snode_t node;
 
+	/** Internal slist node of the packet demultiplexing lists */
+	sys_snode_t demux_node;
+
 	/** Remote socket address */
 	struct sockaddr remote_addr;
 
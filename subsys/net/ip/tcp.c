@@ -32,6 +32,7 @@ LOG_MODULE_REGISTER(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
 #define ACK_DELAY K_MSEC(100)
 #define ZWP_MAX_DELAY_MS 120000
 #define DUPLICATE_ACK_RETRANSMIT_TRHESHOLD 3
+#define TCP_RTO_MAX_MS 60000
 
 static int tcp_rto = CONFIG_NET_TCP_INIT_RETRANSMISSION_TIMEOUT;
 static int tcp_retries = CONFIG_NET_TCP_RETRY_COUNT;
@@ -56,7 +57,7 @@ static int tcp_tx_window =
 	CONFIG_NET_BUF_DATA_POOL_SIZE / 3;
 #endif /* CONFIG_NET_BUF_FIXED_DATA_SIZE */
 #endif
-#ifdef CONFIG_NET_TCP_RANDOMIZED_RTO
+#if defined(CONFIG_NET_TCP_RANDOMIZED_RTO) || defined(CONFIG_NET_TCP_TIMESTAMPS)
 #define TCP_RTO_MS (conn->rto)
 #else
 #define TCP_RTO_MS (tcp_rto)
@@ -371,11 +372,23 @@ out:
 
 static void tcp_derive_rto(struct tcp *conn)
 {
+#if defined(CONFIG_NET_TCP_RANDOMIZED_RTO) || defined(CONFIG_NET_TCP_TIMESTAMPS)
+	uint32_t rto = (uint32_t)tcp_rto;
+
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+	/* RFC 6298 section 2.3, with the configured initial RTO as lower
+	 * bound.
+	 */
+	if (conn->srtt != 0U) {
+		rto = CLAMP((conn->srtt >> 3) + MAX(conn->rttvar, 1U), rto,
+			    TCP_RTO_MAX_MS);
+	}
+#endif
+
 #ifdef CONFIG_NET_TCP_RANDOMIZED_RTO
-	/* Compute a randomized rto 1 and 1.5 times tcp_rto */
+	/* Compute a randomized rto 1 and 1.5 times rto */
 	uint32_t gain;
 	uint8_t gain8;
-	uint32_t rto;
 
 	/* Getting random is computational expensive, so only use 8 bits */
 	sys_rand_get(&gain8, sizeof(uint8_t));
@@ -383,14 +396,36 @@ static void tcp_derive_rto(struct tcp *conn)
 	gain = (uint32_t)gain8;
 	gain += 1 << 9;
 
-	rto = (uint32_t)tcp_rto;
 	rto = (gain * rto) >> 9;
-	conn->rto = (uint16_t)rto;
+#endif
+
+	conn->rto = (uint16_t)MIN(rto, UINT16_MAX);
 #else
 	ARG_UNUSED(conn);
 #endif
 }
 
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+/* Feed a round trip time measurement, in ms, to the RFC 6298 estimator */
+static void tcp_rtt_sample(struct tcp *conn, uint32_t rtt)
+{
+	if (conn->srtt == 0U) {
+		conn->srtt = MAX(rtt, 1U) << 3;
+		conn->rttvar = rtt << 1;
+	} else {
+		int32_t delta = (int32_t)rtt - (int32_t)(conn->srtt >> 3);
+
+		conn->rttvar += abs(delta) - (int32_t)(conn->rttvar >> 2);
+		conn->srtt = MAX((int32_t)conn->srtt + delta, 8);
+	}
+
+	NET_DBG("conn: %p rtt=%u srtt=%u rttvar=%u", conn, rtt,
+		conn->srtt >> 3, conn->rttvar >> 2);
+
+	tcp_derive_rto(conn);
+}
+#endif
+
 static void tcp_send_queue_flush(struct tcp *conn)
 {
 	struct net_pkt *pkt;
@@ -673,7 +708,7 @@ static uint8_t *tcp_options_get(struct net_pkt *pkt, int tcp_options_len,
 static bool tcp_options_check(struct tcp_options *recv_options,
 			      struct net_pkt *pkt, ssize_t len)
 {
-	uint8_t options_buf[40]; /* TCP header max options size is 40 */
+	uint8_t options_buf[NET_TCP_MAX_OPT_SIZE];
 	bool result = len > 0 && ((len % 4) == 0) ? true : false;
 	uint8_t *options = tcp_options_get(pkt, len, options_buf,
 					   sizeof(options_buf));
@@ -681,9 +716,6 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 
 	NET_DBG("len=%zd", len);
 
-	recv_options->mss_found = false;
-	recv_options->wnd_found = false;
-
 	for ( ; options && len >= 1; options += opt_len, len -= opt_len) {
 		opt = options[0];
 
@@ -728,9 +760,49 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 				goto end;
 			}
 
-			recv_options->window = opt;
+			recv_options->window = options[2];
 			recv_options->wnd_found = true;
 			break;
+		case NET_TCP_SACK_PERM_OPT:
+			if (opt_len != NET_TCP_SACK_PERM_SIZE) {
+				result = false;
+				goto end;
+			}
+
+			recv_options->sack_perm_found = true;
+			break;
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+		case NET_TCP_TIMESTAMP_OPT:
+			if (opt_len != NET_TCP_TIMESTAMP_SIZE) {
+				result = false;
+				goto end;
+			}
+
+			recv_options->tsval = sys_get_be32(options + 2);
+			recv_options->tsecr = sys_get_be32(options + 6);
+			recv_options->ts_found = true;
+			break;
+#endif
+#ifdef CONFIG_NET_TCP_SACK
+		case NET_TCP_SACK_OPT:
+			if (((opt_len - 2) % NET_TCP_SACK_BLOCK_SIZE) != 0) {
+				result = false;
+				goto end;
+			}
+
+			recv_options->sack_count = 0;
+
+			for (int i = 2; i < opt_len &&
+			     recv_options->sack_count < NET_TCP_MAX_SACK_BLOCKS;
+			     i += NET_TCP_SACK_BLOCK_SIZE) {
+				struct tcp_sack_block *block =
+					&recv_options->sack[recv_options->sack_count++];
+
+				block->left = sys_get_be32(options + i);
+				block->right = sys_get_be32(options + i + 4);
+			}
+			break;
+#endif
 		default:
 			continue;
 		}
@@ -743,6 +815,66 @@ end:
 	return result;
 }
 
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+/* Smallest shift count which lets the whole window be advertised */
+static uint8_t tcp_wscale_shift(uint32_t win)
+{
+	uint8_t shift = 0U;
+
+	while ((win >> shift) > UINT16_MAX &&
+	       shift < NET_TCP_MAX_WINDOW_SCALE) {
+		shift++;
+	}
+
+	return shift;
+}
+#endif
+
+/* Prepare the options offered in the SYN of an active open */
+static void tcp_options_offer(struct tcp *conn)
+{
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+	conn->rcv_wscale = tcp_wscale_shift(conn->recv_win_max);
+#else
+	ARG_UNUSED(conn);
+#endif
+}
+
+/* Settle the options of the connection with those of the peer's SYN. On a
+ * passive open, the SYN-ACK then confirms the options the peer offered. On
+ * an active open, the options the peer did not confirm are not used.
+ */
+static void tcp_options_negotiate(struct tcp *conn)
+{
+	struct tcp_options *opts = &conn->recv_options;
+
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+	conn->wscale_ok = opts->wnd_found;
+	if (conn->wscale_ok) {
+		conn->snd_wscale = MIN(opts->window, NET_TCP_MAX_WINDOW_SCALE);
+		if (conn->state == TCP_LISTEN) {
+			conn->rcv_wscale = tcp_wscale_shift(conn->recv_win_max);
+		}
+	} else {
+		conn->snd_wscale = 0U;
+		conn->rcv_wscale = 0U;
+	}
+#endif
+
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+	conn->ts_ok = opts->ts_found;
+	if (conn->ts_ok) {
+		conn->ts_recent = opts->tsval;
+	}
+#endif
+
+#ifdef CONFIG_NET_TCP_SACK
+	conn->sack_ok = opts->sack_perm_found;
+#endif
+
+	ARG_UNUSED(opts);
+}
+
 static bool tcp_short_window(struct tcp *conn)
 {
 	int32_t threshold = MIN(conn_mss(conn), conn->recv_win_max / 2);
@@ -904,8 +1036,22 @@ static int tcp_finalize_pkt(struct net_pkt *pkt)
 	return -EINVAL;
 }
 
+static uint16_t tcp_window_field(struct tcp *conn, uint8_t flags)
+{
+	uint32_t win = conn->recv_win;
+
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+	/* The window of a SYN segment is never scaled */
+	if (!(flags & SYN)) {
+		win >>= conn->rcv_wscale;
+	}
+#endif
+
+	return (uint16_t)MIN(win, UINT16_MAX);
+}
+
 static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
-			  uint32_t seq)
+			  uint32_t seq, size_t options_len)
 {
 	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
 	struct tcphdr *th;
@@ -919,14 +1065,10 @@ static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
 
 	UNALIGNED_PUT(conn->src.sin.sin_port, &th->th_sport);
 	UNALIGNED_PUT(conn->dst.sin.sin_port, &th->th_dport);
-	th->th_off = 5;
-
-	if (conn->send_options.mss_found) {
-		th->th_off++;
-	}
+	th->th_off = 5 + (options_len / 4);
 
 	UNALIGNED_PUT(flags, &th->th_flags);
-	UNALIGNED_PUT(htons(conn->recv_win), &th->th_win);
+	UNALIGNED_PUT(htons(tcp_window_field(conn, flags)), &th->th_win);
 	UNALIGNED_PUT(htonl(seq), &th->th_seq);
 
 	if (ACK & flags) {
@@ -984,23 +1126,125 @@ static int get_tcp_nodelay(struct tcp *conn, void *value, size_t *len)
 	return 0;
 }
 
-static int net_tcp_set_mss_opt(struct tcp *conn, struct net_pkt *pkt)
+#ifdef CONFIG_NET_TCP_CONGESTION_CONTROL
+static int set_tcp_congestion(struct tcp *conn, const void *value, size_t len)
 {
-	NET_PKT_DATA_ACCESS_DEFINE(mss_opt_access, struct tcp_mss_option);
-	struct tcp_mss_option *mss;
-	uint32_t recv_mss;
+	const struct tcp_cc_ops *ops = tcp_cc_find(value, len);
 
-	mss = net_pkt_get_data(pkt, &mss_opt_access);
-	if (!mss) {
-		return -ENOBUFS;
+	if (ops == NULL) {
+		return -ENOENT;
 	}
 
-	recv_mss = net_tcp_get_supported_mss(conn);
-	recv_mss |= (NET_TCP_MSS_OPT << 24) | (NET_TCP_MSS_SIZE << 16);
+	if (ops != conn->cc.ops) {
+		conn->cc.ops = ops;
 
-	UNALIGNED_PUT(htonl(recv_mss), (uint32_t *)mss);
+		/* Keep the windows, start the algorithm afresh */
+		if (ops->init) {
+			ops->init(conn);
+		}
+	}
 
-	return net_pkt_set_data(pkt, &mss_opt_access);
+	return 0;
+}
+
+static int get_tcp_congestion(struct tcp *conn, void *value, size_t *len)
+{
+	size_t name_len = strlen(conn->cc.ops->name) + 1;
+
+	if (*len < name_len) {
+		return -EINVAL;
+	}
+
+	memcpy(value, conn->cc.ops->name, name_len);
+	*len = name_len;
+
+	return 0;
+}
+#endif /* CONFIG_NET_TCP_CONGESTION_CONTROL */
+
+#ifdef CONFIG_NET_TCP_SACK
+/* The out of order queue holds a single contiguous block of data */
+static bool tcp_sack_recv_block(struct tcp *conn, struct tcp_sack_block *block)
+{
+	if (!CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT ||
+	    net_pkt_is_empty(conn->queue_recv_data)) {
+		return false;
+	}
+
+	block->left = tcp_get_seq(conn->queue_recv_data->buffer);
+	block->right = block->left + net_pkt_get_len(conn->queue_recv_data);
+
+	return net_tcp_seq_cmp(block->left, conn->ack) > 0;
+}
+#endif
+
+/* Write the options of a segment to buf and return their length, which is
+ * a multiple of 4 and at most NET_TCP_MAX_OPT_SIZE.
+ */
+static size_t tcp_options_build(struct tcp *conn, uint8_t flags, uint8_t *buf)
+{
+	/* Options are offered in a SYN, and confirmed in the SYN-ACK */
+	bool offer = (flags & SYN) && !(flags & ACK);
+	size_t len = 0;
+
+	if (conn->send_options.mss_found) {
+		buf[len++] = NET_TCP_MSS_OPT;
+		buf[len++] = NET_TCP_MSS_SIZE;
+		sys_put_be16(net_tcp_get_supported_mss(conn), &buf[len]);
+		len += sizeof(uint16_t);
+	}
+
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+	if ((flags & SYN) && (offer || conn->wscale_ok)) {
+		buf[len++] = NET_TCP_NOP_OPT;
+		buf[len++] = NET_TCP_WINDOW_SCALE_OPT;
+		buf[len++] = NET_TCP_WINDOW_SCALE_SIZE;
+		buf[len++] = conn->rcv_wscale;
+	}
+#endif
+
+#ifdef CONFIG_NET_TCP_SACK
+	if ((flags & SYN) && (offer || conn->sack_ok)) {
+		buf[len++] = NET_TCP_NOP_OPT;
+		buf[len++] = NET_TCP_NOP_OPT;
+		buf[len++] = NET_TCP_SACK_PERM_OPT;
+		buf[len++] = NET_TCP_SACK_PERM_SIZE;
+	}
+#endif
+
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+	if (!(flags & RST) && (offer || conn->ts_ok)) {
+		buf[len++] = NET_TCP_NOP_OPT;
+		buf[len++] = NET_TCP_NOP_OPT;
+		buf[len++] = NET_TCP_TIMESTAMP_OPT;
+		buf[len++] = NET_TCP_TIMESTAMP_SIZE;
+		sys_put_be32(k_uptime_get_32(), &buf[len]);
+		len += sizeof(uint32_t);
+		sys_put_be32((flags & ACK) ? conn->ts_recent : 0U, &buf[len]);
+		len += sizeof(uint32_t);
+	}
+#endif
+
+#ifdef CONFIG_NET_TCP_SACK
+	struct tcp_sack_block block;
+
+	if (!(flags & SYN) && (flags & ACK) && conn->sack_ok &&
+	    tcp_sack_recv_block(conn, &block)) {
+		buf[len++] = NET_TCP_NOP_OPT;
+		buf[len++] = NET_TCP_NOP_OPT;
+		buf[len++] = NET_TCP_SACK_OPT;
+		buf[len++] = 2 + NET_TCP_SACK_BLOCK_SIZE;
+		sys_put_be32(block.left, &buf[len]);
+		len += sizeof(uint32_t);
+		sys_put_be32(block.right, &buf[len]);
+		len += sizeof(uint32_t);
+	}
+#endif
+
+	__ASSERT_NO_MSG(len <= NET_TCP_MAX_OPT_SIZE && (len % 4) == 0);
+	ARG_UNUSED(offer);
+
+	return len;
 }
 
 static bool is_destination_local(struct net_pkt *pkt)
@@ -1029,15 +1273,12 @@ static bool is_destination_local(struct net_pkt *pkt)
 static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		       uint32_t seq)
 {
-	size_t alloc_len = sizeof(struct tcphdr);
+	uint8_t options[NET_TCP_MAX_OPT_SIZE];
+	size_t options_len = tcp_options_build(conn, flags, options);
 	struct net_pkt *pkt;
 	int ret = 0;
 
-	if (conn->send_options.mss_found) {
-		alloc_len += sizeof(uint32_t);
-	}
-
-	pkt = tcp_pkt_alloc(conn, alloc_len);
+	pkt = tcp_pkt_alloc(conn, sizeof(struct tcphdr) + options_len);
 	if (!pkt) {
 		ret = -ENOBUFS;
 		goto out;
@@ -1055,14 +1296,14 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		goto out;
 	}
 
-	ret = tcp_header_add(conn, pkt, flags, seq);
+	ret = tcp_header_add(conn, pkt, flags, seq, options_len);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
 		goto out;
 	}
 
-	if (conn->send_options.mss_found) {
-		ret = net_tcp_set_mss_opt(conn, pkt);
+	if (options_len > 0) {
+		ret = net_pkt_write(pkt, options, options_len);
 		if (ret < 0) {
 			tcp_pkt_unref(pkt);
 			goto out;
@@ -1144,8 +1385,21 @@ static bool tcp_window_full(struct tcp *conn)
 	return window_full;
 }
 
+/* How much data may be in flight, limited by the peer's receive window
+ * and by the congestion window.
+ */
+static int tcp_send_window(struct tcp *conn)
+{
+#ifdef CONFIG_NET_TCP_CONGESTION_CONTROL
+	return MIN((uint32_t)conn->send_win, conn->cc.cwnd);
+#else
+	return conn->send_win;
+#endif
+}
+
 static int tcp_unsent_len(struct tcp *conn)
 {
+	int send_win = tcp_send_window(conn);
 	int unsent_len;
 
 	if (conn->unacked_len > conn->send_data_total) {
@@ -1156,10 +1410,10 @@ static int tcp_unsent_len(struct tcp *conn)
 	}
 
 	unsent_len = conn->send_data_total - conn->unacked_len;
-	if (conn->unacked_len >= conn->send_win) {
+	if (conn->unacked_len >= send_win) {
 		unsent_len = 0;
 	} else {
-		unsent_len = MIN(unsent_len, conn->send_win - conn->unacked_len);
+		unsent_len = MIN(unsent_len, send_win - conn->unacked_len);
 	}
  out:
 	NET_DBG("unsent_len=%d", unsent_len);
@@ -1167,40 +1421,28 @@ static int tcp_unsent_len(struct tcp *conn)
 	return unsent_len;
 }
 
-static int tcp_send_data(struct tcp *conn)
+/* Send len bytes of send_data starting offset bytes after conn->seq */
+static int tcp_send_segment(struct tcp *conn, int offset, int len,
+			    bool resend)
 {
-	int ret = 0;
-	int len;
 	struct net_pkt *pkt;
-
-	len = MIN3(conn->send_data_total - conn->unacked_len,
-		   conn->send_win - conn->unacked_len,
-		   conn_mss(conn));
-	if (len == 0) {
-		NET_DBG("conn: %p no data to send", conn);
-		ret = -ENODATA;
-		goto out;
-	}
+	int ret;
 
 	pkt = tcp_pkt_alloc(conn, len);
 	if (!pkt) {
 		NET_ERR("conn: %p packet allocation failed, len=%d", conn, len);
-		ret = -ENOBUFS;
-		goto out;
+		return -ENOBUFS;
 	}
 
-	ret = tcp_pkt_peek(pkt, conn->send_data, conn->unacked_len, len);
+	ret = tcp_pkt_peek(pkt, conn->send_data, offset, len);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
-		ret = -ENOBUFS;
-		goto out;
+		return -ENOBUFS;
 	}
 
-	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + conn->unacked_len);
+	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + offset);
 	if (ret == 0) {
-		conn->unacked_len += len;
-
-		if (conn->data_mode == TCP_DATA_MODE_RESEND) {
+		if (resend) {
 			net_stats_update_tcp_resent(conn->iface, len);
 			net_stats_update_tcp_seg_rexmit(conn->iface);
 		} else {
@@ -1215,12 +1457,300 @@ static int tcp_send_data(struct tcp *conn)
 	 */
 	tcp_pkt_unref(pkt);
 
+	return ret;
+}
+
+static int tcp_send_data(struct tcp *conn)
+{
+	int ret = 0;
+	int len;
+
+	len = MIN3(conn->send_data_total - conn->unacked_len,
+		   tcp_send_window(conn) - conn->unacked_len,
+		   conn_mss(conn));
+	if (len == 0) {
+		NET_DBG("conn: %p no data to send", conn);
+		ret = -ENODATA;
+		goto out;
+	}
+
+	ret = tcp_send_segment(conn, conn->unacked_len, len,
+			       conn->data_mode == TCP_DATA_MODE_RESEND);
+	if (ret == 0) {
+		conn->unacked_len += len;
+	}
+
 	conn_send_data_dump(conn);
 
  out:
 	return ret;
 }
 
+#ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
+/* Retransmit the first unacknowledged segment, leaving the rest in flight */
+static void tcp_retransmit_first(struct tcp *conn)
+{
+	int temp_unacked_len = conn->unacked_len;
+
+	conn->unacked_len = 0;
+
+	(void)tcp_send_data(conn);
+
+	/* Restore the current transmission */
+	conn->unacked_len = temp_unacked_len;
+}
+
+#ifdef CONFIG_NET_TCP_SACK
+/* Add a block to the scoreboard, merging it with the blocks it overlaps */
+static void tcp_sack_insert(struct tcp *conn, struct tcp_sack_block block)
+{
+	struct tcp_sack_block *sacked = conn->sacked;
+	int count = conn->sacked_count;
+	int i = 0;
+	int j;
+
+	while (i < count && net_tcp_seq_cmp(sacked[i].right, block.left) < 0) {
+		i++;
+	}
+
+	for (j = i; j < count &&
+		    net_tcp_seq_cmp(sacked[j].left, block.right) <= 0; j++) {
+		if (net_tcp_seq_cmp(sacked[j].left, block.left) < 0) {
+			block.left = sacked[j].left;
+		}
+
+		if (net_tcp_seq_cmp(sacked[j].right, block.right) > 0) {
+			block.right = sacked[j].right;
+		}
+	}
+
+	if (j == i) {
+		if (i == NET_TCP_MAX_SACK_BLOCKS) {
+			/* Forgetting about received data only costs a
+			 * needless retransmission.
+			 */
+			return;
+		}
+
+		if (count == NET_TCP_MAX_SACK_BLOCKS) {
+			count--;
+		}
+
+		memmove(&sacked[i + 1], &sacked[i], (count - i) * sizeof(*sacked));
+		count++;
+	} else {
+		memmove(&sacked[i + 1], &sacked[j], (count - j) * sizeof(*sacked));
+		count -= j - i - 1;
+	}
+
+	sacked[i] = block;
+	conn->sacked_count = count;
+}
+
+/* Update the scoreboard with an acknowledgment up to ack */
+static void tcp_sack_update(struct tcp *conn, uint32_t ack)
+{
+	struct tcp_options *opts = &conn->recv_options;
+	uint32_t snd_nxt = conn->seq + conn->unacked_len;
+	int count = 0;
+
+	/* Drop what is cumulatively acknowledged */
+	for (int i = 0; i < conn->sacked_count; i++) {
+		struct tcp_sack_block block = conn->sacked[i];
+
+		if (net_tcp_seq_cmp(block.right, ack) <= 0) {
+			continue;
+		}
+
+		if (net_tcp_seq_cmp(block.left, ack) < 0) {
+			block.left = ack;
+		}
+
+		conn->sacked[count++] = block;
+	}
+
+	conn->sacked_count = count;
+
+	for (int i = 0; i < opts->sack_count; i++) {
+		struct tcp_sack_block block = opts->sack[i];
+
+		/* Ignore duplicate and bogus blocks */
+		if (net_tcp_seq_cmp(block.left, ack) <= 0 ||
+		    net_tcp_seq_cmp(block.right, snd_nxt) > 0 ||
+		    net_tcp_seq_cmp(block.left, block.right) >= 0) {
+			continue;
+		}
+
+		tcp_sack_insert(conn, block);
+	}
+}
+
+/* Retransmit the data between the selectively acknowledged blocks which
+ * was not retransmitted yet during this recovery.
+ */
+static void tcp_sack_retransmit(struct tcp *conn)
+{
+	uint32_t budget = tcp_send_window(conn);
+	uint16_t mss = conn_mss(conn);
+	uint32_t seq = conn->seq;
+
+	if (net_tcp_seq_cmp(conn->sack_rexmit_high, seq) > 0) {
+		seq = conn->sack_rexmit_high;
+	}
+
+	for (int i = 0; i < conn->sacked_count && budget > 0; i++) {
+		struct tcp_sack_block *block = &conn->sacked[i];
+
+		while (net_tcp_seq_cmp(seq, block->left) < 0 && budget > 0) {
+			uint32_t len = MIN3(block->left - seq, mss, budget);
+
+			if (tcp_send_segment(conn, seq - conn->seq, len,
+					     true) < 0) {
+				return;
+			}
+
+			seq += len;
+			budget -= len;
+			conn->sack_rexmit_high = seq;
+		}
+
+		if (net_tcp_seq_cmp(seq, block->right) < 0) {
+			seq = block->right;
+		}
+	}
+}
+#endif /* CONFIG_NET_TCP_SACK */
+
+/* Retransmit what the peer is missing */
+static void tcp_retransmit_lost(struct tcp *conn)
+{
+#ifdef CONFIG_NET_TCP_SACK
+	if (conn->sacked_count > 0) {
+		tcp_sack_retransmit(conn);
+		return;
+	}
+#endif
+
+	tcp_retransmit_first(conn);
+}
+#endif /* CONFIG_NET_TCP_FAST_RETRANSMIT */
+
+#ifdef CONFIG_NET_TCP_CONGESTION_CONTROL
+static void tcp_cc_init(struct tcp *conn)
+{
+	struct tcp_cc *cc = &conn->cc;
+	uint16_t mss = conn_mss(conn);
+
+	/* Initial window, RFC 5681 section 3.1 */
+	if (mss > 2190) {
+		cc->cwnd = 2 * mss;
+	} else if (mss > 1095) {
+		cc->cwnd = 3 * mss;
+	} else {
+		cc->cwnd = 4 * mss;
+	}
+
+	cc->ssthresh = TCP_CC_CWND_MAX;
+	cc->recover = conn->seq;
+	cc->bytes_acked = 0;
+	cc->in_recovery = false;
+
+	if (cc->ops->init) {
+		cc->ops->init(conn);
+	}
+}
+
+/* Called once conn->seq moved past acked newly acknowledged bytes */
+static void tcp_cc_ack(struct tcp *conn, uint32_t acked)
+{
+	struct tcp_cc *cc = &conn->cc;
+	uint16_t mss = conn_mss(conn);
+
+	if (cc->in_recovery) {
+		if (net_tcp_seq_cmp(conn->seq, cc->recover) >= 0) {
+			/* Full acknowledgment, deflate the window, RFC 6582
+			 * section 3.2 step 3
+			 */
+			cc->cwnd = MIN(cc->ssthresh,
+				       MAX((uint32_t)conn->unacked_len, mss) + mss);
+			cc->in_recovery = false;
+
+			NET_DBG("conn: %p recovery done, cwnd=%u", conn,
+				cc->cwnd);
+		} else {
+			/* Partial acknowledgment, the next segment was lost
+			 * as well.
+			 */
+			tcp_retransmit_lost(conn);
+
+			cc->cwnd = (cc->cwnd > acked + mss) ? cc->cwnd - acked : mss;
+			if (acked >= mss) {
+				cc->cwnd += mss;
+			}
+		}
+
+		return;
+	}
+
+	/* Only grow a window which is actually used, RFC 7661 */
+	if ((uint32_t)conn->unacked_len + acked + mss <= cc->cwnd) {
+		return;
+	}
+
+	if (cc->cwnd < cc->ssthresh) {
+		/* Slow start, RFC 5681 section 3.1 */
+		cc->cwnd += MIN(acked, mss);
+	} else {
+		cc->ops->cong_avoid(conn, acked);
+	}
+
+	cc->cwnd = MIN(cc->cwnd, TCP_CC_CWND_MAX);
+}
+
+/* Three duplicate acknowledgments, RFC 5681 section 3.2 */
+static void tcp_cc_fast_retransmit(struct tcp *conn)
+{
+	struct tcp_cc *cc = &conn->cc;
+
+	if (cc->in_recovery) {
+		return;
+	}
+
+	cc->ssthresh = cc->ops->ssthresh(conn);
+	cc->cwnd = cc->ssthresh + (DUPLICATE_ACK_RETRANSMIT_TRHESHOLD *
+				   conn_mss(conn));
+	cc->recover = conn->seq + conn->unacked_len;
+	cc->bytes_acked = 0;
+	cc->in_recovery = true;
+
+	NET_DBG("conn: %p fast recovery, ssthresh=%u recover=%u", conn,
+		cc->ssthresh, cc->recover);
+}
+
+/* Retransmission timeout, RFC 5681 section 3.1 */
+static void tcp_cc_timeout(struct tcp *conn)
+{
+	struct tcp_cc *cc = &conn->cc;
+
+	/* Only the first timeout of a segment says something about the
+	 * window the path can take.
+	 */
+	if (conn->send_data_retries == 0) {
+		cc->ssthresh = cc->ops->ssthresh(conn);
+	}
+
+	cc->cwnd = conn_mss(conn);
+	cc->bytes_acked = 0;
+	cc->in_recovery = false;
+
+	if (cc->ops->timeout) {
+		cc->ops->timeout(conn);
+	}
+
+	NET_DBG("conn: %p timeout, ssthresh=%u", conn, cc->ssthresh);
+}
+#endif /* CONFIG_NET_TCP_CONGESTION_CONTROL */
+
 /* Send all queued but unsent data from the send_data packet by packet
  * until the receiver's window is full. */
 static int tcp_send_queued_data(struct tcp *conn)
@@ -1304,6 +1834,20 @@ static void tcp_resend_data(struct k_work *work)
 		goto out;
 	}
 
+#ifdef CONFIG_NET_TCP_CONGESTION_CONTROL
+	if (conn->send_data_total > 0) {
+		tcp_cc_timeout(conn);
+	}
+#endif
+
+#ifdef CONFIG_NET_TCP_SACK
+	/* The peer may have dropped data it selectively acknowledged,
+	 * RFC 2018 section 8.
+	 */
+	conn->sacked_count = 0;
+	conn->sack_rexmit_high = conn->seq;
+#endif
+
 	conn->data_mode = TCP_DATA_MODE_RESEND;
 	conn->unacked_len = 0;
 
@@ -1476,6 +2020,9 @@ static struct tcp *tcp_conn_alloc(void)
 	conn->in_connect = false;
 	conn->state = TCP_LISTEN;
 	conn->recv_win_max = tcp_rx_window;
+	if (!IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE)) {
+		conn->recv_win_max = MIN(conn->recv_win_max, UINT16_MAX);
+	}
 	conn->recv_win = conn->recv_win_max;
 	conn->send_win_max = MAX(tcp_tx_window, NET_IPV6_MTU);
 	conn->send_win = conn->send_win_max;
@@ -1483,6 +2030,10 @@ static struct tcp *tcp_conn_alloc(void)
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
 	conn->dup_ack_cnt = 0;
 #endif
+#ifdef CONFIG_NET_TCP_CONGESTION_CONTROL
+	conn->cc.ops = tcp_cc_default();
+	tcp_cc_init(conn);
+#endif
 
 	/* The ISN value will be set when we get the connection attempt or
 	 * when trying to create a connection.
@@ -1581,6 +2132,7 @@ static enum net_verdict tcp_recv(struct net_conn *net_conn,
 				 union net_proto_header *proto,
 				 void *user_data)
 {
+	struct net_context *context = user_data;
 	struct tcp *conn;
 	struct tcphdr *th;
 	enum net_verdict verdict = NET_DROP;
@@ -1588,6 +2140,14 @@ static enum net_verdict tcp_recv(struct net_conn *net_conn,
 	ARG_UNUSED(net_conn);
 	ARG_UNUSED(proto);
 
+	/* Established connections have a handler of their own, so the
+	 * connection is usually the one of the context.
+	 */
+	if (context->tcp && tcp_conn_cmp(context->tcp, pkt)) {
+		conn = context->tcp;
+		goto in;
+	}
+
 	conn = tcp_conn_search(pkt);
 	if (conn) {
 		goto in;
@@ -1596,7 +2156,7 @@ static enum net_verdict tcp_recv(struct net_conn *net_conn,
 	th = th_get(pkt);
 
 	if (th_flags(th) & SYN && !(th_flags(th) & ACK)) {
-		struct tcp *conn_old = ((struct net_context *)user_data)->tcp;
+		struct tcp *conn_old = context->tcp;
 
 		conn = tcp_conn_new(pkt);
 		if (!conn) {
@@ -2124,6 +2684,12 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		goto next_state;
 	}
 
+	/* Timestamps and SACK blocks are only valid for this segment */
+	conn->recv_options.ts_found = false;
+#ifdef CONFIG_NET_TCP_SACK
+	conn->recv_options.sack_count = 0;
+#endif
+
 	if (tcp_options_len && !tcp_options_check(&conn->recv_options, pkt,
 						  tcp_options_len)) {
 		NET_DBG("DROP: Invalid TCP option list");
@@ -2150,6 +2716,11 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 
 	if (th) {
 		conn->send_win = ntohs(th_win(th));
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+		if (conn->wscale_ok && !(th_flags(th) & SYN)) {
+			conn->send_win <<= conn->snd_wscale;
+		}
+#endif
 		if (conn->send_win > conn->send_win_max) {
 			NET_DBG("Lowering send window from %u to %u",
 				conn->send_win, conn->send_win_max);
@@ -2173,6 +2744,17 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		} else {
 			k_sem_give(&conn->tx_sem);
 		}
+
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+		/* Echo the timestamp of the oldest segment not acknowledged
+		 * yet, RFC 7323 section 4.3.
+		 */
+		if (conn->ts_ok && conn->recv_options.ts_found &&
+		    net_tcp_seq_cmp(th_seq(th), conn->ack) <= 0 &&
+		    (int32_t)(conn->recv_options.tsval - conn->ts_recent) >= 0) {
+			conn->ts_recent = conn->recv_options.tsval;
+		}
+#endif
 	}
 
 next_state:
@@ -2181,6 +2763,8 @@ next_state:
 	switch (conn->state) {
 	case TCP_LISTEN:
 		if (FL(&fl, ==, SYN)) {
+			tcp_options_negotiate(conn);
+
 			/* Make sure our MSS is also sent in the ACK */
 			conn->send_options.mss_found = true;
 			conn_ack(conn, th_seq(th) + 1); /* capture peer's isn */
@@ -2196,6 +2780,7 @@ next_state:
 						    ACK_TIMEOUT);
 			verdict = NET_OK;
 		} else {
+			tcp_options_offer(conn);
 			conn->send_options.mss_found = true;
 			tcp_out(conn, SYN);
 			conn->send_options.mss_found = false;
@@ -2213,6 +2798,17 @@ next_state:
 			net_context_set_state(conn->context,
 					      NET_CONTEXT_CONNECTED);
 
+#ifdef CONFIG_NET_TCP_CONGESTION_CONTROL
+			/* Use the algorithm of the listening socket, with
+			 * the MSS now known.
+			 */
+			if (conn->accepted_conn) {
+				conn->cc.ops = conn->accepted_conn->cc.ops;
+			}
+
+			tcp_cc_init(conn);
+#endif
+
 			if (conn->accepted_conn) {
 				if (conn->accepted_conn->accept_cb) {
 					conn->accepted_conn->accept_cb(
@@ -2248,6 +2844,7 @@ next_state:
 		 */
 		if (FL(&fl, &, SYN | ACK, th && th_ack(th) == conn->seq)) {
 			tcp_send_timer_cancel(conn);
+			tcp_options_negotiate(conn);
 			conn_ack(conn, th_seq(th) + 1);
 			if (len) {
 				verdict = tcp_data_get(conn, pkt, &len);
@@ -2265,6 +2862,9 @@ next_state:
 			tcp_conn_ref(conn);
 			net_context_set_state(conn->context,
 					      NET_CONTEXT_CONNECTED);
+#ifdef CONFIG_NET_TCP_CONGESTION_CONTROL
+			tcp_cc_init(conn);
+#endif
 			tcp_out(conn, ACK);
 
 			/* The connection semaphore is released *after*
@@ -2314,8 +2914,17 @@ next_state:
 			break;
 		}
 
+#ifdef CONFIG_NET_TCP_SACK
+		if (th && conn->sack_ok &&
+		    net_tcp_seq_cmp(th_ack(th), conn->seq) >= 0) {
+			tcp_sack_update(conn, th_ack(th));
+		}
+#endif
+
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
 		if (th && (net_tcp_seq_cmp(th_ack(th), conn->seq) == 0)) {
+			bool dup_ack = false;
+
 			/* Only if there is pending data, increment the duplicate ack count */
 			if (conn->send_data_total > 0) {
 				/* There could be also payload, only without payload account them */
@@ -2325,6 +2934,7 @@ next_state:
 					 */
 					conn->dup_ack_cnt = MIN(conn->dup_ack_cnt + 1,
 						DUPLICATE_ACK_RETRANSMIT_TRHESHOLD + 1);
+					dup_ack = true;
 				}
 			} else {
 				conn->dup_ack_cnt = 0;
@@ -2332,17 +2942,31 @@ next_state:
 
 			/* Only do fast retransmit when not already in a resend state */
 			if ((conn->data_mode == TCP_DATA_MODE_SEND) &&
-			    (conn->dup_ack_cnt == DUPLICATE_ACK_RETRANSMIT_TRHESHOLD)) {
+			    (conn->dup_ack_cnt == DUPLICATE_ACK_RETRANSMIT_TRHESHOLD) &&
+			    dup_ack) {
+#ifdef CONFIG_NET_TCP_CONGESTION_CONTROL
+				tcp_cc_fast_retransmit(conn);
+#endif
+#ifdef CONFIG_NET_TCP_SACK
+				conn->sack_rexmit_high = conn->seq;
+#endif
 				/* Apply a fast retransmit */
-				int temp_unacked_len = conn->unacked_len;
-
-				conn->unacked_len = 0;
-
-				(void)tcp_send_data(conn);
-
-				/* Restore the current transmission */
-				conn->unacked_len = temp_unacked_len;
+				tcp_retransmit_lost(conn);
 			}
+#ifdef CONFIG_NET_TCP_CONGESTION_CONTROL
+			else if (dup_ack && conn->cc.in_recovery) {
+				/* Another segment left the network, inflate
+				 * the window to send new data meanwhile.
+				 */
+				conn->cc.cwnd += conn_mss(conn);
+#ifdef CONFIG_NET_TCP_SACK
+				if (conn->sacked_count > 0) {
+					tcp_sack_retransmit(conn);
+				}
+#endif
+				(void)tcp_send_queued_data(conn);
+			}
+#endif
 		}
 #endif
 
@@ -2383,6 +3007,22 @@ next_state:
 			conn_seq(conn, + len_acked);
 			net_stats_update_tcp_seg_recv(conn->iface);
 
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+			if (conn->ts_ok && conn->recv_options.ts_found &&
+			    conn->recv_options.tsecr != 0U) {
+				uint32_t rtt = k_uptime_get_32() -
+					       conn->recv_options.tsecr;
+
+				if (rtt < TCP_RTO_MAX_MS) {
+					tcp_rtt_sample(conn, rtt);
+				}
+			}
+#endif
+
+#ifdef CONFIG_NET_TCP_CONGESTION_CONTROL
+			tcp_cc_ack(conn, len_acked);
+#endif
+
 			conn_send_data_dump(conn);
 
 			if (!k_work_delayable_remaining_get(
@@ -3436,6 +4076,13 @@ int net_tcp_set_option(struct net_context *context,
 	case TCP_OPT_NODELAY:
 		ret = set_tcp_nodelay(conn, value, len);
 		break;
+	case TCP_OPT_CONGESTION:
+#ifdef CONFIG_NET_TCP_CONGESTION_CONTROL
+		ret = set_tcp_congestion(conn, value, len);
+#else
+		ret = -ENOPROTOOPT;
+#endif
+		break;
 	}
 
 	k_mutex_unlock(&conn->lock);
@@ -3461,6 +4108,13 @@ int net_tcp_get_option(struct net_context *context,
 	case TCP_OPT_NODELAY:
 		ret = get_tcp_nodelay(conn, value, len);
 		break;
+	case TCP_OPT_CONGESTION:
+#ifdef CONFIG_NET_TCP_CONGESTION_CONTROL
+		ret = get_tcp_congestion(conn, value, len);
+#else
+		ret = -ENOPROTOOPT;
+#endif
+		break;
 	}
 
 	k_mutex_unlock(&conn->lock);
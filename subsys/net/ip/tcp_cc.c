@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <string.h>
+#include <zephyr/kernel.h>
+
+#include "net_private.h"
+#include "tcp_internal.h"
+#include "tcp_cc.h"
+
+static const struct tcp_cc_ops *const tcp_cc_algorithms[] = {
+	&tcp_cc_newreno,
+#if defined(CONFIG_NET_TCP_CC_CUBIC)
+	&tcp_cc_cubic,
+#endif
+};
+
+const struct tcp_cc_ops *tcp_cc_find(const char *name, size_t len)
+{
+	len = strnlen(name, len);
+
+	for (int i = 0; i < ARRAY_SIZE(tcp_cc_algorithms); i++) {
+		const struct tcp_cc_ops *ops = tcp_cc_algorithms[i];
+
+		if ((strlen(ops->name) == len) &&
+		    (strncmp(ops->name, name, len) == 0)) {
+			return ops;
+		}
+	}
+
+	return NULL;
+}
+
+const struct tcp_cc_ops *tcp_cc_default(void)
+{
+#if defined(CONFIG_NET_TCP_CC_DEFAULT_CUBIC)
+	return &tcp_cc_cubic;
+#else
+	return &tcp_cc_newreno;
+#endif
+}
+
+/* RFC 5681, cwnd grows by one MSS per window of acknowledged data */
+static void tcp_newreno_cong_avoid(struct tcp *conn, uint32_t acked)
+{
+	conn->cc.bytes_acked += acked;
+
+	if (conn->cc.bytes_acked >= conn->cc.cwnd) {
+		conn->cc.bytes_acked -= conn->cc.cwnd;
+		conn->cc.cwnd += conn_mss(conn);
+	}
+}
+
+/* RFC 5681 equation (4), half of the data in flight */
+static uint32_t tcp_newreno_ssthresh(struct tcp *conn)
+{
+	return MAX((uint32_t)conn->unacked_len / 2U, 2U * conn_mss(conn));
+}
+
+const struct tcp_cc_ops tcp_cc_newreno = {
+	.name = "newreno",
+	.cong_avoid = tcp_newreno_cong_avoid,
+	.ssthresh = tcp_newreno_ssthresh,
+};
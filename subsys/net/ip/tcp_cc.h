@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/** @file
+ * @brief TCP congestion control algorithms
+ *
+ * Slow start, fast retransmit and fast recovery (RFC 5681, RFC 6582) are
+ * common to all algorithms and done in tcp.c. An algorithm decides how the
+ * congestion window grows in congestion avoidance, and how far it shrinks
+ * when a loss is detected.
+ */
+
+#ifndef __TCP_CC_H
+#define __TCP_CC_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct tcp;
+
+/* Upper bound of the congestion window, in bytes */
+#define TCP_CC_CWND_MAX (1U << 30)
+
+struct tcp_cc_ops {
+	/* Name, as used with the TCP_CONGESTION socket option */
+	const char *name;
+	/* Reset the algorithm state of the connection, optional */
+	void (*init)(struct tcp *conn);
+	/* Grow cwnd in congestion avoidance, acked bytes were newly
+	 * acknowledged.
+	 */
+	void (*cong_avoid)(struct tcp *conn, uint32_t acked);
+	/* Return the slow start threshold to use after a loss */
+	uint32_t (*ssthresh)(struct tcp *conn);
+	/* A retransmission timeout occurred, optional */
+	void (*timeout)(struct tcp *conn);
+};
+
+#if defined(CONFIG_NET_TCP_CC_CUBIC)
+struct tcp_cc_cubic {
+	/* Start of the current congestion avoidance epoch, in ms, 0 if
+	 * none is running.
+	 */
+	uint32_t epoch_start;
+	/* Time to grow back to origin, in ms */
+	uint32_t k;
+	/* Window the cubic function is centered on, in bytes */
+	uint32_t origin;
+	/* Window before the last reduction, in bytes */
+	uint32_t w_max;
+	/* Window Reno would have reached, in bytes */
+	uint32_t w_est;
+};
+#endif
+
+/* Congestion control state of a connection, all windows in bytes */
+struct tcp_cc {
+	const struct tcp_cc_ops *ops;
+	uint32_t cwnd;
+	uint32_t ssthresh;
+	/* Highest sequence number sent when fast recovery started */
+	uint32_t recover;
+	/* Bytes acknowledged in congestion avoidance since cwnd grew */
+	uint32_t bytes_acked;
+	bool in_recovery;
+#if defined(CONFIG_NET_TCP_CC_CUBIC)
+	struct tcp_cc_cubic cubic;
+#endif
+};
+
+extern const struct tcp_cc_ops tcp_cc_newreno;
+#if defined(CONFIG_NET_TCP_CC_CUBIC)
+extern const struct tcp_cc_ops tcp_cc_cubic;
+#endif
+
+/**
+ * @brief Look up a congestion control algorithm
+ *
+ * @param name Algorithm name, not necessarily NUL terminated
+ * @param len Length of the name
+ *
+ * @return Algorithm, NULL if not found
+ */
+const struct tcp_cc_ops *tcp_cc_find(const char *name, size_t len);
+
+/**
+ * @brief Return the algorithm new connections use
+ */
+const struct tcp_cc_ops *tcp_cc_default(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TCP_CC_H */
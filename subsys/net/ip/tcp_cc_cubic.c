@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* CUBIC congestion control, RFC 8312.
+ *
+ * Windows are kept in bytes and time in milliseconds, so that
+ * W_cubic(t) = C * (t - K)^3 + W_max, with C = 0.4 segments per second
+ * cubed, becomes 4 * mss * (t - K)^3 / 10^10 bytes.
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <string.h>
+#include <zephyr/kernel.h>
+
+#include "net_private.h"
+#include "tcp_internal.h"
+#include "tcp_cc.h"
+
+/* Multiplicative decrease factor, beta = 0.7 */
+#define CUBIC_BETA_NUM 7U
+#define CUBIC_BETA_DEN 10U
+
+/* Keep (t - K)^3 within 64 bits */
+#define CUBIC_T_MAX_MS 100000
+
+/* Integer cube root, bit by bit */
+static uint32_t cubic_root(uint64_t a)
+{
+	uint64_t y = 0U;
+
+	for (int s = 63; s >= 0; s -= 3) {
+		uint64_t b;
+
+		y <<= 1;
+		b = (3U * y * (y + 1U)) + 1U;
+		if ((a >> s) >= b) {
+			a -= b << s;
+			y++;
+		}
+	}
+
+	return (uint32_t)y;
+}
+
+static void tcp_cubic_init(struct tcp *conn)
+{
+	memset(&conn->cc.cubic, 0, sizeof(conn->cc.cubic));
+}
+
+static void tcp_cubic_cong_avoid(struct tcp *conn, uint32_t acked)
+{
+	struct tcp_cc_cubic *cubic = &conn->cc.cubic;
+	uint32_t mss = conn_mss(conn);
+	uint32_t cwnd = conn->cc.cwnd;
+	uint32_t now = k_uptime_get_32();
+	int64_t t, target;
+
+	if (cubic->epoch_start == 0U) {
+		/* 0 means no epoch */
+		cubic->epoch_start = MAX(now, 1U);
+		cubic->w_est = cwnd;
+
+		if (cwnd < cubic->w_max) {
+			/* K = cbrt((W_max - cwnd) / C), section 4.1 */
+			cubic->k = cubic_root(((uint64_t)(cubic->w_max - cwnd) *
+					       2500000000ULL) / mss);
+			cubic->origin = cubic->w_max;
+		} else {
+			cubic->k = 0U;
+			cubic->origin = cwnd;
+		}
+
+		NET_DBG("conn: %p new epoch, K=%u ms origin=%u", conn,
+			cubic->k, cubic->origin);
+	}
+
+	t = (int64_t)(now - cubic->epoch_start) - cubic->k;
+	t = CLAMP(t, -CUBIC_T_MAX_MS, CUBIC_T_MAX_MS);
+
+	target = (int64_t)cubic->origin +
+		 (((t * t * t) / 1000000) * 4 * (int64_t)mss) / 10000;
+
+	/* Do not grow by more than half a window per round trip */
+	target = MIN(target, (int64_t)cwnd + (cwnd / 2U));
+
+	/* Stay at least as aggressive as Reno, section 4.2 */
+	cubic->w_est += (uint32_t)(((uint64_t)9U * mss * acked) /
+				   (17U * (uint64_t)cwnd));
+	target = MAX(target, (int64_t)cubic->w_est);
+
+	if (target > cwnd) {
+		conn->cc.cwnd += (uint32_t)(((uint64_t)(target - cwnd) * acked) /
+					    cwnd);
+	}
+}
+
+static uint32_t tcp_cubic_ssthresh(struct tcp *conn)
+{
+	struct tcp_cc_cubic *cubic = &conn->cc.cubic;
+	uint32_t cwnd = conn->cc.cwnd;
+
+	cubic->epoch_start = 0U;
+
+	/* Fast convergence, section 4.6: release bandwidth to new flows */
+	if (cwnd < cubic->w_max) {
+		cubic->w_max = (uint32_t)(((uint64_t)cwnd *
+					   (CUBIC_BETA_DEN + CUBIC_BETA_NUM)) /
+					  (2U * CUBIC_BETA_DEN));
+	} else {
+		cubic->w_max = cwnd;
+	}
+
+	return MAX((uint32_t)(((uint64_t)cwnd * CUBIC_BETA_NUM) / CUBIC_BETA_DEN),
+		   2U * conn_mss(conn));
+}
+
+static void tcp_cubic_timeout(struct tcp *conn)
+{
+	conn->cc.cubic.epoch_start = 0U;
+}
+
+const struct tcp_cc_ops tcp_cc_cubic = {
+	.name = "cubic",
+	.init = tcp_cubic_init,
+	.cong_avoid = tcp_cubic_cong_avoid,
+	.ssthresh = tcp_cubic_ssthresh,
+	.timeout = tcp_cubic_timeout,
+};
@@ -6,6 +6,7 @@
  */
 
 #include "tp.h"
+#include "tcp_cc.h"
 
 #define is(_a, _b) (strcmp((_a), (_b)) == 0)
 
@@ -129,7 +130,7 @@
 #define conn_send_data_dump(_conn)                                             \
 	({                                                                     \
 		NET_DBG("conn: %p total=%zd, unacked_len=%d, "                 \
-			"send_win=%hu, mss=%hu",                               \
+			"send_win=%u, mss=%hu",                                \
 			(_conn), net_pkt_get_len((_conn)->send_data),          \
 			_conn->unacked_len, _conn->send_win,                   \
 			(uint16_t)conn_mss((_conn)));                          \
@@ -209,18 +210,49 @@ union tcp_endpoint {
 #define NET_TCP_NOP_OPT          1
 #define NET_TCP_MSS_OPT          2
 #define NET_TCP_WINDOW_SCALE_OPT 3
+#define NET_TCP_SACK_PERM_OPT    4
+#define NET_TCP_SACK_OPT         5
+#define NET_TCP_TIMESTAMP_OPT    8
 
 /* TCP Option sizes */
 #define NET_TCP_END_SIZE          1
 #define NET_TCP_NOP_SIZE          1
 #define NET_TCP_MSS_SIZE          4
 #define NET_TCP_WINDOW_SCALE_SIZE 3
+#define NET_TCP_SACK_PERM_SIZE    2
+#define NET_TCP_SACK_BLOCK_SIZE   8
+#define NET_TCP_TIMESTAMP_SIZE    10
+
+/* TCP header max options size */
+#define NET_TCP_MAX_OPT_SIZE      40
+
+/* Largest shift count of the window scale option, RFC 7323 */
+#define NET_TCP_MAX_WINDOW_SCALE  14
+
+/* SACK blocks fitting in the options of a segment */
+#define NET_TCP_MAX_SACK_BLOCKS   4
+
+struct tcp_sack_block {
+	uint32_t left;
+	uint32_t right;
+};
 
 struct tcp_options {
 	uint16_t mss;
+	/* Window scale shift count */
 	uint16_t window;
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+	uint32_t tsval;
+	uint32_t tsecr;
+#endif
+#ifdef CONFIG_NET_TCP_SACK
+	struct tcp_sack_block sack[NET_TCP_MAX_SACK_BLOCKS];
+	uint8_t sack_count;
+#endif
 	bool mss_found : 1;
 	bool wnd_found : 1;
+	bool sack_perm_found : 1;
+	bool ts_found : 1;
 };
 
 struct tcp { /* TCP connection */
@@ -267,22 +299,54 @@ struct tcp { /* TCP connection */
 	enum tcp_data_mode data_mode;
 	uint32_t seq;
 	uint32_t ack;
-	uint16_t recv_win_max;
-	uint16_t recv_win;
-	uint16_t send_win_max;
-	uint16_t send_win;
-#ifdef CONFIG_NET_TCP_RANDOMIZED_RTO
+	uint32_t recv_win_max;
+	uint32_t recv_win;
+	uint32_t send_win_max;
+	uint32_t send_win;
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+	/* Peer's timestamp to echo */
+	uint32_t ts_recent;
+	/* Smoothed round trip time in 1/8 ms, 0 before the first sample */
+	uint32_t srtt;
+	/* Round trip time variation in 1/4 ms */
+	uint32_t rttvar;
+#endif
+#ifdef CONFIG_NET_TCP_SACK
+	/* Data the peer selectively acknowledged, in sequence order */
+	struct tcp_sack_block sacked[NET_TCP_MAX_SACK_BLOCKS];
+	/* Retransmissions of the current recovery went up to there */
+	uint32_t sack_rexmit_high;
+	uint8_t sacked_count;
+#endif
+#if defined(CONFIG_NET_TCP_RANDOMIZED_RTO) || defined(CONFIG_NET_TCP_TIMESTAMPS)
 	uint16_t rto;
+#endif
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+	/* Shift counts of the windows received and sent */
+	uint8_t snd_wscale;
+	uint8_t rcv_wscale;
 #endif
 	uint8_t send_data_retries;
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
 	uint8_t dup_ack_cnt;
+#endif
+#ifdef CONFIG_NET_TCP_CONGESTION_CONTROL
+	struct tcp_cc cc;
 #endif
 	uint8_t zwp_retries;
 	bool in_retransmission : 1;
 	bool in_connect : 1;
 	bool in_close : 1;
 	bool tcp_nodelay : 1;
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+	bool wscale_ok : 1;
+#endif
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+	bool ts_ok : 1;
+#endif
+#ifdef CONFIG_NET_TCP_SACK
+	bool sack_ok : 1;
+#endif
 };
 
 #define _flags(_fl, _op, _mask, _cond)					\
@@ -366,6 +366,35 @@ static void zsock_accepted_cb(struct net_context *new_ctx,
 	}
 }
 
+/* Timestamp a received packet with the uptime, if requested with
+ * SOF_TIMESTAMPING_RX_SOFTWARE and the driver did not timestamp it.
+ */
+static void zsock_timestamp_rx(struct net_context *ctx, struct net_pkt *pkt)
+{
+	struct net_ptp_time *ts = net_pkt_timestamp(pkt);
+	struct net_ptp_time now;
+	int timestamping = 0;
+	uint64_t ns;
+
+	(void)net_context_get_option(ctx, NET_OPT_TIMESTAMPING, &timestamping,
+				     NULL);
+
+	if (!(timestamping & SOF_TIMESTAMPING_RX_SOFTWARE)) {
+		return;
+	}
+
+	if ((timestamping & SOF_TIMESTAMPING_RX_HARDWARE) &&
+	    (ts->second != 0U || ts->nanosecond != 0U)) {
+		return;
+	}
+
+	ns = k_ticks_to_ns_floor64(k_uptime_ticks());
+	now.second = ns / NSEC_PER_SEC;
+	now.nanosecond = ns % NSEC_PER_SEC;
+
+	net_pkt_set_timestamp(pkt, &now);
+}
+
 static void zsock_received_cb(struct net_context *ctx,
 			      struct net_pkt *pkt,
 			      union net_ip_header *ip_hdr,
@@ -410,6 +439,10 @@ static void zsock_received_cb(struct net_context *ctx,
 
 	net_pkt_set_rx_stats_tick(pkt, k_cycle_get_32());
 
+	if (IS_ENABLED(CONFIG_NET_CONTEXT_TIMESTAMPING)) {
+		zsock_timestamp_rx(ctx, pkt);
+	}
+
 	k_fifo_put(&ctx->recv_q, pkt);
 
 unlock:
@@ -1015,6 +1048,68 @@ fail:
 #include <syscalls/zsock_sendmsg_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+int z_impl_zsock_sendmmsg(int sock, struct mmsghdr *msgvec,
+			  unsigned int vlen, int flags)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	ssize_t ret = 0;
+	unsigned int i;
+	void *obj;
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (vtable->sendmsg == NULL) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	for (i = 0; i < vlen; i++) {
+		ret = vtable->sendmsg(obj, &msgvec[i].msg_hdr, flags);
+		if (ret < 0) {
+			break;
+		}
+
+		msgvec[i].msg_len = ret;
+	}
+
+	k_mutex_unlock(lock);
+
+	/* An error is only reported if no message was sent */
+	return (i > 0) ? (int)i : (int)ret;
+}
+
+#ifdef CONFIG_USERSPACE
+/* The messages are verified and sent one at a time */
+static inline int z_vrfy_zsock_sendmmsg(int sock, struct mmsghdr *msgvec,
+					unsigned int vlen, int flags)
+{
+	unsigned int i;
+	ssize_t ret = 0;
+
+	for (i = 0; i < vlen; i++) {
+		unsigned int len;
+
+		ret = z_vrfy_zsock_sendmsg(sock, &msgvec[i].msg_hdr, flags);
+		if (ret < 0) {
+			break;
+		}
+
+		len = ret;
+		Z_OOPS(z_user_to_copy(&msgvec[i].msg_len, &len, sizeof(len)));
+	}
+
+	return (i > 0) ? (int)i : (int)ret;
+}
+#include <syscalls/zsock_sendmmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
 static int sock_get_pkt_src_addr(struct net_pkt *pkt,
 				 enum net_ip_protocol proto,
 				 struct sockaddr *addr,
@@ -1169,18 +1264,149 @@ int zsock_wait_data(struct net_context *ctx, k_timeout_t *timeout)
 	return 0;
 }
 
+/* Copy len bytes of pkt to the buffers of msg, starting at offset */
+static int zsock_read_iov(struct net_pkt *pkt, const struct msghdr *msg,
+			  size_t offset, size_t len)
+{
+	for (size_t i = 0; (i < msg->msg_iovlen) && (len > 0); i++) {
+		size_t iov_len = msg->msg_iov[i].iov_len;
+		size_t chunk;
+
+		if (offset >= iov_len) {
+			offset -= iov_len;
+			continue;
+		}
+
+		chunk = MIN(iov_len - offset, len);
+
+		if (net_pkt_read(pkt, (uint8_t *)msg->msg_iov[i].iov_base + offset,
+				 chunk)) {
+			return -ENOBUFS;
+		}
+
+		offset = 0;
+		len -= chunk;
+	}
+
+	return 0;
+}
+
+/* Append a control message to msg, msg_controllen being the length used
+ * so far, and space the length of the buffer.
+ */
+static void zsock_put_cmsg(struct msghdr *msg, size_t space, int level,
+			   int type, const void *data, size_t len)
+{
+	struct cmsghdr *cmsg;
+
+	if (msg->msg_controllen + CMSG_SPACE(len) > space) {
+		msg->msg_flags |= ZSOCK_MSG_CTRUNC;
+		return;
+	}
+
+	cmsg = (struct cmsghdr *)((uint8_t *)msg->msg_control +
+				  msg->msg_controllen);
+	cmsg->cmsg_len = CMSG_LEN(len);
+	cmsg->cmsg_level = level;
+	cmsg->cmsg_type = type;
+	memcpy(CMSG_DATA(cmsg), data, len);
+
+	msg->msg_controllen += CMSG_SPACE(len);
+}
+
+static void zsock_put_pktinfo(struct net_pkt *pkt, struct msghdr *msg,
+			      size_t space)
+{
+	struct net_pkt_cursor backup;
+	int ifindex = net_if_get_by_iface(net_pkt_iface(pkt));
+
+	net_pkt_cursor_backup(pkt, &backup);
+	net_pkt_cursor_init(pkt);
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) &&
+	    net_pkt_family(pkt) == AF_INET) {
+		NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(ipv4_access,
+						      struct net_ipv4_hdr);
+		struct in_pktinfo info = { .ipi_ifindex = ifindex };
+		struct net_ipv4_hdr *ipv4_hdr;
+
+		ipv4_hdr = (struct net_ipv4_hdr *)net_pkt_get_data(
+							pkt, &ipv4_access);
+		if (ipv4_hdr) {
+			net_ipv4_addr_copy_raw((uint8_t *)&info.ipi_addr,
+					       ipv4_hdr->dst);
+			info.ipi_spec_dst = info.ipi_addr;
+			zsock_put_cmsg(msg, space, IPPROTO_IP, IP_PKTINFO,
+				       &info, sizeof(info));
+		}
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) &&
+		   net_pkt_family(pkt) == AF_INET6) {
+		NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(ipv6_access,
+						      struct net_ipv6_hdr);
+		struct in6_pktinfo info = { .ipi6_ifindex = ifindex };
+		struct net_ipv6_hdr *ipv6_hdr;
+
+		ipv6_hdr = (struct net_ipv6_hdr *)net_pkt_get_data(
+							pkt, &ipv6_access);
+		if (ipv6_hdr) {
+			net_ipv6_addr_copy_raw((uint8_t *)&info.ipi6_addr,
+					       ipv6_hdr->dst);
+			zsock_put_cmsg(msg, space, IPPROTO_IPV6, IPV6_PKTINFO,
+				       &info, sizeof(info));
+		}
+	}
+
+	net_pkt_cursor_restore(pkt, &backup);
+}
+
+/* Fill the control buffer of msg with the ancillary data enabled on the
+ * socket.
+ */
+static void zsock_put_cmsgs(struct net_context *ctx, struct net_pkt *pkt,
+			    struct msghdr *msg)
+{
+	size_t space = msg->msg_controllen;
+	int pktinfo = 0;
+	int timestamping = 0;
+
+	msg->msg_controllen = 0;
+
+	/* Packets from offloaded IP stack do not have IP headers */
+	if (IS_ENABLED(CONFIG_NET_OFFLOAD) &&
+	    net_if_is_ip_offloaded(net_context_get_iface(ctx))) {
+		return;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_CONTEXT_RECV_PKTINFO)) {
+		(void)net_context_get_option(ctx, NET_OPT_RECV_PKTINFO,
+					     &pktinfo, NULL);
+		if (pktinfo) {
+			zsock_put_pktinfo(pkt, msg, space);
+		}
+	}
+
+	if (IS_ENABLED(CONFIG_NET_CONTEXT_TIMESTAMPING)) {
+		(void)net_context_get_option(ctx, NET_OPT_TIMESTAMPING,
+					     &timestamping, NULL);
+		if (timestamping) {
+			zsock_put_cmsg(msg, space, SOL_SOCKET,
+				       SCM_TIMESTAMPING, net_pkt_timestamp(pkt),
+				       sizeof(struct net_ptp_time));
+		}
+	}
+}
+
 static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
-				       void *buf,
+				       struct msghdr *msg,
 				       size_t max_len,
-				       int flags,
-				       struct sockaddr *src_addr,
-				       socklen_t *addrlen)
+				       int flags)
 {
 	k_timeout_t timeout = K_FOREVER;
 	size_t recv_len = 0;
 	size_t read_len;
 	struct net_pkt_cursor backup;
 	struct net_pkt *pkt;
+	struct sockaddr *src_addr = msg->msg_name;
 
 	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
 		timeout = K_NO_WAIT;
@@ -1218,7 +1444,7 @@ static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
 
 	net_pkt_cursor_backup(pkt, &backup);
 
-	if (src_addr && addrlen) {
+	if (src_addr) {
 		if (IS_ENABLED(CONFIG_NET_OFFLOAD) &&
 		    net_if_is_ip_offloaded(net_context_get_iface(ctx))) {
 			/*
@@ -1229,7 +1455,7 @@ static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
 			 */
 			if (ctx->flags & NET_CONTEXT_REMOTE_ADDR_SET) {
 				memcpy(src_addr, &ctx->remote,
-				       MIN(*addrlen, sizeof(ctx->remote)));
+				       MIN(msg->msg_namelen, sizeof(ctx->remote)));
 			} else {
 				errno = ENOTSUP;
 				goto fail;
@@ -1238,7 +1464,7 @@ static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
 			int rv;
 
 			rv = sock_get_pkt_src_addr(pkt, net_context_get_proto(ctx),
-						   src_addr, *addrlen);
+						   src_addr, msg->msg_namelen);
 			if (rv < 0) {
 				errno = -rv;
 				LOG_ERR("sock_get_pkt_src_addr %d", rv);
@@ -1250,9 +1476,9 @@ static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
 		 * size of source address
 		 */
 		if (src_addr->sa_family == AF_INET) {
-			*addrlen = sizeof(struct sockaddr_in);
+			msg->msg_namelen = sizeof(struct sockaddr_in);
 		} else if (src_addr->sa_family == AF_INET6) {
-			*addrlen = sizeof(struct sockaddr_in6);
+			msg->msg_namelen = sizeof(struct sockaddr_in6);
 		} else {
 			errno = ENOTSUP;
 			goto fail;
@@ -1262,11 +1488,19 @@ static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
 	recv_len = net_pkt_remaining_data(pkt);
 	read_len = MIN(recv_len, max_len);
 
-	if (net_pkt_read(pkt, buf, read_len)) {
+	if (zsock_read_iov(pkt, msg, 0, read_len)) {
 		errno = ENOBUFS;
 		goto fail;
 	}
 
+	if (read_len < recv_len) {
+		msg->msg_flags |= ZSOCK_MSG_TRUNC;
+	}
+
+	if (msg->msg_control != NULL) {
+		zsock_put_cmsgs(ctx, pkt, msg);
+	}
+
 	if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS) &&
 	    !(flags & ZSOCK_MSG_PEEK)) {
 		net_socket_update_tc_rx_time(pkt, k_cycle_get_32());
@@ -1289,7 +1523,7 @@ fail:
 }
 
 static inline ssize_t zsock_recv_stream(struct net_context *ctx,
-					void *buf,
+					struct msghdr *msg,
 					size_t max_len,
 					int flags)
 {
@@ -1370,7 +1604,7 @@ static inline ssize_t zsock_recv_stream(struct net_context *ctx,
 		}
 
 		/* Actually copy data to application buffer */
-		if (net_pkt_read(pkt, (uint8_t *)buf + recv_len, read_len)) {
+		if (zsock_read_iov(pkt, msg, recv_len, read_len)) {
 			errno = ENOBUFS;
 			return -1;
 		}
@@ -1414,15 +1648,34 @@ ssize_t zsock_recvfrom_ctx(struct net_context *ctx, void *buf, size_t max_len,
 			   struct sockaddr *src_addr, socklen_t *addrlen)
 {
 	enum net_sock_type sock_type = net_context_get_type(ctx);
+	struct iovec iov = {
+		.iov_base = buf,
+		.iov_len = max_len,
+	};
+	struct msghdr msg = {
+		.msg_iov = &iov,
+		.msg_iovlen = 1,
+	};
+	ssize_t ret;
 
 	if (max_len == 0) {
 		return 0;
 	}
 
 	if (sock_type == SOCK_DGRAM) {
-		return zsock_recv_dgram(ctx, buf, max_len, flags, src_addr, addrlen);
+		if (src_addr && addrlen) {
+			msg.msg_name = src_addr;
+			msg.msg_namelen = *addrlen;
+		}
+
+		ret = zsock_recv_dgram(ctx, &msg, max_len, flags);
+		if (ret >= 0 && msg.msg_name) {
+			*addrlen = msg.msg_namelen;
+		}
+
+		return ret;
 	} else if (sock_type == SOCK_STREAM) {
-		return zsock_recv_stream(ctx, buf, max_len, flags);
+		return zsock_recv_stream(ctx, &msg, max_len, flags);
 	} else {
 		__ASSERT(0, "Unknown socket type");
 	}
@@ -1468,6 +1721,323 @@ ssize_t z_vrfy_zsock_recvfrom(int sock, void *buf, size_t max_len, int flags,
 #include <syscalls/zsock_recvfrom_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+ssize_t zsock_recvmsg_ctx(struct net_context *ctx, struct msghdr *msg,
+			  int flags)
+{
+	enum net_sock_type sock_type = net_context_get_type(ctx);
+	size_t max_len = 0;
+
+	msg->msg_flags = 0;
+
+	for (size_t i = 0; i < msg->msg_iovlen; i++) {
+		max_len += msg->msg_iov[i].iov_len;
+	}
+
+	if (sock_type == SOCK_DGRAM) {
+		return zsock_recv_dgram(ctx, msg, max_len, flags);
+	}
+
+	/* Ancillary data is only returned for datagrams */
+	msg->msg_controllen = 0;
+
+	if (sock_type == SOCK_STREAM) {
+		if (max_len == 0) {
+			return 0;
+		}
+
+		return zsock_recv_stream(ctx, msg, max_len, flags);
+	}
+
+	__ASSERT(0, "Unknown socket type");
+
+	return 0;
+}
+
+ssize_t z_impl_zsock_recvmsg(int sock, struct msghdr *msg, int flags)
+{
+	VTABLE_CALL(recvmsg, sock, msg, flags);
+}
+
+#ifdef CONFIG_USERSPACE
+static inline ssize_t z_vrfy_zsock_recvmsg(int sock, struct msghdr *msg,
+					   int flags)
+{
+	struct msghdr msg_copy;
+	struct iovec *user_iov;
+	size_t iov_size;
+	ssize_t ret;
+	size_t i;
+
+	Z_OOPS(z_user_from_copy(&msg_copy, (void *)msg, sizeof(msg_copy)));
+
+	Z_OOPS(msg_copy.msg_name &&
+	       Z_SYSCALL_MEMORY_WRITE(msg_copy.msg_name,
+				      msg_copy.msg_namelen));
+	Z_OOPS(msg_copy.msg_control &&
+	       Z_SYSCALL_MEMORY_WRITE(msg_copy.msg_control,
+				      msg_copy.msg_controllen));
+	Z_OOPS(size_mul_overflow(msg_copy.msg_iovlen, sizeof(struct iovec),
+				 &iov_size));
+
+	user_iov = msg_copy.msg_iov;
+
+	if (msg_copy.msg_iovlen > 0) {
+		msg_copy.msg_iov = z_user_alloc_from_copy(user_iov, iov_size);
+		if (!msg_copy.msg_iov) {
+			errno = ENOMEM;
+			return -1;
+		}
+	}
+
+	/* The data is written to the user buffers directly */
+	for (i = 0; i < msg_copy.msg_iovlen; i++) {
+		if (Z_SYSCALL_MEMORY_WRITE(msg_copy.msg_iov[i].iov_base,
+					   msg_copy.msg_iov[i].iov_len)) {
+			k_free(msg_copy.msg_iov);
+			errno = EFAULT;
+			return -1;
+		}
+	}
+
+	ret = z_impl_zsock_recvmsg(sock, &msg_copy, flags);
+
+	if (msg_copy.msg_iovlen > 0) {
+		k_free(msg_copy.msg_iov);
+	}
+
+	msg_copy.msg_iov = user_iov;
+	Z_OOPS(z_user_to_copy(msg, &msg_copy, sizeof(msg_copy)));
+
+	return ret;
+}
+#include <syscalls/zsock_recvmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+int z_impl_zsock_recvmmsg(int sock, struct mmsghdr *msgvec,
+			  unsigned int vlen, int flags)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	ssize_t ret = 0;
+	unsigned int i;
+	void *obj;
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (vtable->recvmsg == NULL) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	for (i = 0; i < vlen; i++) {
+		ret = vtable->recvmsg(obj, &msgvec[i].msg_hdr,
+				      flags & ~ZSOCK_MSG_WAITFORONE);
+		if (ret < 0) {
+			break;
+		}
+
+		msgvec[i].msg_len = ret;
+
+		if (flags & ZSOCK_MSG_WAITFORONE) {
+			flags |= ZSOCK_MSG_DONTWAIT;
+		}
+	}
+
+	k_mutex_unlock(lock);
+
+	/* An error is only reported if no message was received */
+	return (i > 0) ? (int)i : (int)ret;
+}
+
+#ifdef CONFIG_USERSPACE
+/* The messages are verified and received one at a time */
+static inline int z_vrfy_zsock_recvmmsg(int sock, struct mmsghdr *msgvec,
+					unsigned int vlen, int flags)
+{
+	unsigned int i;
+	ssize_t ret = 0;
+
+	for (i = 0; i < vlen; i++) {
+		unsigned int len;
+
+		ret = z_vrfy_zsock_recvmsg(sock, &msgvec[i].msg_hdr,
+					   flags & ~ZSOCK_MSG_WAITFORONE);
+		if (ret < 0) {
+			break;
+		}
+
+		len = ret;
+		Z_OOPS(z_user_to_copy(&msgvec[i].msg_len, &len, sizeof(len)));
+
+		if (flags & ZSOCK_MSG_WAITFORONE) {
+			flags |= ZSOCK_MSG_DONTWAIT;
+		}
+	}
+
+	return (i > 0) ? (int)i : (int)ret;
+}
+#include <syscalls/zsock_recvmmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+#if defined(CONFIG_NET_SOCKETS_RECV_LOAN)
+static ssize_t zsock_recv_loan_ctx(struct net_context *ctx,
+				   struct iovec *iov, size_t *iovcnt,
+				   void **loan, int flags)
+{
+	const bool stream = net_context_get_type(ctx) == SOCK_STREAM;
+	k_timeout_t timeout = K_FOREVER;
+	struct net_pkt *pkt;
+	struct net_buf *buf;
+	size_t count = 0;
+	size_t len = 0;
+	uint8_t *pos;
+	int res;
+
+	*loan = NULL;
+
+	if (stream && net_context_get_state(ctx) != NET_CONTEXT_CONNECTED) {
+		errno = ENOTCONN;
+		return -1;
+	}
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+	} else if (!stream || (!sock_is_eof(ctx) && !sock_is_error(ctx))) {
+		net_context_get_option(ctx, NET_OPT_RCVTIMEO, &timeout, NULL);
+	}
+
+	if (!K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		res = zsock_wait_data(ctx, &timeout);
+		if (res < 0 && res != -EAGAIN) {
+			errno = -res;
+			return -1;
+		}
+	}
+
+	pkt = k_fifo_peek_head(&ctx->recv_q);
+	if (!pkt) {
+		if (stream && sock_is_error(ctx)) {
+			errno = POINTER_TO_INT(ctx->user_data);
+			return -1;
+		} else if (stream && sock_is_eof(ctx)) {
+			*iovcnt = 0;
+			return 0;
+		}
+
+		errno = EAGAIN;
+		return -1;
+	}
+
+	/* The data starts at the cursor, which a previous zsock_recv() may
+	 * have moved into the packet.
+	 */
+	buf = pkt->cursor.buf;
+	pos = pkt->cursor.pos;
+
+	while (buf) {
+		size_t frag_len = buf->len - (pos - buf->data);
+
+		if (frag_len > 0) {
+			if (count < *iovcnt) {
+				iov[count].iov_base = pos;
+				iov[count].iov_len = frag_len;
+			}
+
+			count++;
+			len += frag_len;
+		}
+
+		buf = buf->frags;
+		pos = buf ? buf->data : NULL;
+	}
+
+	if (count > *iovcnt) {
+		*iovcnt = count;
+		errno = EMSGSIZE;
+		return -1;
+	}
+
+	/* The packet is the caller's until released. It keeps a reference
+	 * on the context, whose receive window the release reopens even if
+	 * the socket was closed in between.
+	 */
+	(void)k_fifo_get(&ctx->recv_q, K_NO_WAIT);
+	net_pkt_set_context(pkt, ctx);
+	net_context_ref(ctx);
+
+	if (stream && net_pkt_eof(pkt)) {
+		sock_set_eof(ctx);
+	}
+
+	*iovcnt = count;
+	*loan = pkt;
+
+	return len;
+}
+
+ssize_t zsock_recv_loan(int sock, struct iovec *iov, size_t *iovcnt,
+			void **loan, int flags)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	ssize_t ret;
+	void *obj;
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (vtable != &sock_fd_op_vtable) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	ret = zsock_recv_loan_ctx(obj, iov, iovcnt, loan, flags);
+
+	k_mutex_unlock(lock);
+
+	return ret;
+}
+
+void zsock_recv_loan_release(void *loan)
+{
+	struct net_pkt *pkt = loan;
+	struct net_context *ctx = net_pkt_context(pkt);
+
+	if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS)) {
+		net_socket_update_tc_rx_time(pkt, k_cycle_get_32());
+	}
+
+	if (net_context_get_type(ctx) == SOCK_STREAM) {
+		(void)k_mutex_lock(&ctx->lock, K_FOREVER);
+
+		/* The loaned data is consumed only now, reopen the receive
+		 * window. Closing the socket clears the receive callback,
+		 * there is no window left to open then.
+		 */
+		if (ctx->recv_cb != NULL) {
+			net_context_update_recv_wnd(ctx,
+						    net_pkt_remaining_data(pkt));
+		}
+
+		k_mutex_unlock(&ctx->lock);
+	}
+
+	net_pkt_unref(pkt);
+	net_context_unref(ctx);
+}
+#endif /* CONFIG_NET_SOCKETS_RECV_LOAN */
+
 /* As this is limited function, we don't follow POSIX signature, with
  * "..." instead of last arg.
  */
@@ -1598,6 +2168,11 @@ static inline int time_left(uint32_t start, uint32_t timeout)
 	return timeout - elapsed;
 }
 
+/* Every call brings its own set of descriptors, so the poll events are
+ * set up and torn down per call with k_poll() rather than kept on a
+ * k_poll_set, which only pays off when the same events are waited on
+ * again.
+ */
 int zsock_poll_internal(struct zsock_pollfd *fds, int nfds, k_timeout_t timeout)
 {
 	bool retry;
@@ -1861,6 +2436,21 @@ int zsock_getsockopt_ctx(struct net_context *ctx, int level, int optname,
 			return 0;
 		}
 
+		case SO_TIMESTAMPING:
+			if (IS_ENABLED(CONFIG_NET_CONTEXT_TIMESTAMPING)) {
+				ret = net_context_get_option(ctx,
+							     NET_OPT_TIMESTAMPING,
+							     optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
+			break;
+
 		case SO_TXTIME:
 			if (IS_ENABLED(CONFIG_NET_CONTEXT_TXTIME)) {
 				ret = net_context_get_option(ctx,
@@ -1925,6 +2515,15 @@ int zsock_getsockopt_ctx(struct net_context *ctx, int level, int optname,
 		case TCP_NODELAY:
 			ret = net_tcp_get_option(ctx, TCP_OPT_NODELAY, optval, optlen);
 			return ret;
+		case TCP_CONGESTION:
+			ret = net_tcp_get_option(ctx, TCP_OPT_CONGESTION, optval,
+						 optlen);
+			if (ret < 0) {
+				errno = -ret;
+				return -1;
+			}
+
+			return 0;
 		}
 
 		break;
@@ -1945,6 +2544,21 @@ int zsock_getsockopt_ctx(struct net_context *ctx, int level, int optname,
 				return 0;
 			}
 
+			break;
+
+		case IP_PKTINFO:
+			if (IS_ENABLED(CONFIG_NET_CONTEXT_RECV_PKTINFO)) {
+				ret = net_context_get_option(ctx,
+							     NET_OPT_RECV_PKTINFO,
+							     optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
 			break;
 		}
 
@@ -1966,6 +2580,21 @@ int zsock_getsockopt_ctx(struct net_context *ctx, int level, int optname,
 				return 0;
 			}
 
+			break;
+
+		case IPV6_RECVPKTINFO:
+			if (IS_ENABLED(CONFIG_NET_CONTEXT_RECV_PKTINFO)) {
+				ret = net_context_get_option(ctx,
+							     NET_OPT_RECV_PKTINFO,
+							     optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
 			break;
 		}
 
@@ -2136,6 +2765,21 @@ int zsock_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 
 			break;
 
+		case SO_TIMESTAMPING:
+			if (IS_ENABLED(CONFIG_NET_CONTEXT_TIMESTAMPING)) {
+				ret = net_context_set_option(ctx,
+							     NET_OPT_TIMESTAMPING,
+							     optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
+			break;
+
 		case SO_TXTIME:
 			if (IS_ENABLED(CONFIG_NET_CONTEXT_TXTIME)) {
 				ret = net_context_set_option(ctx,
@@ -2224,6 +2868,15 @@ int zsock_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 			ret = net_tcp_set_option(ctx,
 						 TCP_OPT_NODELAY, optval, optlen);
 			return ret;
+		case TCP_CONGESTION:
+			ret = net_tcp_set_option(ctx,
+						 TCP_OPT_CONGESTION, optval, optlen);
+			if (ret < 0) {
+				errno = -ret;
+				return -1;
+			}
+
+			return 0;
 		}
 		break;
 
@@ -2243,6 +2896,21 @@ int zsock_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 				return 0;
 			}
 
+			break;
+
+		case IP_PKTINFO:
+			if (IS_ENABLED(CONFIG_NET_CONTEXT_RECV_PKTINFO)) {
+				ret = net_context_set_option(ctx,
+							     NET_OPT_RECV_PKTINFO,
+							     optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
 			break;
 		}
 
@@ -2270,6 +2938,21 @@ int zsock_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 				return 0;
 			}
 
+			break;
+
+		case IPV6_RECVPKTINFO:
+			if (IS_ENABLED(CONFIG_NET_CONTEXT_RECV_PKTINFO)) {
+				ret = net_context_set_option(ctx,
+							     NET_OPT_RECV_PKTINFO,
+							     optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
 			break;
 		}
 
@@ -2594,6 +3277,11 @@ static ssize_t sock_recvfrom_vmeth(void *obj, void *buf, size_t max_len,
 				  src_addr, addrlen);
 }
 
+static ssize_t sock_recvmsg_vmeth(void *obj, struct msghdr *msg, int flags)
+{
+	return zsock_recvmsg_ctx(obj, msg, flags);
+}
+
 static int sock_getsockopt_vmeth(void *obj, int level, int optname,
 				 void *optval, socklen_t *optlen)
 {
@@ -2636,6 +3324,7 @@ const struct socket_op_vtable sock_fd_op_vtable = {
 	.accept = sock_accept_vmeth,
 	.sendto = sock_sendto_vmeth,
 	.sendmsg = sock_sendmsg_vmeth,
+	.recvmsg = sock_recvmsg_vmeth,
 	.recvfrom = sock_recvfrom_vmeth,
 	.getsockopt = sock_getsockopt_vmeth,
 	.setsockopt = sock_setsockopt_vmeth,
@@ -82,6 +82,14 @@
  */
 int pipeput(struct k_pipe *pipe, enum pipe_options
 		 option, int size, int count, uint32_t *time);
+int pipeput_gather(struct k_pipe *pipe, bool use_iov, int size, int count,
+		   uint32_t *time);
+
+/* Header sent in front of each payload by pipeput_gather() */
+#define GATHER_HEADER_SIZE 8
+
+static char gather_header[GATHER_HEADER_SIZE];
+static char gather_buf[MESSAGE_SIZE_PIPE];
 
 /*
  * Function declarations.
@@ -177,6 +185,43 @@ void pipe_test(void)
 		PRINT_STRING(dashline, output_file);
 		k_thread_priority_set(k_current_get(), TaskPrio);
 	}
+
+	/* header and payload from separate buffers, matching (ALL_N) */
+	PRINT_STRING("|              Send a header and a payload "
+		     "from separate buffers              |\n", output_file);
+	PRINT_STRING(dashline, output_file);
+
+	for (int use_iov = 0; use_iov < 2; use_iov++) {
+		if (use_iov == 0) {
+			PRINT_STRING("|         header + payload copied into "
+				     "one buffer, then put (_ALL_N)          |\n",
+				     output_file);
+		} else {
+			PRINT_STRING("|           header + payload gathered by "
+				     "k_pipe_put_iov() (_ALL_N)            |\n",
+				     output_file);
+		}
+		PRINT_STRING(dashline, output_file);
+		PRINT_ALL_TO_N_HEADER_UNIT();
+		PRINT_STRING(dashline, output_file);
+		PRINT_STRING("| put | get |  no buf  | small buf| big buf  |"
+			     "  no buf  | small buf| big buf  |\n", output_file);
+		PRINT_STRING(dashline, output_file);
+
+		for (putsize = 2 * GATHER_HEADER_SIZE;
+		     putsize <= MESSAGE_SIZE_PIPE; putsize <<= 1) {
+			for (pipe = 0; pipe < 3; pipe++) {
+				pipeput_gather(test_pipes[pipe], use_iov != 0,
+					       putsize, NR_OF_PIPE_RUNS,
+					       &puttime[pipe]);
+
+				/* waiting for ack */
+				k_msgq_get(&CH_COMM, &getinfo, K_FOREVER);
+			}
+			PRINT_ALL_TO_N();
+		}
+		PRINT_STRING(dashline, output_file);
+	}
 }
 
 
@@ -251,4 +296,69 @@ int pipeput(struct k_pipe *pipe,
 	return 0;
 }
 
+
+/**
+ *
+ * @brief Write packets made of a header and a payload and measure time
+ *
+ * The header and the payload live in separate buffers, as they do when
+ * a protocol header is put in front of audio samples or a log record.
+ * They are either copied into one buffer and written with k_pipe_put(),
+ * or written from where they are with k_pipe_put_iov().
+ *
+ * @return 0 on success, 1 on error
+ *
+ * @param pipe     The pipe to be tested.
+ * @param use_iov  Write with k_pipe_put_iov() instead of copying.
+ * @param size     Packet size, including the header.
+ * @param count    Number of packets.
+ * @param time     Total write time.
+ */
+int pipeput_gather(struct k_pipe *pipe, bool use_iov, int size, int count,
+		   uint32_t *time)
+{
+	struct k_pipe_iovec iov[2] = {
+		{ gather_header, GATHER_HEADER_SIZE },
+		{ data_bench, size - GATHER_HEADER_SIZE },
+	};
+	unsigned int t;
+	size_t sizexferd;
+	int ret;
+
+	/* first sync with the receiver */
+	k_sem_give(&SEM0);
+	t = BENCH_START();
+	for (int i = 0; i < count; i++) {
+		if (use_iov) {
+			ret = k_pipe_put_iov(pipe, iov, ARRAY_SIZE(iov),
+					     &sizexferd, size, K_FOREVER);
+		} else {
+			memcpy(gather_buf, gather_header, GATHER_HEADER_SIZE);
+			memcpy(&gather_buf[GATHER_HEADER_SIZE], data_bench,
+			       size - GATHER_HEADER_SIZE);
+			ret = k_pipe_put(pipe, gather_buf, size, &sizexferd,
+					 size, K_FOREVER);
+		}
+
+		if ((ret != 0) || (sizexferd != (size_t)size)) {
+			return 1;
+		}
+	}
+
+	t = TIME_STAMP_DELTA_GET(t);
+	*time = SYS_CLOCK_HW_CYCLES_TO_NS_AVG(t, count);
+	if (bench_test_end() < 0) {
+		if (high_timer_overflow()) {
+			PRINT_STRING("| Timer overflow."
+					"Results are invalid            ",
+						 output_file);
+		} else {
+	PRINT_STRING("| Tick occurred. Results may be inaccurate       ",
+						 output_file);
+		}
+		PRINT_STRING("                             |\n", output_file);
+	}
+	return 0;
+}
+
 #endif /* PIPE_BENCH */
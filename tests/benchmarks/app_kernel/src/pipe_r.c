@@ -70,6 +70,21 @@ void piperecvtask(void)
 	}
 	}
 
+	/* header and payload from separate buffers, copied and gathered */
+	for (int use_iov = 0; use_iov < 2; use_iov++) {
+		for (getsize = 16; getsize <= MESSAGE_SIZE_PIPE; getsize <<= 1) {
+			for (pipe = 0; pipe < 3; pipe++) {
+				getcount = NR_OF_PIPE_RUNS;
+				pipeget(test_pipes[pipe], _ALL_N, getsize,
+					getcount, &gettime);
+				getinfo.time = gettime;
+				getinfo.size = getsize;
+				getinfo.count = getcount;
+				/* acknowledge to master */
+				k_msgq_put(&CH_COMM, &getinfo, K_FOREVER);
+			}
+		}
+	}
 }
 
 
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/mem_manage.h>
+
+/* This is a demand paging benchmark.  It maps an anonymous memory arena
+ * larger than the free physical memory, so that the pages which do not
+ * fit live in the backing store, and then touches it following a few
+ * access patterns.  The number of page faults taken by each pattern
+ * shows how well the eviction algorithm, and read ahead if enabled,
+ * keep the pages about to be used in memory.
+ */
+
+#ifdef CONFIG_BACKING_STORE_RAM_PAGES
+#define EXTRA_PAGES	(CONFIG_BACKING_STORE_RAM_PAGES - 1)
+#else
+#error "Unsupported configuration"
+#endif
+
+#define N_PASSES	4
+#define N_ACCESSES	20000
+
+/* Percentage of the hot/cold accesses going to the hot pages */
+#define HOT_PERCENT	95
+
+/* Every that many accesses is a write */
+#define WRITE_EVERY	4
+
+static uint8_t *arena;
+static size_t arena_pages;
+static size_t free_pages;
+
+static uint32_t rand_state = 0x12345678;
+
+static uint32_t rand32(void)
+{
+	/* xorshift32, for a sequence which is the same on every run */
+	rand_state ^= rand_state << 13;
+	rand_state ^= rand_state >> 17;
+	rand_state ^= rand_state << 5;
+
+	return rand_state;
+}
+
+static void touch(size_t page, uint32_t n)
+{
+	volatile uint8_t *pos = &arena[page * CONFIG_MMU_PAGE_SIZE +
+				       (n % CONFIG_MMU_PAGE_SIZE)];
+
+	if ((n % WRITE_EVERY) == 0U) {
+		*pos = (uint8_t)n;
+	} else {
+		(void)*pos;
+	}
+}
+
+/* Sweep the whole arena a few times, page after page */
+static uint32_t pattern_sequential(void)
+{
+	uint32_t n = 0U;
+
+	for (int pass = 0; pass < N_PASSES; pass++) {
+		for (size_t page = 0; page < arena_pages; page++) {
+			touch(page, n++);
+		}
+	}
+
+	return n;
+}
+
+/* Mostly touch a set of hot pages fitting in memory, with occasional
+ * accesses to the rest of the arena
+ */
+static uint32_t pattern_hot_cold(void)
+{
+	size_t hot_pages = MAX(free_pages / 2U, 1U);
+	uint32_t n;
+
+	for (n = 0U; n < N_ACCESSES; n++) {
+		uint32_t r = rand32();
+
+		if ((r % 100U) < HOT_PERCENT) {
+			touch((r / 100U) % hot_pages, n);
+		} else {
+			touch(hot_pages + ((r / 100U) % (arena_pages - hot_pages)),
+			      n);
+		}
+	}
+
+	return n;
+}
+
+/* Touch random pages all over the arena */
+static uint32_t pattern_random(void)
+{
+	uint32_t n;
+
+	for (n = 0U; n < N_ACCESSES; n++) {
+		touch(rand32() % arena_pages, n);
+	}
+
+	return n;
+}
+
+static void run(const char *name, uint32_t (*pattern)(void))
+{
+	struct k_mem_paging_stats_t before, after;
+	uint32_t start, ms, accesses;
+	unsigned long faults, evictions;
+
+	k_mem_paging_stats_get(&before);
+	start = k_uptime_get_32();
+
+	accesses = pattern();
+
+	ms = k_uptime_get_32() - start;
+	k_mem_paging_stats_get(&after);
+
+	faults = after.pagefaults.cnt - before.pagefaults.cnt;
+	evictions = (after.eviction.clean + after.eviction.dirty) -
+		    (before.eviction.clean + before.eviction.dirty);
+
+	printk("%-10s accesses %6u faults %6lu (%lu per 1000) evictions %6lu (%lu dirty) prefetched %6lu cleaned %6lu %5u ms\n",
+	       name, accesses, faults, (faults * 1000UL) / accesses, evictions,
+	       after.eviction.dirty - before.eviction.dirty,
+	       after.pagefaults.prefetched - before.pagefaults.prefetched,
+	       after.eviction.cleaned - before.eviction.cleaned, ms);
+}
+
+int main(void)
+{
+	size_t size;
+
+	free_pages = k_mem_free_get() / CONFIG_MMU_PAGE_SIZE;
+	size = k_mem_free_get() + (EXTRA_PAGES * CONFIG_MMU_PAGE_SIZE);
+
+	arena = k_mem_map(size, K_MEM_PERM_RW);
+	if (arena == NULL) {
+		printk("failed to map anonymous memory arena size %zu\n", size);
+		return 0;
+	}
+	arena_pages = size / CONFIG_MMU_PAGE_SIZE;
+
+	printk("arena %zu pages, %zu fit in memory, eviction %s, prefetch %d\n",
+	       arena_pages, free_pages,
+	       IS_ENABLED(CONFIG_EVICTION_CLOCK) ? "clock" :
+	       (IS_ENABLED(CONFIG_EVICTION_NRU) ? "nru" : "custom"),
+	       CONFIG_DEMAND_PAGING_PREFETCH);
+
+	run("sequential", pattern_sequential);
+	run("hot/cold", pattern_hot_cold);
+	run("random", pattern_random);
+
+	printk("fin\n");
+
+	return 0;
+}
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <tracing_user.h>
+
+/* This is a k_mutex contention benchmark for SMP.  A number of worker
+ * threads repeatedly lock a shared mutex, run a short critical
+ * section, unlock it and run a similar amount of unrelated work, so
+ * that with more than one worker the mutex is often found held by a
+ * thread running on another CPU.  Every time a worker has to pend on
+ * the mutex it costs two context switches (out, and back in once it
+ * is handed the mutex); these pends are counted through the user
+ * tracing hooks.  The run is repeated for 1 .. arch_num_cpus()
+ * workers, and the number of pends and the average cost of a
+ * lock/unlock cycle are reported, which shows how many context
+ * switches CONFIG_MUTEX_ADAPTIVE_SPIN avoids.
+ */
+
+#define N_OPS 20000
+#define STACK_SIZE 1024
+
+/* Busy loop iterations inside and outside of the critical section */
+#define CS_LOOPS 100
+#define NONCS_LOOPS 100
+
+#define WORKER_PRIO K_PRIO_PREEMPT(1)
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, CONFIG_MP_MAX_NUM_CPUS, STACK_SIZE);
+static struct k_thread workers[CONFIG_MP_MAX_NUM_CPUS];
+static uint64_t worker_ns[CONFIG_MP_MAX_NUM_CPUS];
+
+static K_MUTEX_DEFINE(mutex);
+static volatile uint32_t shared_counter;
+
+static atomic_t n_ready;
+static atomic_t n_pends;
+static unsigned int n_workers;
+
+void sys_trace_thread_pend_user(struct k_thread *thread)
+{
+	if ((thread >= &workers[0]) && (thread < &workers[n_workers])) {
+		atomic_inc(&n_pends);
+	}
+}
+
+static void busy(unsigned int loops)
+{
+	for (volatile unsigned int i = 0; i < loops; i++) {
+	}
+}
+
+static void worker_fn(void *p1, void *p2, void *p3)
+{
+	unsigned int id = POINTER_TO_UINT(p1);
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	/* Start all workers together so they really contend */
+	atomic_inc(&n_ready);
+	while ((unsigned int)atomic_get(&n_ready) < n_workers) {
+	}
+
+	uint32_t start = k_cycle_get_32();
+
+	for (int i = 0; i < N_OPS; i++) {
+		k_mutex_lock(&mutex, K_FOREVER);
+		shared_counter++;
+		busy(CS_LOOPS);
+		k_mutex_unlock(&mutex);
+
+		busy(NONCS_LOOPS);
+	}
+
+	worker_ns[id] = k_cyc_to_ns_floor64(k_cycle_get_32() - start) / N_OPS;
+}
+
+static void run_workers(unsigned int n)
+{
+	uint64_t total_ns = 0U;
+	uint32_t pends;
+
+	n_workers = n;
+	atomic_set(&n_ready, 0);
+	atomic_set(&n_pends, 0);
+	shared_counter = 0U;
+
+	for (unsigned int i = 0; i < n; i++) {
+		k_thread_create(&workers[i], stacks[i],
+				K_THREAD_STACK_SIZEOF(stacks[i]),
+				worker_fn, UINT_TO_POINTER(i), NULL, NULL,
+				WORKER_PRIO, 0, K_NO_WAIT);
+	}
+
+	for (unsigned int i = 0; i < n; i++) {
+		k_thread_join(&workers[i], K_FOREVER);
+		total_ns += worker_ns[i];
+	}
+
+	pends = (uint32_t)atomic_get(&n_pends);
+
+	if (shared_counter != n * N_OPS) {
+		printk("ERROR: counter %u, expected %u\n",
+		       shared_counter, n * N_OPS);
+	}
+
+	printk("threads %2u ops %7u pends %7u (%4u per 1000 ops) %6u ns per op\n",
+	       n, n * N_OPS, pends, (uint32_t)((pends * 1000ULL) / (n * N_OPS)),
+	       (uint32_t)(total_ns / n));
+}
+
+int main(void)
+{
+	unsigned int num_cpus = arch_num_cpus();
+
+	printk("%u cpus, adaptive spin %s\n", num_cpus,
+	       IS_ENABLED(CONFIG_MUTEX_ADAPTIVE_SPIN) ? "on" : "off");
+
+	for (unsigned int n = 1; n <= num_cpus; n++) {
+		run_workers(n);
+	}
+
+	printk("fin\n");
+	return 0;
+}
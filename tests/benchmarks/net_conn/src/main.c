@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/net_pkt.h>
+
+#include "connection.h"
+
+/* This benchmark measures the cost of finding the handler of an incoming
+ * UDP packet in net_conn_input(), with a growing number of handlers bound
+ * to a remote and a local address and port, plus one handler listening on
+ * any address.
+ */
+
+#define N_LOOPS		10000
+#define LOCAL_PORT	4000
+#define REMOTE_PORT	5000
+#define LISTEN_PORT	7
+
+static const int steps[] = { 1, 8, 32, 128, 256 };
+
+static struct net_conn_handle *handles[256];
+static struct net_conn_handle *listener;
+
+static struct in_addr local_addr = { { { 192, 0, 2, 1 } } };
+static struct in_addr remote_addr = { { { 192, 0, 2, 2 } } };
+
+static uint32_t delivered;
+
+static enum net_verdict conn_cb(struct net_conn *conn, struct net_pkt *pkt,
+				union net_ip_header *ip_hdr,
+				union net_proto_header *proto_hdr,
+				void *user_data)
+{
+	delivered++;
+
+	/* The packet is reused for the next loop */
+	return NET_OK;
+}
+
+static int register_conn(uint16_t remote_port, uint16_t local_port,
+			 struct net_conn_handle **handle)
+{
+	struct sockaddr_in remote = {
+		.sin_family = AF_INET,
+		.sin_addr = remote_addr,
+	};
+	struct sockaddr_in local = {
+		.sin_family = AF_INET,
+		.sin_addr = local_addr,
+	};
+
+	return net_conn_register(IPPROTO_UDP, AF_INET,
+				 remote_port ? (struct sockaddr *)&remote : NULL,
+				 (struct sockaddr *)&local,
+				 remote_port, local_port, NULL, conn_cb, NULL,
+				 handle);
+}
+
+static uint32_t run(struct net_pkt *pkt, struct net_ipv4_hdr *ip,
+		    struct net_udp_hdr *udp, uint16_t dst_port)
+{
+	union net_ip_header ip_hdr = { .ipv4 = ip };
+	union net_proto_header proto_hdr = { .udp = udp };
+	uint32_t start, cycles;
+
+	udp->dst_port = htons(dst_port);
+	delivered = 0U;
+
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < N_LOOPS; i++) {
+		(void)net_conn_input(pkt, &ip_hdr, IPPROTO_UDP, &proto_hdr);
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	if (delivered != N_LOOPS) {
+		printk("only %u of %u packets delivered\n", delivered, N_LOOPS);
+	}
+
+	return (uint32_t)(k_cyc_to_ns_floor64(cycles) / N_LOOPS);
+}
+
+int main(void)
+{
+	struct net_ipv4_hdr ip = { 0 };
+	struct net_udp_hdr udp = { 0 };
+	struct net_pkt *pkt;
+	int count = 0;
+	int ret;
+
+	pkt = net_pkt_alloc_on_iface(net_if_get_default(), K_FOREVER);
+	net_pkt_set_family(pkt, AF_INET);
+
+	net_ipv4_addr_copy_raw(ip.src, (uint8_t *)&remote_addr);
+	net_ipv4_addr_copy_raw(ip.dst, (uint8_t *)&local_addr);
+	udp.src_port = htons(REMOTE_PORT);
+
+	ret = register_conn(0, LISTEN_PORT, &listener);
+	if (ret < 0) {
+		printk("cannot register listener (%d)\n", ret);
+		return 0;
+	}
+
+	printk("connection hash %s, ns per packet\n",
+	       IS_ENABLED(CONFIG_NET_CONN_HASH) ? "enabled" : "disabled");
+	printk("connections  connected   listener\n");
+
+	for (int s = 0; s < ARRAY_SIZE(steps); s++) {
+		for (; count < steps[s]; count++) {
+			ret = register_conn(REMOTE_PORT, LOCAL_PORT + count,
+					    &handles[count]);
+			if (ret < 0) {
+				printk("cannot register connection %d (%d)\n",
+				       count, ret);
+				return 0;
+			}
+		}
+
+		printk("%11d %7u ns %7u ns\n", count,
+		       run(pkt, &ip, &udp, LOCAL_PORT),
+		       run(pkt, &ip, &udp, LISTEN_PORT));
+	}
+
+	for (int i = 0; i < count; i++) {
+		(void)net_conn_unregister(handles[i]);
+	}
+
+	(void)net_conn_unregister(listener);
+	net_pkt_unref(pkt);
+
+	printk("fin\n");
+
+	return 0;
+}
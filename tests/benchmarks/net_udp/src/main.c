@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/net/socket.h>
+
+/* This benchmark measures the UDP throughput between two sockets over
+ * the loopback interface, for a few payload sizes. Every round, a batch
+ * of datagrams is sent and then received, either with one zsock_send()
+ * and one zsock_recv() call per datagram, or with one zsock_sendmmsg()
+ * call and as few zsock_recvmmsg() calls as the datagrams arrive in.
+ */
+
+#define N_ROUNDS	2000
+#define BATCH		8
+#define MAX_PAYLOAD	1024
+#define SERVER_PORT	4242
+
+#ifdef CONFIG_BOARD_NATIVE_POSIX
+/* The simulated CPU takes no time to run code, so use the host clock */
+#include <time.h>
+
+static uint64_t stamp(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * NSEC_PER_SEC + ts.tv_nsec;
+}
+
+static uint64_t stamp_ns(uint64_t start)
+{
+	return stamp() - start;
+}
+#elif defined(CONFIG_ARCH_POSIX)
+#error "This benchmark cannot be built for other POSIX arch boards than native_posix"
+#else
+static uint64_t stamp(void)
+{
+	return k_cycle_get_32();
+}
+
+static uint64_t stamp_ns(uint64_t start)
+{
+	return k_cyc_to_ns_floor64((uint32_t)(k_cycle_get_32() - start));
+}
+#endif
+
+static const size_t sizes[] = { 64, 512, MAX_PAYLOAD };
+
+static uint8_t tx_buf[MAX_PAYLOAD];
+static uint8_t rx_bufs[BATCH][MAX_PAYLOAD];
+
+static struct iovec tx_iov[BATCH];
+static struct iovec rx_iov[BATCH];
+static struct mmsghdr tx_msgs[BATCH];
+static struct mmsghdr rx_msgs[BATCH];
+
+static int sock_c;
+static int sock_s;
+
+static int round_single(size_t len)
+{
+	for (int i = 0; i < BATCH; i++) {
+		if (zsock_send(sock_c, tx_buf, len, 0) != (ssize_t)len) {
+			return -errno;
+		}
+	}
+
+	for (int i = 0; i < BATCH; i++) {
+		if (zsock_recv(sock_s, rx_bufs[i], sizeof(rx_bufs[i]), 0) !=
+		    (ssize_t)len) {
+			return -errno;
+		}
+	}
+
+	return 0;
+}
+
+static int round_batch(size_t len)
+{
+	int count = 0;
+	int ret;
+
+	ret = zsock_sendmmsg(sock_c, tx_msgs, BATCH, 0);
+	if (ret != BATCH) {
+		return (ret < 0) ? -errno : -EIO;
+	}
+
+	/* Datagrams still in the loopback path are not waited for */
+	while (count < BATCH) {
+		ret = zsock_recvmmsg(sock_s, &rx_msgs[count], BATCH - count,
+				     ZSOCK_MSG_WAITFORONE);
+		if (ret < 0) {
+			return -errno;
+		}
+
+		count += ret;
+	}
+
+	return 0;
+}
+
+static int run(int (*round)(size_t len), size_t len, uint32_t *pps)
+{
+	uint64_t start, ns;
+	int ret;
+
+	for (int i = 0; i < BATCH; i++) {
+		tx_iov[i].iov_len = len;
+	}
+
+	start = stamp();
+
+	for (int i = 0; i < N_ROUNDS; i++) {
+		ret = round(len);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	ns = stamp_ns(start);
+	*pps = (uint32_t)(((uint64_t)N_ROUNDS * BATCH * NSEC_PER_SEC) /
+			  MAX(ns, 1));
+
+	return 0;
+}
+
+static int setup(void)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(SERVER_PORT),
+	};
+
+	zsock_inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+
+	sock_s = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	sock_c = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	if (sock_s < 0 || sock_c < 0) {
+		return -errno;
+	}
+
+	if (zsock_bind(sock_s, (struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+	    zsock_connect(sock_c, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+		return -errno;
+	}
+
+	for (int i = 0; i < BATCH; i++) {
+		tx_iov[i].iov_base = tx_buf;
+		tx_msgs[i].msg_hdr.msg_iov = &tx_iov[i];
+		tx_msgs[i].msg_hdr.msg_iovlen = 1;
+
+		rx_iov[i].iov_base = rx_bufs[i];
+		rx_iov[i].iov_len = sizeof(rx_bufs[i]);
+		rx_msgs[i].msg_hdr.msg_iov = &rx_iov[i];
+		rx_msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	return 0;
+}
+
+int main(void)
+{
+	uint32_t single, batch;
+	int ret;
+
+	ret = setup();
+	if (ret < 0) {
+		printk("cannot set up sockets (%d)\n", ret);
+		return 0;
+	}
+
+	printk("batches of %d datagrams\n", BATCH);
+	printk("payload        send/recv             sendmmsg/recvmmsg\n");
+
+	for (int s = 0; s < ARRAY_SIZE(sizes); s++) {
+		ret = run(round_single, sizes[s], &single);
+		if (ret == 0) {
+			ret = run(round_batch, sizes[s], &batch);
+		}
+
+		if (ret < 0) {
+			printk("%zu bytes failed (%d)\n", sizes[s], ret);
+			return 0;
+		}
+
+		printk("%7zu %8u pkt/s %7u kbit/s %8u pkt/s %7u kbit/s\n",
+		       sizes[s],
+		       single, (uint32_t)((uint64_t)single * sizes[s] * 8 / 1000),
+		       batch, (uint32_t)((uint64_t)batch * sizes[s] * 8 / 1000));
+	}
+
+	(void)zsock_close(sock_c);
+	(void)zsock_close(sock_s);
+
+	printk("fin\n");
+
+	return 0;
+}
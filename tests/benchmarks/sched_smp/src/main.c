@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+
+/* This is an SMP scheduler microbenchmark.  It measures how long it
+ * takes to hand the CPU from one thread to another as the number of
+ * busy CPUs grows.  The work is done by "pairs" of threads that
+ * ping-pong through two semaphores: each hand-off readies the
+ * partner and pends the caller, so at most one thread of a pair is
+ * runnable at any time and every pair keeps roughly one CPU busy.
+ *
+ * For N = 1 .. arch_num_cpus() it starts N pairs at once, lets them
+ * run a fixed number of hand-offs and reports the average cost of a
+ * hand-off across all pairs.  With a single global run queue this
+ * cost tends to grow with N as the CPUs contend on the scheduler
+ * lock and on a shared queue; CONFIG_SCHED_CPU_RUNQ_STEAL can be
+ * enabled to compare against per-CPU run queues.
+ */
+
+#define N_ROUNDS 10000
+#define N_SETTLE 1
+#define STACK_SIZE 1024
+
+/* Below main, so main can always create and join the pairs */
+#define PAIR_PRIO K_PRIO_PREEMPT(1)
+
+struct pair {
+	struct k_sem ping;
+	struct k_sem pong;
+	uint64_t ns;
+};
+
+static K_THREAD_STACK_ARRAY_DEFINE(ping_stacks, CONFIG_MP_MAX_NUM_CPUS,
+				   STACK_SIZE);
+static K_THREAD_STACK_ARRAY_DEFINE(pong_stacks, CONFIG_MP_MAX_NUM_CPUS,
+				   STACK_SIZE);
+static struct k_thread ping_threads[CONFIG_MP_MAX_NUM_CPUS];
+static struct k_thread pong_threads[CONFIG_MP_MAX_NUM_CPUS];
+static struct pair pairs[CONFIG_MP_MAX_NUM_CPUS];
+
+static atomic_t n_ready;
+static unsigned int n_pairs;
+
+static void ping_fn(void *p1, void *p2, void *p3)
+{
+	struct pair *pair = p1;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	/* Start all pairs at the same time so they really overlap */
+	atomic_inc(&n_ready);
+	while ((unsigned int)atomic_get(&n_ready) < n_pairs) {
+	}
+
+	uint32_t start = k_cycle_get_32();
+
+	for (int i = 0; i < N_ROUNDS; i++) {
+		k_sem_give(&pair->pong);
+		k_sem_take(&pair->ping, K_FOREVER);
+	}
+
+	/* Two hand-offs per round */
+	pair->ns = k_cyc_to_ns_floor64(k_cycle_get_32() - start) /
+		   (2 * N_ROUNDS);
+}
+
+static void pong_fn(void *p1, void *p2, void *p3)
+{
+	struct pair *pair = p1;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < N_ROUNDS; i++) {
+		k_sem_take(&pair->pong, K_FOREVER);
+		k_sem_give(&pair->ping);
+	}
+}
+
+static uint32_t run_pairs(unsigned int n)
+{
+	uint64_t total = 0U;
+
+	n_pairs = n;
+	atomic_set(&n_ready, 0);
+
+	for (unsigned int i = 0; i < n; i++) {
+		k_sem_init(&pairs[i].ping, 0, 1);
+		k_sem_init(&pairs[i].pong, 0, 1);
+
+		k_thread_create(&pong_threads[i], pong_stacks[i],
+				K_THREAD_STACK_SIZEOF(pong_stacks[i]),
+				pong_fn, &pairs[i], NULL, NULL,
+				PAIR_PRIO, 0, K_NO_WAIT);
+		k_thread_create(&ping_threads[i], ping_stacks[i],
+				K_THREAD_STACK_SIZEOF(ping_stacks[i]),
+				ping_fn, &pairs[i], NULL, NULL,
+				PAIR_PRIO, 0, K_NO_WAIT);
+	}
+
+	for (unsigned int i = 0; i < n; i++) {
+		k_thread_join(&ping_threads[i], K_FOREVER);
+		k_thread_join(&pong_threads[i], K_FOREVER);
+		total += pairs[i].ns;
+	}
+
+	return total / n;
+}
+
+int main(void)
+{
+	unsigned int num_cpus = arch_num_cpus();
+
+	printk("%u cpus, %d hand-offs per pair\n", num_cpus, 2 * N_ROUNDS);
+
+	/* Warm up caches and the lazily initialized bits of the kernel */
+	for (int i = 0; i < N_SETTLE; i++) {
+		(void)run_pairs(1);
+	}
+
+	for (unsigned int n = 1; n <= num_cpus; n++) {
+		printk("busy cpus %2u switch %6u ns per handoff\n",
+		       n, run_pairs(n));
+	}
+
+	printk("fin\n");
+	return 0;
+}
@@ -6,6 +6,7 @@
 
 #include <zephyr/kernel.h>
 #include <zephyr/sys/printk.h>
+#include <zephyr/sys/libc-hooks.h>
 #include <zephyr/wait_q.h>
 #include <ksched.h>
 
@@ -114,6 +115,74 @@ static int exec_test(uint8_t nb_threads)
 	return yielder_status;
 }
 
+static K_SEM_DEFINE(syscall_sem_obj, 0, 1);
+
+struct syscall_test {
+	const char *name;
+	k_thread_entry_t entry;
+};
+
+static const struct syscall_test syscall_tests[] = {
+	{ "k_sem_give/k_sem_take", syscall_sem },
+	{ "k_uptime_ticks", syscall_uptime_ticks },
+	{ "k_uptime_get", syscall_uptime_get },
+};
+
+void syscall_entry(void *_thread, void *_entry, void *_unused)
+{
+	struct k_app_thread *thread = (struct k_app_thread *) _thread;
+	int ret;
+
+	struct k_mem_partition *parts[] = {
+		thread->partition,
+#ifdef Z_LIBC_PARTITION_EXISTS
+		&z_libc_partition,
+#endif
+	};
+
+	ret = k_mem_domain_init(&thread->domain, ARRAY_SIZE(parts), parts);
+	if (ret != 0) {
+		printk("k_mem_domain_init failed %d\n", ret);
+		yielder_status = 1;
+		return;
+	}
+
+	k_mem_domain_add_thread(&thread->domain, k_current_get());
+	k_thread_access_grant(k_current_get(), &syscall_sem_obj);
+
+	k_thread_user_mode_enter((k_thread_entry_t)_entry, &syscall_sem_obj,
+				 NULL, NULL);
+}
+
+static int exec_syscall_test(const struct syscall_test *test)
+{
+	yielder_status = 0;
+
+	app_threads[0].partition = app_partitions[0];
+	app_threads[0].stack = &app_thread_stacks[0];
+
+	threads[0] = k_thread_create(&app_threads[0].thread,
+				     app_thread_stacks[0],
+				     APP_STACKSIZE, syscall_entry,
+				     &app_threads[0], test->entry, NULL,
+				     THREADS_PRIO, 0, K_FOREVER);
+
+	k_thread_priority_set(k_current_get(), MAIN_PRIO);
+
+	stamp(MEAS_START);
+	k_thread_start(threads[0]);
+	k_thread_join(threads[0], K_FOREVER);
+	stamp(MEAS_END);
+
+	uint32_t full_time = stamps[MEAS_END] - stamps[MEAS_START];
+	uint64_t time_ns = k_cyc_to_ns_near64(full_time)/NB_SYSCALLS;
+
+	printk("%-22s: %8" PRIu32 " cyc & %6" PRIu32 " calls -> %6"
+				PRIu64 " ns per call\n", test->name, full_time,
+				NB_SYSCALLS, time_ns);
+
+	return yielder_status;
+}
 
 int main(void)
 {
@@ -134,6 +203,19 @@ int main(void)
 		}
 	}
 
+	printk("============================\n");
+	printk("user->kernel system calls (object cache %s, time page %s)\n",
+	       IS_ENABLED(CONFIG_USERSPACE_OBJ_CACHE) ? "on" : "off",
+	       IS_ENABLED(CONFIG_USERSPACE_TIME_PAGE) ? "on" : "off");
+
+	for (size_t i = 0; i < ARRAY_SIZE(syscall_tests); i++) {
+		ret = exec_syscall_test(&syscall_tests[i]);
+		if (ret != 0) {
+			printk("FAIL\n");
+			return 0;
+		}
+	}
+
 	printk("SUCCESS\n");
 	return 0;
 }
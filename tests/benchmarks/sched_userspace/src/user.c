@@ -19,3 +19,34 @@ void context_switch_yield(void *p1, void *p2, void *p3)
 		k_yield();
 	}
 }
+
+/* Two calls validating the same kernel object */
+void syscall_sem(void *p1, void *p2, void *p3)
+{
+	struct k_sem *sem = p1;
+
+	for (uint32_t i = 0; i < NB_SYSCALLS / 2; i++) {
+		k_sem_give(sem);
+		(void)k_sem_take(sem, K_NO_WAIT);
+	}
+}
+
+/* A call without any kernel object */
+void syscall_uptime_ticks(void *p1, void *p2, void *p3)
+{
+	volatile int64_t sink;
+
+	for (uint32_t i = 0; i < NB_SYSCALLS; i++) {
+		sink = k_uptime_ticks();
+	}
+}
+
+/* Served without a system call with CONFIG_USERSPACE_TIME_PAGE */
+void syscall_uptime_get(void *p1, void *p2, void *p3)
+{
+	volatile int64_t sink;
+
+	for (uint32_t i = 0; i < NB_SYSCALLS; i++) {
+		sink = k_uptime_get();
+	}
+}
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/mutex.h>
+#include <zephyr/sys/condvar.h>
+#include <zephyr/sys/rwlock.h>
+#include <zephyr/app_memory/app_memdomain.h>
+
+/* This benchmark measures the cost of locking and unlocking from user
+ * threads, with k_mutex, which takes a system call for every operation,
+ * and with the sys_mutex, sys_rwlock and sys_condvar user mode
+ * primitives. Each loop runs in one user thread, uncontended, then for
+ * the mutexes in two user threads yielding to each other while holding
+ * the lock, so that every lock is contended.
+ */
+
+#define N_LOOPS		10000
+#define N_THREADS	2
+#define STACK_SIZE	1024
+#define THREAD_PRIO	5
+
+K_APPMEM_PARTITION_DEFINE(bench_part);
+#define BENCH_BMEM K_APP_BMEM(bench_part)
+
+static K_MUTEX_DEFINE(kernel_mutex);
+BENCH_BMEM SYS_MUTEX_DEFINE(user_mutex);
+BENCH_BMEM SYS_RWLOCK_DEFINE(user_rwlock);
+BENCH_BMEM SYS_CONDVAR_DEFINE(user_condvar);
+
+static BENCH_BMEM uint32_t counter;
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, N_THREADS, STACK_SIZE);
+static struct k_thread threads[N_THREADS];
+
+static void k_mutex_loop(void *p1, void *p2, void *p3)
+{
+	bool contended = POINTER_TO_INT(p1) > 1;
+
+	for (int i = 0; i < N_LOOPS; i++) {
+		k_mutex_lock(&kernel_mutex, K_FOREVER);
+		counter++;
+		if (contended) {
+			k_yield();
+		}
+		k_mutex_unlock(&kernel_mutex);
+	}
+}
+
+static void sys_mutex_loop(void *p1, void *p2, void *p3)
+{
+	bool contended = POINTER_TO_INT(p1) > 1;
+
+	for (int i = 0; i < N_LOOPS; i++) {
+		sys_mutex_lock(&user_mutex, K_FOREVER);
+		counter++;
+		if (contended) {
+			k_yield();
+		}
+		sys_mutex_unlock(&user_mutex);
+	}
+}
+
+static void sys_rwlock_read_loop(void *p1, void *p2, void *p3)
+{
+	for (int i = 0; i < N_LOOPS; i++) {
+		sys_rwlock_read_lock(&user_rwlock, K_FOREVER);
+		sys_rwlock_read_unlock(&user_rwlock);
+	}
+}
+
+static void sys_rwlock_write_loop(void *p1, void *p2, void *p3)
+{
+	for (int i = 0; i < N_LOOPS; i++) {
+		sys_rwlock_write_lock(&user_rwlock, K_FOREVER);
+		counter++;
+		sys_rwlock_write_unlock(&user_rwlock);
+	}
+}
+
+static void sys_condvar_signal_loop(void *p1, void *p2, void *p3)
+{
+	for (int i = 0; i < N_LOOPS; i++) {
+		sys_condvar_signal(&user_condvar);
+	}
+}
+
+static void run(const char *name, k_thread_entry_t entry, int n_threads)
+{
+	uint32_t start, cycles;
+
+	for (int t = 0; t < n_threads; t++) {
+		k_thread_create(&threads[t], stacks[t], STACK_SIZE, entry,
+				INT_TO_POINTER(n_threads), NULL, NULL,
+				THREAD_PRIO, K_USER, K_FOREVER);
+		k_thread_access_grant(&threads[t], &kernel_mutex);
+	}
+
+	start = k_cycle_get_32();
+
+	for (int t = 0; t < n_threads; t++) {
+		k_thread_start(&threads[t]);
+	}
+
+	for (int t = 0; t < n_threads; t++) {
+		k_thread_join(&threads[t], K_FOREVER);
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	printk("%-24s %6u ns\n", name,
+	       (uint32_t)(k_cyc_to_ns_floor64(cycles) /
+			  (N_LOOPS * n_threads)));
+}
+
+int main(void)
+{
+	int ret;
+
+	ret = k_mem_domain_add_partition(&k_mem_domain_default, &bench_part);
+	if (ret != 0) {
+		printk("failed to add memory partition (%d)\n", ret);
+		return 0;
+	}
+
+	printk("sys_mutex %s, ns per lock/unlock pair\n",
+	       IS_ENABLED(CONFIG_SYS_MUTEX_FUTEX) ? "futex" : "k_mutex");
+
+	run("k_mutex", k_mutex_loop, 1);
+	run("sys_mutex", sys_mutex_loop, 1);
+	run("sys_rwlock read", sys_rwlock_read_loop, 1);
+	run("sys_rwlock write", sys_rwlock_write_loop, 1);
+	run("sys_condvar signal", sys_condvar_signal_loop, 1);
+	run("k_mutex contended", k_mutex_loop, N_THREADS);
+	run("sys_mutex contended", sys_mutex_loop, N_THREADS);
+
+	printk("fin\n");
+
+	return 0;
+}
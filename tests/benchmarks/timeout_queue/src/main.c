@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timeout_q.h>
+
+/* This is a timeout queue microbenchmark.  It arms and cancels a
+ * large number of raw kernel timeouts through z_add_timeout() and
+ * z_abort_timeout(), so that the cost of the timeout queue backend
+ * itself dominates, and then verifies that a batch of short timeouts
+ * all expire at exactly their due tick.  On SMP it finally runs the
+ * same arm/cancel loop on every CPU at once and compares the per
+ * operation cost with a single CPU doing it alone, which shows how
+ * much the CPUs contend on the timeout queue locks.
+ */
+
+#define N_TIMEOUTS 10000
+#define N_EXPIRE 1000
+#define N_ROUNDS 5
+
+/* Expiry spread of the armed timeouts, in ticks */
+#define ARM_MIN_TICKS 1000
+#define ARM_SPREAD_TICKS 50000
+#define EXPIRE_SPREAD_TICKS 500
+
+#ifdef CONFIG_BOARD_NATIVE_POSIX
+/* The simulated CPU takes no time to run code, so use the host clock */
+#include <time.h>
+
+static uint64_t stamp(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * NSEC_PER_SEC + ts.tv_nsec;
+}
+
+static uint64_t stamp_ns(uint64_t start)
+{
+	return stamp() - start;
+}
+#elif defined(CONFIG_ARCH_POSIX)
+#error "This benchmark cannot be built for other POSIX arch boards than native_posix"
+#else
+static uint64_t stamp(void)
+{
+	return k_cycle_get_32();
+}
+
+static uint64_t stamp_ns(uint64_t start)
+{
+	return k_cyc_to_ns_floor64((uint32_t)(k_cycle_get_32() - start));
+}
+#endif
+
+static struct _timeout timeouts[N_TIMEOUTS];
+static uint32_t order[N_TIMEOUTS];
+static uint64_t due[N_EXPIRE];
+
+static volatile uint32_t expired;
+static volatile uint32_t late;
+
+static uint32_t rand_state = 0x2545F491;
+
+static uint32_t next_rand(void)
+{
+	/* xorshift32, good enough and deterministic across runs */
+	rand_state ^= rand_state << 13;
+	rand_state ^= rand_state >> 17;
+	rand_state ^= rand_state << 5;
+	return rand_state;
+}
+
+static void shuffle(void)
+{
+	for (uint32_t i = N_TIMEOUTS - 1; i > 0; i--) {
+		uint32_t j = next_rand() % (i + 1);
+		uint32_t tmp = order[i];
+
+		order[i] = order[j];
+		order[j] = tmp;
+	}
+}
+
+static void unused_fn(struct _timeout *t)
+{
+	printk("ERROR: benchmark timeout %p fired\n", t);
+}
+
+static void expire_fn(struct _timeout *t)
+{
+	uint32_t idx = t - timeouts;
+
+	if (sys_clock_tick_get() != due[idx]) {
+		late++;
+	}
+	expired++;
+}
+
+static void run_round(void)
+{
+	uint64_t start, arm_ns, cancel_ns;
+
+	shuffle();
+	start = stamp();
+	for (uint32_t i = 0; i < N_TIMEOUTS; i++) {
+		k_ticks_t ticks = ARM_MIN_TICKS + next_rand() % ARM_SPREAD_TICKS;
+
+		z_add_timeout(&timeouts[order[i]], unused_fn, K_TICKS(ticks));
+	}
+	arm_ns = stamp_ns(start);
+
+	shuffle();
+	start = stamp();
+	for (uint32_t i = 0; i < N_TIMEOUTS; i++) {
+		z_abort_timeout(&timeouts[order[i]]);
+	}
+	cancel_ns = stamp_ns(start);
+
+	printk("arm %8u ns cancel %8u ns (%d timeouts)\n",
+	       (uint32_t)(arm_ns / N_TIMEOUTS),
+	       (uint32_t)(cancel_ns / N_TIMEOUTS), N_TIMEOUTS);
+
+	expired = 0U;
+	late = 0U;
+
+	int64_t base = sys_clock_tick_get() + 10;
+
+	for (uint32_t i = 0; i < N_EXPIRE; i++) {
+		due[i] = base + next_rand() % EXPIRE_SPREAD_TICKS;
+		z_add_timeout(&timeouts[i], expire_fn,
+			      K_TIMEOUT_ABS_TICKS(due[i]));
+	}
+
+	k_sleep(K_TIMEOUT_ABS_TICKS(base + EXPIRE_SPREAD_TICKS + 1));
+
+	printk("expired %5u late %u\n", expired, late);
+}
+
+#ifdef CONFIG_SMP
+#define SMP_ITERATIONS 20000
+#define SMP_BATCH 32
+
+static K_THREAD_STACK_ARRAY_DEFINE(smp_stacks, CONFIG_MP_MAX_NUM_CPUS, 1024);
+static struct k_thread smp_threads[CONFIG_MP_MAX_NUM_CPUS];
+static uint64_t smp_ns[CONFIG_MP_MAX_NUM_CPUS];
+static atomic_t smp_ready;
+static K_SEM_DEFINE(smp_done, 0, CONFIG_MP_MAX_NUM_CPUS);
+
+/* Arms and cancels batches of timeouts from its own slice of the
+ * array, returning the average time of one arm+cancel pair.
+ */
+static uint64_t arm_cancel_loop(struct _timeout *set)
+{
+	uint64_t start = stamp();
+
+	for (int i = 0; i < SMP_ITERATIONS / SMP_BATCH; i++) {
+		for (int j = 0; j < SMP_BATCH; j++) {
+			z_add_timeout(&set[j], unused_fn,
+				      K_TICKS(ARM_MIN_TICKS + j * 7));
+		}
+		for (int j = 0; j < SMP_BATCH; j++) {
+			z_abort_timeout(&set[j]);
+		}
+	}
+
+	return stamp_ns(start) / SMP_ITERATIONS;
+}
+
+static void smp_fn(void *p1, void *p2, void *p3)
+{
+	int id = POINTER_TO_INT(p1);
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	/* Start all CPUs together so the loops overlap */
+	atomic_inc(&smp_ready);
+	while ((unsigned int)atomic_get(&smp_ready) < arch_num_cpus()) {
+	}
+
+	smp_ns[id] = arm_cancel_loop(&timeouts[id * SMP_BATCH]);
+	k_sem_give(&smp_done);
+}
+
+static void run_smp(void)
+{
+	unsigned int num_cpus = arch_num_cpus();
+	uint64_t single, total = 0U;
+
+	single = arm_cancel_loop(&timeouts[0]);
+
+	atomic_set(&smp_ready, 0);
+	for (unsigned int i = 0; i < num_cpus; i++) {
+		k_thread_create(&smp_threads[i], smp_stacks[i],
+				K_THREAD_STACK_SIZEOF(smp_stacks[i]),
+				smp_fn, INT_TO_POINTER(i), NULL, NULL,
+				K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	}
+
+	for (unsigned int i = 0; i < num_cpus; i++) {
+		k_sem_take(&smp_done, K_FOREVER);
+		total += smp_ns[i];
+	}
+
+	printk("smp cpus %u single %6u ns contended %6u ns per arm+cancel\n",
+	       num_cpus, (uint32_t)single, (uint32_t)(total / num_cpus));
+}
+#endif
+
+int main(void)
+{
+	for (uint32_t i = 0; i < N_TIMEOUTS; i++) {
+		z_init_timeout(&timeouts[i]);
+		order[i] = i;
+	}
+
+	for (int i = 0; i < N_ROUNDS; i++) {
+		run_round();
+	}
+
+#ifdef CONFIG_SMP
+	run_smp();
+#endif
+
+	printk("fin\n");
+	return 0;
+}
@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "test_msgq.h"
+
+#define BATCH_LEN 4
+
+K_THREAD_STACK_DECLARE(tstack, STACK_SIZE);
+extern struct k_thread tdata;
+extern struct k_msgq msgq;
+static ZTEST_BMEM char __aligned(4) tbuffer[MSG_SIZE * BATCH_LEN];
+static ZTEST_DMEM uint32_t out[BATCH_LEN + 2] = { 1, 2, 3, 4, 5, 6 };
+static ZTEST_BMEM uint32_t in[BATCH_LEN + 2];
+static ZTEST_BMEM uint32_t rx;
+
+static void reader_entry(void *p1, void *p2, void *p3)
+{
+	zassert_equal(k_msgq_get((struct k_msgq *)p1, &rx, TIMEOUT), 0);
+}
+
+static void writer_entry(void *p1, void *p2, void *p3)
+{
+	zassert_equal(k_msgq_put((struct k_msgq *)p1, &out[BATCH_LEN],
+				 TIMEOUT), 0);
+}
+
+static void start_helper(k_thread_entry_t entry, struct k_msgq *q)
+{
+	k_thread_create(&tdata, tstack, STACK_SIZE, entry, q, NULL, NULL,
+			K_PRIO_PREEMPT(0), K_USER | K_INHERIT_PERMS, K_NO_WAIT);
+	k_msleep(TIMEOUT_MS >> 2);
+}
+
+static void batch_put_get(struct k_msgq *q)
+{
+	/* Only as many as fit are put */
+	zassert_equal(k_msgq_put_many(q, out, BATCH_LEN + 2, K_NO_WAIT),
+		      BATCH_LEN);
+	zassert_equal(k_msgq_num_used_get(q), BATCH_LEN);
+	zassert_equal(k_msgq_put_many(q, out, 1, K_NO_WAIT), -ENOMSG);
+
+	zassert_equal(k_msgq_get_many(q, in, 3, K_NO_WAIT), 3);
+	zassert_equal(in[0], 1);
+	zassert_equal(in[2], 3);
+
+	/* Across the end of the ring */
+	zassert_equal(k_msgq_put_many(q, &out[BATCH_LEN], 2, K_NO_WAIT), 2);
+	zassert_equal(k_msgq_get_many(q, in, BATCH_LEN + 2, K_NO_WAIT), 3);
+	zassert_equal(in[0], 4);
+	zassert_equal(in[1], 5);
+	zassert_equal(in[2], 6);
+
+	zassert_equal(k_msgq_get_many(q, in, BATCH_LEN, K_NO_WAIT), -ENOMSG);
+	zassert_equal(k_msgq_get_many(q, in, BATCH_LEN, TIMEOUT), -EAGAIN);
+}
+
+static void batch_wake(struct k_msgq *q)
+{
+	/* A waiting reader gets the first message of the batch */
+	start_helper(reader_entry, q);
+	zassert_equal(k_msgq_put_many(q, out, 3, K_NO_WAIT), 3);
+	k_thread_join(&tdata, K_FOREVER);
+	zassert_equal(rx, 1);
+	zassert_equal(k_msgq_num_used_get(q), 2);
+
+	/* A waiting writer refills the space freed by a batch */
+	zassert_equal(k_msgq_put_many(q, &out[2], 2, K_NO_WAIT), 2);
+	start_helper(writer_entry, q);
+	zassert_equal(k_msgq_get_many(q, in, 2, K_NO_WAIT), 2);
+	k_thread_join(&tdata, K_FOREVER);
+	zassert_equal(k_msgq_num_used_get(q), BATCH_LEN - 1);
+	zassert_equal(k_msgq_get_many(q, in, BATCH_LEN, K_NO_WAIT),
+		      BATCH_LEN - 1);
+	zassert_equal(in[2], out[BATCH_LEN]);
+}
+
+/**
+ * @addtogroup kernel_message_queue_tests
+ * @{
+ */
+
+/**
+ * @brief Test batched send and receive
+ * @see k_msgq_put_many(), k_msgq_get_many()
+ */
+ZTEST(msgq_api, test_msgq_put_get_many)
+{
+	k_msgq_init(&msgq, tbuffer, MSG_SIZE, BATCH_LEN);
+
+	batch_put_get(&msgq);
+}
+
+/**
+ * @brief Test that batches wake up waiting threads
+ * @see k_msgq_put_many(), k_msgq_get_many()
+ */
+ZTEST(msgq_api_1cpu, test_msgq_many_wake)
+{
+	k_msgq_init(&msgq, tbuffer, MSG_SIZE, BATCH_LEN);
+
+	batch_wake(&msgq);
+}
+
+#ifdef CONFIG_USERSPACE
+/**
+ * @brief Test batched send and receive from user mode
+ * @see k_msgq_put_many(), k_msgq_get_many()
+ */
+ZTEST_USER(msgq_api, test_msgq_user_put_get_many)
+{
+	struct k_msgq *q;
+
+	q = k_object_alloc(K_OBJ_MSGQ);
+	zassert_not_null(q, "couldn't alloc message queue");
+	zassert_false(k_msgq_alloc_init(q, MSG_SIZE, BATCH_LEN));
+
+	batch_put_get(q);
+}
+#endif
+
+/**
+ * @brief Test writing and reading messages in place
+ * @see k_msgq_put_claim(), k_msgq_put_commit(), k_msgq_get_claim(),
+ * k_msgq_get_commit()
+ */
+ZTEST(msgq_api_1cpu, test_msgq_claim)
+{
+	uint32_t *slots;
+
+	k_msgq_init(&msgq, tbuffer, MSG_SIZE, BATCH_LEN);
+
+	zassert_equal(k_msgq_put_claim(&msgq, (void **)&slots, 3), 3);
+	zassert_equal(k_msgq_put_claim(&msgq, (void **)&slots, 1), -EBUSY);
+	zassert_equal(k_msgq_put(&msgq, &out[0], K_NO_WAIT), -EBUSY);
+	slots[0] = 10;
+	slots[1] = 11;
+	zassert_equal(k_msgq_num_used_get(&msgq), 0);
+	zassert_equal(k_msgq_put_commit(&msgq, 2), 0);
+	zassert_equal(k_msgq_put_commit(&msgq, 1), -EINVAL);
+	zassert_equal(k_msgq_num_used_get(&msgq), 2);
+
+	/* Claims stop at the end of the ring */
+	zassert_equal(k_msgq_put_claim(&msgq, (void **)&slots, BATCH_LEN), 2);
+	slots[0] = 12;
+	slots[1] = 13;
+	zassert_equal(k_msgq_put_commit(&msgq, 2), 0);
+	zassert_equal(k_msgq_put_claim(&msgq, (void **)&slots, 1), 0);
+
+	zassert_equal(k_msgq_get_claim(&msgq, (void **)&slots, 3), 3);
+	zassert_equal(k_msgq_get(&msgq, &rx, K_NO_WAIT), -EBUSY);
+	zassert_equal(slots[0], 10);
+	zassert_equal(slots[2], 12);
+	zassert_equal(k_msgq_get_commit(&msgq, 1), 0);
+	zassert_equal(k_msgq_num_used_get(&msgq), 3);
+
+	zassert_equal(k_msgq_get(&msgq, &rx, K_NO_WAIT), 0);
+	zassert_equal(rx, 11);
+
+	/* A reader waiting on the empty queue gets a committed message */
+	k_msgq_purge(&msgq);
+	start_helper(reader_entry, &msgq);
+	zassert_equal(k_msgq_put_claim(&msgq, (void **)&slots, 1), 1);
+	slots[0] = 20;
+	zassert_equal(k_msgq_put_commit(&msgq, 1), 0);
+	k_thread_join(&tdata, K_FOREVER);
+	zassert_equal(rx, 20);
+	zassert_equal(k_msgq_num_used_get(&msgq), 0);
+
+	/* Purging cancels a get claim */
+	zassert_equal(k_msgq_put(&msgq, &out[0], K_NO_WAIT), 0);
+	zassert_equal(k_msgq_get_claim(&msgq, (void **)&slots, 1), 1);
+	k_msgq_purge(&msgq);
+	zassert_equal(k_msgq_get_commit(&msgq, 1), -EINVAL);
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,266 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define PIPE_SIZE 32
+#define DATA_SIZE 24
+
+static K_THREAD_STACK_DEFINE(iov_stack, STACK_SIZE);
+static struct k_thread iov_thread;
+
+static struct k_pipe iov_pipe;
+static struct k_pipe iov_nobuf_pipe;
+static unsigned char __aligned(4) iov_pipe_buf[PIPE_SIZE];
+
+static unsigned char tx_data[DATA_SIZE];
+static unsigned char rx_data[DATA_SIZE];
+
+static void iov_prepare(void)
+{
+	for (int i = 0; i < DATA_SIZE; i++) {
+		tx_data[i] = i + 1;
+	}
+
+	memset(rx_data, 0, sizeof(rx_data));
+
+	/* Start at the beginning of the pipe buffer */
+	k_pipe_init(&iov_pipe, iov_pipe_buf, sizeof(iov_pipe_buf));
+	k_pipe_init(&iov_nobuf_pipe, NULL, 0);
+}
+
+/**
+ * @brief Test scatter/gather writes and reads through the pipe buffer
+ *
+ * @ingroup kernel_pipe_tests
+ *
+ * @see k_pipe_put_iov(), k_pipe_get_iov()
+ */
+ZTEST(pipe_api_1cpu, test_pipe_iov_buffered)
+{
+	struct k_pipe_iovec tx_iov[] = {
+		{ &tx_data[0], 5 }, { &tx_data[5], 0 }, { &tx_data[5], 19 },
+	};
+	struct k_pipe_iovec rx_iov[] = {
+		{ &rx_data[0], 10 }, { &rx_data[10], 14 },
+	};
+	size_t bytes;
+
+	iov_prepare();
+
+	zassert_equal(k_pipe_put_iov(&iov_pipe, tx_iov, ARRAY_SIZE(tx_iov),
+				     &bytes, DATA_SIZE, K_NO_WAIT), 0);
+	zassert_equal(bytes, DATA_SIZE);
+
+	zassert_equal(k_pipe_get_iov(&iov_pipe, rx_iov, ARRAY_SIZE(rx_iov),
+				     &bytes, DATA_SIZE, K_NO_WAIT), 0);
+	zassert_equal(bytes, DATA_SIZE);
+	zassert_mem_equal(rx_data, tx_data, DATA_SIZE);
+
+	/* Partial transfers stop in the middle of a segment */
+	memset(rx_data, 0, sizeof(rx_data));
+	zassert_equal(k_pipe_put(&iov_pipe, tx_data, 7, &bytes, 7, K_NO_WAIT),
+		      0);
+	zassert_equal(k_pipe_get_iov(&iov_pipe, rx_iov, ARRAY_SIZE(rx_iov),
+				     &bytes, 1, K_NO_WAIT), 0);
+	zassert_equal(bytes, 7);
+	zassert_mem_equal(rx_data, tx_data, 7);
+	zassert_equal(rx_data[7], 0);
+
+	zassert_equal(k_pipe_get_iov(&iov_pipe, rx_iov, ARRAY_SIZE(rx_iov),
+				     &bytes, 1, K_NO_WAIT), -EIO);
+}
+
+static void iov_reader(void *p1, void *p2, void *p3)
+{
+	struct k_pipe_iovec rx_iov[] = {
+		{ &rx_data[0], 3 }, { &rx_data[3], 13 }, { &rx_data[16], 8 },
+	};
+	size_t bytes;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	zassert_equal(k_pipe_get_iov(p1, rx_iov, ARRAY_SIZE(rx_iov),
+				     &bytes, DATA_SIZE, K_FOREVER), 0);
+	zassert_equal(bytes, DATA_SIZE);
+}
+
+/**
+ * @brief Test copying between the segments of a writer and a waiting reader
+ *
+ * @ingroup kernel_pipe_tests
+ *
+ * @see k_pipe_put_iov(), k_pipe_get_iov()
+ */
+ZTEST(pipe_api_1cpu, test_pipe_iov_direct)
+{
+	struct k_pipe_iovec tx_iov[] = {
+		{ &tx_data[0], 8 }, { &tx_data[8], 8 }, { &tx_data[16], 8 },
+	};
+	size_t bytes;
+
+	iov_prepare();
+
+	k_thread_create(&iov_thread, iov_stack, STACK_SIZE, iov_reader,
+			&iov_nobuf_pipe, NULL, NULL,
+			K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+
+	/* Let the reader pend with its segments */
+	k_msleep(10);
+
+	zassert_equal(k_pipe_put_iov(&iov_nobuf_pipe, tx_iov,
+				     ARRAY_SIZE(tx_iov), &bytes, DATA_SIZE,
+				     K_NO_WAIT), 0);
+	zassert_equal(bytes, DATA_SIZE);
+
+	k_thread_join(&iov_thread, K_FOREVER);
+	zassert_mem_equal(rx_data, tx_data, DATA_SIZE);
+}
+
+/**
+ * @brief Test writing and reading the pipe buffer in place
+ *
+ * @ingroup kernel_pipe_tests
+ *
+ * @see k_pipe_put_claim(), k_pipe_put_commit(), k_pipe_get_claim(),
+ * k_pipe_get_commit()
+ */
+ZTEST(pipe_api_1cpu, test_pipe_claim)
+{
+	unsigned char *data;
+	size_t claimed;
+	size_t bytes;
+
+	iov_prepare();
+
+	zassert_equal(k_pipe_get_claim(&iov_pipe, (void **)&data, PIPE_SIZE,
+				       &claimed), 0);
+	zassert_equal(claimed, 0);
+	zassert_equal(k_pipe_get_commit(&iov_pipe, 0), -EINVAL);
+
+	zassert_equal(k_pipe_put_claim(&iov_pipe, (void **)&data, DATA_SIZE,
+				       &claimed), 0);
+	zassert_equal(claimed, DATA_SIZE);
+	zassert_equal(k_pipe_put_claim(&iov_pipe, (void **)&data, DATA_SIZE,
+				       &claimed), -EBUSY);
+	zassert_equal(k_pipe_put(&iov_pipe, tx_data, 1, &bytes, 0, K_NO_WAIT),
+		      -EBUSY);
+
+	memcpy(data, tx_data, DATA_SIZE);
+	zassert_equal(k_pipe_put_commit(&iov_pipe, PIPE_SIZE + 1), -EINVAL);
+	zassert_equal(k_pipe_put_commit(&iov_pipe, 20), 0);
+	zassert_equal(k_pipe_put_commit(&iov_pipe, 0), -EINVAL);
+	zassert_equal(k_pipe_read_avail(&iov_pipe), 20);
+
+	/* Claims do not cross the end of the pipe buffer */
+	zassert_equal(k_pipe_put_claim(&iov_pipe, (void **)&data, PIPE_SIZE,
+				       &claimed), 0);
+	zassert_equal(claimed, PIPE_SIZE - 20);
+	zassert_equal(k_pipe_put_commit(&iov_pipe, 0), 0);
+
+	zassert_equal(k_pipe_get_claim(&iov_pipe, (void **)&data, 8,
+				       &claimed), 0);
+	zassert_equal(claimed, 8);
+	zassert_mem_equal(data, tx_data, 8);
+	zassert_equal(k_pipe_get(&iov_pipe, rx_data, 1, &bytes, 0, K_NO_WAIT),
+		      -EBUSY);
+	zassert_equal(k_pipe_get_commit(&iov_pipe, 5), 0);
+
+	/* What was not consumed is read again */
+	zassert_equal(k_pipe_get(&iov_pipe, rx_data, 15, &bytes, 15,
+				 K_NO_WAIT), 0);
+	zassert_mem_equal(rx_data, &tx_data[5], 15);
+
+	/* Flushing cancels a get claim */
+	zassert_equal(k_pipe_put(&iov_pipe, tx_data, 4, &bytes, 4, K_NO_WAIT),
+		      0);
+	zassert_equal(k_pipe_get_claim(&iov_pipe, (void **)&data, PIPE_SIZE,
+				       &claimed), 0);
+	zassert_equal(claimed, 4);
+	k_pipe_flush(&iov_pipe);
+	zassert_equal(k_pipe_get_commit(&iov_pipe, 0), -EINVAL);
+	zassert_equal(k_pipe_read_avail(&iov_pipe), 0);
+
+	/* Nothing to claim without a pipe buffer */
+	zassert_equal(k_pipe_put_claim(&iov_nobuf_pipe, (void **)&data,
+				       PIPE_SIZE, &claimed), 0);
+	zassert_equal(claimed, 0);
+}
+
+static void claim_reader(void *p1, void *p2, void *p3)
+{
+	size_t bytes;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	zassert_equal(k_pipe_get(p1, rx_data, DATA_SIZE, &bytes, DATA_SIZE,
+				 K_FOREVER), 0);
+	zassert_equal(bytes, DATA_SIZE);
+}
+
+static void claim_writer(void *p1, void *p2, void *p3)
+{
+	size_t bytes;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	zassert_equal(k_pipe_put(p1, tx_data, DATA_SIZE, &bytes, DATA_SIZE,
+				 K_FOREVER), 0);
+	zassert_equal(bytes, DATA_SIZE);
+}
+
+/**
+ * @brief Test that commits wake threads waiting on the pipe
+ *
+ * @ingroup kernel_pipe_tests
+ *
+ * @see k_pipe_put_commit(), k_pipe_get_commit()
+ */
+ZTEST(pipe_api_1cpu, test_pipe_claim_wake)
+{
+	unsigned char *data;
+	size_t claimed;
+	size_t bytes;
+
+	iov_prepare();
+
+	/* A committed claim goes to a waiting reader */
+	k_thread_create(&iov_thread, iov_stack, STACK_SIZE, claim_reader,
+			&iov_pipe, NULL, NULL,
+			K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_msleep(10);
+
+	zassert_equal(k_pipe_put_claim(&iov_pipe, (void **)&data, DATA_SIZE,
+				       &claimed), 0);
+	zassert_equal(claimed, DATA_SIZE);
+	memcpy(data, tx_data, DATA_SIZE);
+	zassert_equal(k_pipe_put_commit(&iov_pipe, DATA_SIZE), 0);
+
+	k_thread_join(&iov_thread, K_FOREVER);
+	zassert_mem_equal(rx_data, tx_data, DATA_SIZE);
+	zassert_equal(k_pipe_read_avail(&iov_pipe), 0);
+
+	/* Consumed space is refilled from a waiting writer */
+	iov_prepare();
+	zassert_equal(k_pipe_put(&iov_pipe, tx_data, DATA_SIZE, &bytes,
+				 DATA_SIZE, K_NO_WAIT), 0);
+	k_thread_create(&iov_thread, iov_stack, STACK_SIZE, claim_writer,
+			&iov_pipe, NULL, NULL,
+			K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_msleep(10);
+
+	zassert_equal(k_pipe_get_claim(&iov_pipe, (void **)&data, DATA_SIZE,
+				       &claimed), 0);
+	zassert_equal(claimed, DATA_SIZE);
+	zassert_equal(k_pipe_get_commit(&iov_pipe, DATA_SIZE), 0);
+
+	k_thread_join(&iov_thread, K_FOREVER);
+	zassert_equal(k_pipe_read_avail(&iov_pipe), DATA_SIZE);
+}
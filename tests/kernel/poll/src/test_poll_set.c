@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+static struct k_poll_set set;
+static struct k_poll_set_event members[3];
+static struct k_sem set_sem;
+static struct k_fifo set_fifo;
+static struct k_poll_signal set_signal;
+
+static struct k_thread set_thread;
+K_THREAD_STACK_DEFINE(set_stack, STACK_SIZE);
+
+static void *fifo_item;
+
+static void set_prepare(void)
+{
+	k_poll_set_init(&set);
+	k_sem_init(&set_sem, 0, K_SEM_MAX_LIMIT);
+	k_fifo_init(&set_fifo);
+	k_poll_signal_init(&set_signal);
+
+	k_poll_event_init(&members[0].event, K_POLL_TYPE_SEM_AVAILABLE,
+			  K_POLL_MODE_NOTIFY_ONLY, &set_sem);
+	k_poll_event_init(&members[1].event, K_POLL_TYPE_FIFO_DATA_AVAILABLE,
+			  K_POLL_MODE_NOTIFY_ONLY, &set_fifo);
+	k_poll_event_init(&members[2].event, K_POLL_TYPE_SIGNAL,
+			  K_POLL_MODE_NOTIFY_ONLY, &set_signal);
+
+	for (int i = 0; i < ARRAY_SIZE(members); i++) {
+		zassert_equal(k_poll_set_add(&set, &members[i]), 0);
+	}
+}
+
+static void set_cleanup(void)
+{
+	for (int i = 0; i < ARRAY_SIZE(members); i++) {
+		zassert_equal(k_poll_set_remove(&set, &members[i]), 0);
+	}
+}
+
+/**
+ * @brief Test adding and removing poll set members
+ *
+ * @ingroup kernel_poll_tests
+ *
+ * @see k_poll_set_add(), k_poll_set_remove(), k_poll_set_wait()
+ */
+ZTEST(poll_api_1cpu, test_poll_set_add_remove)
+{
+	struct k_poll_set_event *ready[ARRAY_SIZE(members)];
+	struct k_poll_set other;
+
+	k_poll_set_init(&other);
+	set_prepare();
+
+	zassert_equal(k_poll_set_add(&set, &members[0]), -EALREADY);
+	zassert_equal(k_poll_set_remove(&other, &members[0]), -EINVAL);
+	zassert_equal(k_poll_set_wait(&set, ready, 0, K_NO_WAIT), -EINVAL);
+	zassert_equal(k_poll_set_wait(&set, ready, 1, K_NO_WAIT), -EAGAIN);
+	zassert_equal(k_poll_set_wait(&set, ready, 1, K_MSEC(10)), -EAGAIN);
+
+	/* An object that is already available is reported when added */
+	k_sem_give(&set_sem);
+	zassert_equal(k_poll_set_remove(&set, &members[0]), 0);
+	zassert_equal(k_poll_set_remove(&set, &members[0]), -EINVAL);
+	zassert_equal(k_poll_set_wait(&set, ready, 1, K_NO_WAIT), -EAGAIN);
+	zassert_equal(k_poll_set_add(&set, &members[0]), 0);
+	zassert_equal(k_poll_set_wait(&set, ready, 1, K_NO_WAIT), 1);
+	zassert_equal_ptr(ready[0], &members[0]);
+	zassert_equal(members[0].state, K_POLL_STATE_SEM_AVAILABLE);
+	zassert_equal(k_sem_take(&set_sem, K_NO_WAIT), 0);
+
+	/* A removed member is not reported any more */
+	k_sem_give(&set_sem);
+	zassert_equal(k_poll_set_remove(&set, &members[0]), 0);
+	zassert_equal(k_poll_set_wait(&set, ready, 1, K_NO_WAIT), -EAGAIN);
+	zassert_equal(k_poll_set_add(&set, &members[0]), 0);
+	zassert_equal(k_sem_take(&set_sem, K_NO_WAIT), 0);
+	(void)k_poll_set_wait(&set, ready, 1, K_NO_WAIT);
+
+	set_cleanup();
+}
+
+/**
+ * @brief Test that poll set members stay registered across waits
+ *
+ * @ingroup kernel_poll_tests
+ *
+ * @see k_poll_set_wait()
+ */
+ZTEST(poll_api_1cpu, test_poll_set_persistent)
+{
+	struct k_poll_set_event *ready[ARRAY_SIZE(members)];
+	int n;
+
+	set_prepare();
+
+	for (int round = 0; round < 3; round++) {
+		k_sem_give(&set_sem);
+
+		zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready),
+					      K_NO_WAIT), 1);
+		zassert_equal_ptr(ready[0], &members[0]);
+		zassert_equal(members[0].state,
+			      K_POLL_STATE_SEM_AVAILABLE);
+		zassert_equal(k_sem_take(&set_sem, K_NO_WAIT), 0);
+
+		/* Reported once per state change */
+		zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready),
+					      K_NO_WAIT), -EAGAIN);
+	}
+
+	/* Several ready members, collected over more than one call */
+	k_sem_give(&set_sem);
+	k_fifo_put(&set_fifo, &fifo_item);
+	k_poll_signal_raise(&set_signal, 0);
+
+	zassert_equal(k_poll_set_wait(&set, ready, 2, K_NO_WAIT), 2);
+	zassert_equal_ptr(ready[0], &members[0]);
+	zassert_equal_ptr(ready[1], &members[1]);
+	zassert_equal(members[1].state,
+		      K_POLL_STATE_FIFO_DATA_AVAILABLE);
+
+	n = k_poll_set_wait(&set, ready, ARRAY_SIZE(ready), K_NO_WAIT);
+	zassert_equal(n, 1);
+	zassert_equal_ptr(ready[0], &members[2]);
+	zassert_equal(members[2].state, K_POLL_STATE_SIGNALED);
+
+	zassert_equal(k_sem_take(&set_sem, K_NO_WAIT), 0);
+	zassert_equal_ptr(k_fifo_get(&set_fifo, K_NO_WAIT), &fifo_item);
+	k_poll_signal_reset(&set_signal);
+
+	/* Changes before the member is collected are merged */
+	k_sem_give(&set_sem);
+	k_sem_give(&set_sem);
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), 1);
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), -EAGAIN);
+	k_sem_reset(&set_sem);
+
+	set_cleanup();
+}
+
+static void set_fifo_put(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < 3; i++) {
+		k_msleep(10);
+		k_fifo_put(&set_fifo, &fifo_item);
+	}
+}
+
+/**
+ * @brief Test waiting on a poll set for another thread
+ *
+ * @ingroup kernel_poll_tests
+ *
+ * @see k_poll_set_wait()
+ */
+ZTEST(poll_api_1cpu, test_poll_set_wait)
+{
+	struct k_poll_set_event *ready[ARRAY_SIZE(members)];
+
+	set_prepare();
+
+	k_thread_create(&set_thread, set_stack, K_THREAD_STACK_SIZEOF(set_stack),
+			set_fifo_put, NULL, NULL, NULL,
+			K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+
+	for (int i = 0; i < 3; i++) {
+		zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready),
+					      K_FOREVER), 1);
+		zassert_equal_ptr(ready[0], &members[1]);
+		zassert_equal_ptr(k_fifo_get(&set_fifo, K_NO_WAIT), &fifo_item);
+	}
+
+	k_thread_join(&set_thread, K_FOREVER);
+
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready),
+				      K_MSEC(20)), -EAGAIN);
+
+	set_cleanup();
+}
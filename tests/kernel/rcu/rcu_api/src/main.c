@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/ztest_error_hook.h>
+
+#define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+K_THREAD_STACK_DEFINE(helper_stack, STACK_SIZE);
+struct k_thread helper_tid;
+
+K_RCU_DEFINE(test_rcu);
+
+ZTEST_BMEM volatile bool synced;
+ZTEST_BMEM volatile bool reader_done;
+
+static void sync_task(void *p1, void *p2, void *p3)
+{
+	zassert_equal(k_rcu_synchronize(&test_rcu), 0);
+	synced = true;
+}
+
+static void reader_task(void *p1, void *p2, void *p3)
+{
+	int token = k_rcu_read_lock(&test_rcu);
+
+	k_msleep(20);
+	reader_done = true;
+	zassert_equal(k_rcu_read_unlock(&test_rcu, token), 0);
+}
+
+static void spawn(k_thread_entry_t fn)
+{
+	k_thread_create(&helper_tid, helper_stack, STACK_SIZE, fn,
+			NULL, NULL, NULL, CONFIG_ZTEST_THREAD_PRIORITY,
+			K_USER | K_INHERIT_PERMS, K_NO_WAIT);
+	k_msleep(1);
+}
+
+/**
+ * @brief Test a grace period without readers
+ *
+ * @ingroup kernel_rcu_tests
+ *
+ * @see k_rcu_synchronize()
+ */
+ZTEST_USER(rcu_tests, test_rcu_synchronize_idle)
+{
+	zassert_equal(k_rcu_synchronize(&test_rcu), 0);
+	zassert_equal(k_rcu_synchronize(&test_rcu), 0);
+}
+
+/**
+ * @brief Test that a grace period waits for pre-existing readers
+ *
+ * @ingroup kernel_rcu_tests
+ *
+ * @see k_rcu_read_lock(), k_rcu_read_unlock(), k_rcu_synchronize()
+ */
+ZTEST_USER(rcu_tests, test_rcu_synchronize_waits)
+{
+	int token = k_rcu_read_lock(&test_rcu);
+
+	spawn(sync_task);
+	zassert_false(synced, "grace period ended inside a read section");
+
+	/* Nested and new read sections don't hold up the grace period */
+	int inner = k_rcu_read_lock(&test_rcu);
+
+	zassert_equal(k_rcu_read_unlock(&test_rcu, token), 0);
+	k_msleep(1);
+	zassert_true(synced, "grace period did not end");
+
+	zassert_equal(k_rcu_read_unlock(&test_rcu, inner), 0);
+	k_thread_join(&helper_tid, K_FOREVER);
+}
+
+/**
+ * @brief Test that the updater sleeps until a reader leaves
+ *
+ * @ingroup kernel_rcu_tests
+ *
+ * @see k_rcu_synchronize()
+ */
+ZTEST_USER(rcu_tests, test_rcu_synchronize_blocks)
+{
+	spawn(reader_task);
+
+	zassert_equal(k_rcu_synchronize(&test_rcu), 0);
+	zassert_true(reader_done, "grace period ended before the reader");
+
+	k_thread_join(&helper_tid, K_FOREVER);
+}
+
+/**
+ * @brief Test read sections in a loop across grace periods
+ *
+ * @ingroup kernel_rcu_tests
+ *
+ * @see k_rcu_read_lock(), k_rcu_synchronize()
+ */
+ZTEST_USER(rcu_tests, test_rcu_phases)
+{
+	for (int i = 0; i < 4; i++) {
+		int token = k_rcu_read_lock(&test_rcu);
+
+		zassert_true((token == 0) || (token == 1), "bad token %d", token);
+		zassert_equal(k_rcu_read_unlock(&test_rcu, token), 0);
+		zassert_equal(k_rcu_synchronize(&test_rcu), 0);
+	}
+}
+
+static void rcu_before(void *data)
+{
+	ARG_UNUSED(data);
+
+	k_rcu_init(&test_rcu);
+	synced = false;
+	reader_done = false;
+}
+
+static void *rcu_tests_setup(void)
+{
+#ifdef CONFIG_USERSPACE
+	k_thread_access_grant(k_current_get(), &test_rcu, &helper_tid,
+			      &helper_stack);
+#endif
+	return NULL;
+}
+
+ZTEST_SUITE(rcu_tests, NULL, rcu_tests_setup, rcu_before, NULL, NULL);
@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/ztest_error_hook.h>
+
+#define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define N_READERS 3
+
+#define PRIO_HELPER (CONFIG_ZTEST_THREAD_PRIORITY)
+
+K_THREAD_STACK_ARRAY_DEFINE(helper_stacks, N_READERS, STACK_SIZE);
+struct k_thread helper_tids[N_READERS];
+
+K_RWLOCK_DEFINE(test_rwlock);
+
+ZTEST_BMEM int n_inside;
+ZTEST_BMEM int order[N_READERS + 1];
+ZTEST_BMEM int n_order;
+
+/* Start a helper and let it run until it blocks */
+static void spawn(k_thread_entry_t fn, int i)
+{
+	k_thread_create(&helper_tids[i], helper_stacks[i], STACK_SIZE,
+			fn, INT_TO_POINTER(i), NULL, NULL,
+			PRIO_HELPER, K_USER | K_INHERIT_PERMS, K_NO_WAIT);
+	k_msleep(1);
+}
+
+static void join_all(int n)
+{
+	for (int i = 0; i < n; i++) {
+		k_thread_join(&helper_tids[i], K_FOREVER);
+	}
+}
+
+static void reader_task(void *p1, void *p2, void *p3)
+{
+	zassert_equal(k_rwlock_read_lock(&test_rwlock, K_FOREVER), 0);
+	n_inside++;
+	order[n_order++] = POINTER_TO_INT(p1);
+	k_msleep(10);
+	n_inside--;
+	zassert_equal(k_rwlock_read_unlock(&test_rwlock), 0);
+}
+
+static void writer_timeout_task(void *p1, void *p2, void *p3)
+{
+	zassert_equal(k_rwlock_write_lock(&test_rwlock, K_MSEC(20)), -EAGAIN);
+}
+
+static void writer_task(void *p1, void *p2, void *p3)
+{
+	zassert_equal(k_rwlock_write_lock(&test_rwlock, K_FOREVER), 0);
+	zassert_equal(n_inside, 0, "writer shares the lock with readers");
+	order[n_order++] = POINTER_TO_INT(p1);
+	zassert_equal(k_rwlock_write_unlock(&test_rwlock), 0);
+}
+
+/**
+ * @brief Test that readers share the lock
+ *
+ * @ingroup kernel_rwlock_tests
+ *
+ * @see k_rwlock_read_lock(), k_rwlock_read_unlock()
+ */
+ZTEST_USER(rwlock_tests, test_rwlock_readers_share)
+{
+	zassert_equal(k_rwlock_read_lock(&test_rwlock, K_NO_WAIT), 0);
+	zassert_equal(k_rwlock_read_lock(&test_rwlock, K_NO_WAIT), 0);
+
+	/* A writer can't get in while any reader is inside */
+	zassert_equal(k_rwlock_write_lock(&test_rwlock, K_NO_WAIT), -EBUSY);
+	zassert_equal(k_rwlock_read_unlock(&test_rwlock), 0);
+	zassert_equal(k_rwlock_write_lock(&test_rwlock, K_MSEC(10)), -EAGAIN);
+	zassert_equal(k_rwlock_read_unlock(&test_rwlock), 0);
+
+	zassert_equal(k_rwlock_write_lock(&test_rwlock, K_NO_WAIT), 0);
+	zassert_equal(k_rwlock_write_unlock(&test_rwlock), 0);
+}
+
+/**
+ * @brief Test that a writer excludes everyone else
+ *
+ * @ingroup kernel_rwlock_tests
+ *
+ * @see k_rwlock_write_lock(), k_rwlock_write_unlock()
+ */
+ZTEST_USER(rwlock_tests, test_rwlock_writer_excludes)
+{
+	zassert_equal(k_rwlock_write_lock(&test_rwlock, K_NO_WAIT), 0);
+	zassert_equal(k_rwlock_read_lock(&test_rwlock, K_NO_WAIT), -EBUSY);
+	zassert_equal(k_rwlock_read_lock(&test_rwlock, K_MSEC(10)), -EAGAIN);
+
+	/* All blocked readers get the lock together on release */
+	for (int i = 0; i < N_READERS; i++) {
+		spawn(reader_task, i);
+	}
+	zassert_equal(n_order, 0, "reader got in past the writer");
+
+	zassert_equal(k_rwlock_write_unlock(&test_rwlock), 0);
+	k_msleep(5);
+	zassert_equal(n_inside, N_READERS, "readers were not all let in");
+
+	join_all(N_READERS);
+	zassert_equal(n_order, N_READERS);
+}
+
+/**
+ * @brief Test that a waiting writer holds back new readers
+ *
+ * @ingroup kernel_rwlock_tests
+ *
+ * @see k_rwlock_write_lock(), k_rwlock_read_lock()
+ */
+ZTEST_USER(rwlock_tests, test_rwlock_writer_preferred)
+{
+	zassert_equal(k_rwlock_read_lock(&test_rwlock, K_NO_WAIT), 0);
+
+	spawn(writer_task, 0);
+
+	/* The writer is waiting now, so a new reader must not get in */
+	zassert_equal(k_rwlock_read_lock(&test_rwlock, K_NO_WAIT), -EBUSY);
+	spawn(reader_task, 1);
+
+	zassert_equal(k_rwlock_read_unlock(&test_rwlock), 0);
+	join_all(2);
+
+	zassert_equal(n_order, 2);
+	zassert_equal(order[0], 0, "reader overtook a waiting writer");
+	zassert_equal(order[1], 1);
+}
+
+/**
+ * @brief Test that a timed out writer does not strand readers
+ *
+ * @ingroup kernel_rwlock_tests
+ *
+ * @see k_rwlock_write_lock()
+ */
+ZTEST_USER(rwlock_tests, test_rwlock_writer_timeout)
+{
+	zassert_equal(k_rwlock_read_lock(&test_rwlock, K_NO_WAIT), 0);
+
+	/* The reader queues up behind the waiting writer and must be
+	 * let in once the writer gives up, while we still read
+	 */
+	spawn(writer_timeout_task, 0);
+	spawn(reader_task, 1);
+	zassert_equal(n_inside, 0, "reader overtook a waiting writer");
+
+	k_thread_join(&helper_tids[0], K_FOREVER);
+	k_msleep(5);
+	zassert_equal(n_inside, 1, "reader stranded by timed out writer");
+
+	zassert_equal(k_rwlock_read_unlock(&test_rwlock), 0);
+	k_thread_join(&helper_tids[1], K_FOREVER);
+	zassert_equal(k_rwlock_write_lock(&test_rwlock, K_NO_WAIT), 0);
+	zassert_equal(k_rwlock_write_unlock(&test_rwlock), 0);
+}
+
+/**
+ * @brief Test unlocking a lock that is not held
+ *
+ * @ingroup kernel_rwlock_tests
+ *
+ * @see k_rwlock_read_unlock(), k_rwlock_write_unlock()
+ */
+ZTEST_USER(rwlock_tests, test_rwlock_unlock_not_held)
+{
+	zassert_equal(k_rwlock_write_unlock(&test_rwlock), -EPERM);
+
+	if (IS_ENABLED(CONFIG_RUNTIME_ERROR_CHECKS)) {
+		zassert_equal(k_rwlock_read_unlock(&test_rwlock), -EINVAL);
+	}
+}
+
+static void rwlock_before(void *data)
+{
+	ARG_UNUSED(data);
+
+	k_rwlock_init(&test_rwlock);
+	n_inside = 0;
+	n_order = 0;
+}
+
+static void *rwlock_tests_setup(void)
+{
+#ifdef CONFIG_USERSPACE
+	k_thread_access_grant(k_current_get(), &test_rwlock);
+
+	for (int i = 0; i < N_READERS; i++) {
+		k_thread_access_grant(k_current_get(), &helper_tids[i],
+				      &helper_stacks[i]);
+	}
+#endif
+	return NULL;
+}
+
+ZTEST_SUITE(rwlock_tests, NULL, rwlock_tests_setup, rwlock_before, NULL, NULL);
@@ -0,0 +1,301 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define POOL_PRIORITY K_PRIO_PREEMPT(1)
+
+/* The queue thread plus the added workers */
+#define N_WORKERS 3
+#define N_ITEMS (2 * N_WORKERS)
+
+#define RUN_MS 50
+
+static K_THREAD_STACK_DEFINE(pool_stack, STACK_SIZE);
+static K_THREAD_STACK_ARRAY_DEFINE(worker_stacks, N_WORKERS - 1, STACK_SIZE);
+static struct k_work_q pool;
+static struct k_work_q_worker workers[N_WORKERS - 1];
+
+static struct k_work items[N_ITEMS];
+static struct k_work chained_work;
+static struct k_work_delayable dwork;
+
+/* Work synchronization objects must be in cache-coherent memory,
+ * which excludes stacks on some architectures.
+ */
+static struct k_work_sync work_sync;
+
+static atomic_t n_active;
+static atomic_t max_active;
+static atomic_t n_runs;
+static struct k_sem done_sem;
+
+static void track_active(atomic_t *active, atomic_t *max)
+{
+	atomic_val_t now = atomic_inc(active) + 1;
+	atomic_val_t prev;
+
+	do {
+		prev = atomic_get(max);
+	} while ((now > prev) && !atomic_cas(max, prev, now));
+}
+
+/* Blocks for RUN_MS, so overlapping runs show up in max_active */
+static void slow_handler(struct k_work *work)
+{
+	track_active(&n_active, &max_active);
+	k_msleep(RUN_MS);
+	atomic_dec(&n_active);
+
+	atomic_inc(&n_runs);
+	k_sem_give(&done_sem);
+}
+
+static void chained_handler(struct k_work *work)
+{
+	atomic_inc(&n_runs);
+	k_sem_give(&done_sem);
+}
+
+static void chaining_handler(struct k_work *work)
+{
+	zassert_equal(k_work_submit_to_queue(&pool, &chained_work), 1);
+	slow_handler(work);
+}
+
+static void reset(void)
+{
+	atomic_set(&n_active, 0);
+	atomic_set(&max_active, 0);
+	atomic_set(&n_runs, 0);
+	k_sem_reset(&done_sem);
+}
+
+/**
+ * @brief Test that a pool runs independent items concurrently
+ *
+ * @ingroup kernel_workqueue_tests
+ *
+ * @see k_work_queue_add_worker()
+ */
+ZTEST(work_pool, test_pool_concurrent)
+{
+	for (int i = 0; i < N_WORKERS; i++) {
+		k_work_init(&items[i], slow_handler);
+		zassert_equal(k_work_submit_to_queue(&pool, &items[i]), 1);
+	}
+
+	for (int i = 0; i < N_WORKERS; i++) {
+		zassert_ok(k_sem_take(&done_sem, K_MSEC(2 * RUN_MS)),
+			   "items were not run in parallel");
+	}
+
+	zassert_equal(atomic_get(&max_active), N_WORKERS);
+}
+
+/**
+ * @brief Test that an item resubmitted while running is not run twice
+ * at once
+ *
+ * @ingroup kernel_workqueue_tests
+ *
+ * @see k_work_submit_to_queue(), k_work_flush()
+ */
+ZTEST(work_pool, test_pool_no_reentrancy)
+{
+	k_work_init(&items[0], slow_handler);
+	zassert_equal(k_work_submit_to_queue(&pool, &items[0]), 1);
+
+	k_msleep(RUN_MS / 5);
+	zassert_equal(k_work_busy_get(&items[0]), K_WORK_RUNNING);
+
+	/* Other workers are idle, but must not pick it up */
+	zassert_equal(k_work_submit_to_queue(&pool, &items[0]), 2);
+	zassert_true(k_work_flush(&items[0], &work_sync));
+
+	zassert_equal(atomic_get(&n_runs), 2);
+	zassert_equal(atomic_get(&max_active), 1, "item ran concurrently");
+	zassert_equal(k_work_busy_get(&items[0]), 0);
+}
+
+/**
+ * @brief Test flushing an item running on a pool worker
+ *
+ * @ingroup kernel_workqueue_tests
+ *
+ * @see k_work_flush()
+ */
+ZTEST(work_pool, test_pool_running_flush)
+{
+	k_work_init(&items[0], slow_handler);
+	k_work_init(&items[1], slow_handler);
+	zassert_equal(k_work_submit_to_queue(&pool, &items[0]), 1);
+	zassert_equal(k_work_submit_to_queue(&pool, &items[1]), 1);
+
+	k_msleep(RUN_MS / 5);
+
+	/* Both run on different workers, the flush waits for the right one */
+	zassert_equal(k_work_busy_get(&items[1]), K_WORK_RUNNING);
+	zassert_true(k_work_flush(&items[1], &work_sync));
+	zassert_equal(k_work_busy_get(&items[1]), 0);
+	zassert_true(atomic_get(&n_runs) >= 1);
+
+	(void)k_work_flush(&items[0], &work_sync);
+	zassert_equal(atomic_get(&n_runs), 2);
+}
+
+/**
+ * @brief Test flushing items queued to idle pool workers
+ *
+ * The cooperative test thread queues each item and its flusher before
+ * any worker runs.  The pair can't be stolen, so the flush only
+ * completes if the worker owning the list was woken up.
+ *
+ * @ingroup kernel_workqueue_tests
+ *
+ * @see k_work_flush()
+ */
+ZTEST(work_pool, test_pool_queued_flush)
+{
+	/* Round robin puts one item on every list of the pool */
+	for (int i = 0; i < N_ITEMS; i++) {
+		k_work_init(&items[i], chained_handler);
+		zassert_equal(k_work_submit_to_queue(&pool, &items[i]), 1);
+		zassert_true(k_work_flush(&items[i], &work_sync));
+	}
+
+	zassert_equal(atomic_get(&n_runs), N_ITEMS);
+}
+
+/**
+ * @brief Test cancelling an item running on a pool worker
+ *
+ * @ingroup kernel_workqueue_tests
+ *
+ * @see k_work_cancel_sync()
+ */
+ZTEST(work_pool, test_pool_running_cancel_sync)
+{
+	k_work_init(&items[0], slow_handler);
+	zassert_equal(k_work_submit_to_queue(&pool, &items[0]), 1);
+
+	k_msleep(RUN_MS / 5);
+
+	zassert_true(k_work_cancel_sync(&items[0], &work_sync));
+	zassert_equal(atomic_get(&n_runs), 1);
+	zassert_equal(k_work_busy_get(&items[0]), 0);
+}
+
+/**
+ * @brief Test that draining a pool waits for all workers
+ *
+ * @ingroup kernel_workqueue_tests
+ *
+ * @see k_work_queue_drain()
+ */
+ZTEST(work_pool, test_pool_drain)
+{
+	for (int i = 0; i < N_ITEMS; i++) {
+		k_work_init(&items[i], slow_handler);
+		zassert_equal(k_work_submit_to_queue(&pool, &items[i]), 1);
+	}
+
+	zassert_equal(k_work_queue_drain(&pool, false), 1);
+	zassert_equal(atomic_get(&n_runs), N_ITEMS);
+	zassert_equal(atomic_get(&n_active), 0);
+	zassert_equal(atomic_get(&max_active), N_WORKERS);
+}
+
+/**
+ * @brief Test chained submission from a pool worker while draining
+ *
+ * @ingroup kernel_workqueue_tests
+ *
+ * @see k_work_submit_to_queue(), k_work_queue_drain()
+ */
+ZTEST(work_pool, test_pool_chained)
+{
+	k_work_init(&items[0], chaining_handler);
+	k_work_init(&chained_work, chained_handler);
+	zassert_equal(k_work_submit_to_queue(&pool, &items[0]), 1);
+
+	k_msleep(RUN_MS / 5);
+
+	/* The handler submits while the queue drains */
+	zassert_equal(k_work_queue_drain(&pool, true), 1);
+	zassert_equal(atomic_get(&n_runs), 2);
+
+	zassert_equal(k_work_submit_to_queue(&pool, &items[0]), -EBUSY);
+	zassert_ok(k_work_queue_unplug(&pool));
+}
+
+/**
+ * @brief Test delayable work on a pool
+ *
+ * @ingroup kernel_workqueue_tests
+ *
+ * @see k_work_schedule_for_queue(), k_work_flush_delayable()
+ */
+ZTEST(work_pool, test_pool_delayable)
+{
+	k_work_init_delayable(&dwork, slow_handler);
+	zassert_equal(k_work_schedule_for_queue(&pool, &dwork, K_MSEC(10)), 1);
+
+	zassert_true(k_work_flush_delayable(&dwork, &work_sync));
+	zassert_equal(atomic_get(&n_runs), 1);
+}
+
+#if CONFIG_SYSTEM_WORKQUEUE_WORKERS > 1
+/**
+ * @brief Test that the system workqueue runs items concurrently
+ *
+ * @ingroup kernel_workqueue_tests
+ *
+ * @see k_work_submit()
+ */
+ZTEST(work_pool, test_pool_system_queue)
+{
+	for (int i = 0; i < CONFIG_SYSTEM_WORKQUEUE_WORKERS; i++) {
+		k_work_init(&items[i], slow_handler);
+		zassert_equal(k_work_submit(&items[i]), 1);
+	}
+
+	for (int i = 0; i < CONFIG_SYSTEM_WORKQUEUE_WORKERS; i++) {
+		zassert_ok(k_sem_take(&done_sem, K_MSEC(2 * RUN_MS)));
+	}
+
+	zassert_equal(atomic_get(&max_active), CONFIG_SYSTEM_WORKQUEUE_WORKERS);
+}
+#endif
+
+static void *work_pool_setup(void)
+{
+	struct k_work_queue_config cfg = {
+		.name = "pool",
+	};
+
+	k_sem_init(&done_sem, 0, K_SEM_MAX_LIMIT);
+
+	k_work_queue_start(&pool, pool_stack, K_THREAD_STACK_SIZEOF(pool_stack),
+			   POOL_PRIORITY, &cfg);
+
+	for (int i = 0; i < N_WORKERS - 1; i++) {
+		k_work_queue_add_worker(&pool, &workers[i], worker_stacks[i],
+					K_THREAD_STACK_SIZEOF(worker_stacks[i]));
+	}
+
+	return NULL;
+}
+
+static void work_pool_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	reset();
+}
+
+ZTEST_SUITE(work_pool, NULL, work_pool_setup, work_pool_before, NULL, NULL);
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/sys/mutex.h>
+#include <zephyr/sys/condvar.h>
+#include <zephyr/sys/rwlock.h>
+
+#define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define HELPER_PRIO 5
+
+static K_THREAD_STACK_DEFINE(helper_stack, STACK_SIZE);
+static struct k_thread helper_thread;
+
+ZTEST_BMEM SYS_MUTEX_DEFINE(test_mutex);
+ZTEST_BMEM SYS_CONDVAR_DEFINE(test_condvar);
+ZTEST_BMEM SYS_RWLOCK_DEFINE(test_rwlock);
+
+static ZTEST_BMEM int helper_ret;
+static ZTEST_BMEM bool ready;
+
+static void helper_start(k_thread_entry_t entry)
+{
+	helper_ret = -1;
+
+	k_thread_create(&helper_thread, helper_stack, STACK_SIZE,
+			entry, NULL, NULL, NULL, HELPER_PRIO,
+			K_USER | K_INHERIT_PERMS, K_NO_WAIT);
+}
+
+static int helper_join(void)
+{
+	k_thread_join(&helper_thread, K_FOREVER);
+
+	return helper_ret;
+}
+
+static void mutex_trylock_helper(void *p1, void *p2, void *p3)
+{
+	if (sys_mutex_lock(&test_mutex, K_NO_WAIT) != -EBUSY) {
+		return;
+	}
+
+	helper_ret = sys_mutex_unlock(&test_mutex);
+}
+
+static void mutex_lock_helper(void *p1, void *p2, void *p3)
+{
+	helper_ret = sys_mutex_lock(&test_mutex, K_FOREVER);
+	if (helper_ret == 0) {
+		helper_ret = sys_mutex_unlock(&test_mutex);
+	}
+}
+
+ZTEST_USER(sys_locks, test_mutex)
+{
+	zassert_equal(sys_mutex_lock(&test_mutex, K_NO_WAIT), 0);
+	zassert_equal(sys_mutex_lock(&test_mutex, K_NO_WAIT), 0,
+		      "recursive lock failed");
+
+	/* Held by us, another thread neither gets it nor releases it */
+	helper_start(mutex_trylock_helper);
+	zassert_equal(helper_join(), -EPERM);
+
+	zassert_equal(sys_mutex_unlock(&test_mutex), 0);
+	zassert_equal(sys_mutex_unlock(&test_mutex), 0);
+	zassert_equal(sys_mutex_unlock(&test_mutex), -EINVAL);
+
+	/* Contended: the helper blocks until we unlock */
+	zassert_equal(sys_mutex_lock(&test_mutex, K_FOREVER), 0);
+	helper_start(mutex_lock_helper);
+	k_msleep(10);
+	zassert_equal(helper_ret, -1, "helper got a locked mutex");
+	zassert_equal(sys_mutex_unlock(&test_mutex), 0);
+	zassert_equal(helper_join(), 0);
+
+	zassert_equal(sys_mutex_lock(&test_mutex, K_NO_WAIT), 0);
+	zassert_equal(sys_mutex_unlock(&test_mutex), 0);
+}
+
+static void condvar_wait_helper(void *p1, void *p2, void *p3)
+{
+	int ret = 0;
+
+	sys_mutex_lock(&test_mutex, K_FOREVER);
+	while (!ready && ret == 0) {
+		ret = sys_condvar_wait(&test_condvar, &test_mutex, K_FOREVER);
+	}
+	sys_mutex_unlock(&test_mutex);
+
+	helper_ret = ret;
+}
+
+ZTEST_USER(sys_locks, test_condvar)
+{
+	/* Nobody waits, the mutex is locked again on timeout */
+	zassert_equal(sys_mutex_lock(&test_mutex, K_FOREVER), 0);
+	zassert_equal(sys_condvar_wait(&test_condvar, &test_mutex,
+				       K_MSEC(10)), -EAGAIN);
+	zassert_equal(sys_mutex_unlock(&test_mutex), 0);
+
+	zassert_equal(sys_condvar_signal(&test_condvar), 0);
+
+	ready = false;
+	helper_start(condvar_wait_helper);
+	k_msleep(10);
+
+	sys_mutex_lock(&test_mutex, K_FOREVER);
+	ready = true;
+	zassert_equal(sys_condvar_signal(&test_condvar), 0);
+	sys_mutex_unlock(&test_mutex);
+
+	zassert_equal(helper_join(), 0);
+}
+
+static void rwlock_read_helper(void *p1, void *p2, void *p3)
+{
+	helper_ret = sys_rwlock_read_lock(&test_rwlock, K_NO_WAIT);
+	if (helper_ret != 0) {
+		return;
+	}
+
+	sys_rwlock_read_unlock(&test_rwlock);
+
+	helper_ret = sys_rwlock_write_lock(&test_rwlock, K_NO_WAIT);
+}
+
+static void rwlock_read_wait_helper(void *p1, void *p2, void *p3)
+{
+	helper_ret = sys_rwlock_read_lock(&test_rwlock, K_FOREVER);
+	if (helper_ret == 0) {
+		helper_ret = sys_rwlock_read_unlock(&test_rwlock);
+	}
+}
+
+ZTEST_USER(sys_locks, test_rwlock)
+{
+	zassert_equal(sys_rwlock_read_unlock(&test_rwlock), -EINVAL);
+	zassert_equal(sys_rwlock_write_unlock(&test_rwlock), -EPERM);
+
+	/* Readers share the lock, writers do not get it */
+	zassert_equal(sys_rwlock_read_lock(&test_rwlock, K_NO_WAIT), 0);
+	helper_start(rwlock_read_helper);
+	zassert_equal(helper_join(), -EBUSY);
+	zassert_equal(sys_rwlock_write_lock(&test_rwlock, K_NO_WAIT), -EBUSY);
+	zassert_equal(sys_rwlock_read_unlock(&test_rwlock), 0);
+
+	/* Readers wait for the writer */
+	zassert_equal(sys_rwlock_write_lock(&test_rwlock, K_NO_WAIT), 0);
+	zassert_equal(sys_rwlock_read_lock(&test_rwlock, K_NO_WAIT), -EBUSY);
+	zassert_equal(sys_rwlock_read_lock(&test_rwlock, K_MSEC(10)), -EAGAIN);
+	helper_start(rwlock_read_wait_helper);
+	k_msleep(10);
+	zassert_equal(helper_ret, -1, "reader got a write locked lock");
+	zassert_equal(sys_rwlock_write_unlock(&test_rwlock), 0);
+	zassert_equal(helper_join(), 0);
+
+	zassert_equal(sys_rwlock_write_lock(&test_rwlock, K_NO_WAIT), 0);
+	zassert_equal(sys_rwlock_write_unlock(&test_rwlock), 0);
+}
+
+ZTEST_SUITE(sys_locks, NULL, NULL, NULL, NULL, NULL);
@@ -9,6 +9,7 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
 
 #include <zephyr/ztest_assert.h>
 #include <fcntl.h>
+#include <string.h>
 #include <zephyr/net/socket.h>
 #include <zephyr/net/loopback.h>
 
@@ -336,7 +337,8 @@ void tcp_server_block_thread(void *vps_sock, void *unused2, void *unused3)
 	test_close(new_sock);
 }
 
-void test_send_recv_large_common(int tcp_nodelay, int family)
+void test_send_recv_large_common(int tcp_nodelay, const char *congestion,
+				 int family)
 {
 	int rv;
 	int c_sock;
@@ -380,6 +382,12 @@ void test_send_recv_large_common(int tcp_nodelay, int family)
 	rv = setsockopt(c_sock, IPPROTO_TCP, TCP_NODELAY, (char *) &tcp_nodelay, sizeof(int));
 	zassert_equal(rv, 0, "setsockopt failed (%d)", rv);
 
+	if (congestion != NULL) {
+		rv = setsockopt(c_sock, IPPROTO_TCP, TCP_CONGESTION, congestion,
+				strlen(congestion));
+		zassert_equal(rv, 0, "setsockopt failed (%d)", rv);
+	}
+
 	/* send piece by piece */
 	ssize_t total_send = 0;
 	int iteration = 0;
@@ -436,41 +444,106 @@ static void restore_packet_loss_ratio(void)
 
 ZTEST(net_socket_tcp, test_v4_send_recv_large_normal)
 {
-	test_send_recv_large_common(0, AF_INET);
+	test_send_recv_large_common(0, NULL, AF_INET);
 }
 
 ZTEST(net_socket_tcp, test_v4_send_recv_large_packet_loss)
 {
 	set_packet_loss_ratio();
-	test_send_recv_large_common(0, AF_INET);
+	test_send_recv_large_common(0, NULL, AF_INET);
 	restore_packet_loss_ratio();
 }
 
 ZTEST(net_socket_tcp, test_v4_send_recv_large_no_delay)
 {
 	set_packet_loss_ratio();
-	test_send_recv_large_common(1, AF_INET);
+	test_send_recv_large_common(1, NULL, AF_INET);
 	restore_packet_loss_ratio();
 }
 
 ZTEST(net_socket_tcp, test_v6_send_recv_large_normal)
 {
-	test_send_recv_large_common(0, AF_INET6);
+	test_send_recv_large_common(0, NULL, AF_INET6);
 }
 
 ZTEST(net_socket_tcp, test_v6_send_recv_large_packet_loss)
 {
 	set_packet_loss_ratio();
-	test_send_recv_large_common(0, AF_INET6);
+	test_send_recv_large_common(0, NULL, AF_INET6);
 	restore_packet_loss_ratio();
 }
 
 ZTEST(net_socket_tcp, test_v6_send_recv_large_no_delay)
 {
 	set_packet_loss_ratio();
-	test_send_recv_large_common(1, AF_INET6);
+	test_send_recv_large_common(1, NULL, AF_INET6);
+	restore_packet_loss_ratio();
+}
+
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+/* Delay the loopback, so that the congestion window, not the loopback
+ * speed, paces the transfer, and make losses happen.
+ */
+static void set_packet_loss_and_delay(void)
+{
+	set_packet_loss_ratio();
+	zassert_equal(loopback_set_packet_delay(10), 0,
+		      "Error setting packet delay");
+}
+
+static void restore_packet_loss_and_delay(void)
+{
 	restore_packet_loss_ratio();
+	zassert_equal(loopback_set_packet_delay(0), 0,
+		      "Error setting packet delay");
+}
+
+ZTEST(net_socket_tcp, test_v4_send_recv_large_newreno)
+{
+	set_packet_loss_and_delay();
+	test_send_recv_large_common(0, "newreno", AF_INET);
+	restore_packet_loss_and_delay();
+}
+
+ZTEST(net_socket_tcp, test_v6_send_recv_large_cubic)
+{
+	set_packet_loss_and_delay();
+	test_send_recv_large_common(0, "cubic", AF_INET6);
+	restore_packet_loss_and_delay();
+}
+
+ZTEST(net_socket_tcp, test_tcp_congestion_option)
+{
+	struct sockaddr_in addr;
+	char name[16];
+	socklen_t optlen = sizeof(name);
+	int sock;
+	int rv;
+
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, ANY_PORT, &sock, &addr);
+
+	rv = getsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, name, &optlen);
+	zassert_equal(rv, 0, "getsockopt failed (%d)", errno);
+	zassert_equal(optlen, sizeof("newreno"));
+	zassert_mem_equal(name, "newreno", optlen);
+
+	rv = setsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, "cubic",
+			strlen("cubic"));
+	zassert_equal(rv, 0, "setsockopt failed (%d)", errno);
+
+	optlen = sizeof(name);
+	rv = getsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, name, &optlen);
+	zassert_equal(rv, 0, "getsockopt failed (%d)", errno);
+	zassert_mem_equal(name, "cubic", optlen);
+
+	rv = setsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, "vegas",
+			strlen("vegas"));
+	zassert_equal(rv, -1, "unknown algorithm accepted");
+	zassert_equal(errno, ENOENT);
+
+	test_close(sock);
 }
+#endif /* CONFIG_NET_TCP_CONGESTION_CONTROL */
 
 ZTEST(net_socket_tcp, test_v4_broken_link)
 {
@@ -1793,6 +1866,121 @@ ZTEST(net_socket_tcp, test_v6_msg_waitall)
 	test_context_cleanup();
 }
 
+#define LOAN_IOV_COUNT 8
+
+static void test_recv_loan_data(int sock, const char *expected, size_t len,
+				void **loan)
+{
+	struct iovec iov[LOAN_IOV_COUNT];
+	size_t iovcnt = LOAN_IOV_COUNT;
+	size_t offset = 0;
+	ssize_t rv;
+
+	rv = zsock_recv_loan(sock, iov, &iovcnt, loan, 0);
+	zassert_equal(rv, len, "recv_loan failed (%d)", errno);
+	zassert_not_null(*loan, "no loan");
+
+	for (size_t i = 0; i < iovcnt; i++) {
+		zassert_true(offset + iov[i].iov_len <= len, "too much data");
+		zassert_mem_equal(iov[i].iov_base, expected + offset,
+				  iov[i].iov_len, "invalid rx data");
+		offset += iov[i].iov_len;
+	}
+
+	zassert_equal(offset, len, "invalid length loaned");
+}
+
+ZTEST(net_socket_tcp, test_v4_recv_loan)
+{
+	int rv;
+	int c_sock;
+	int s_sock;
+	int new_sock;
+	struct sockaddr_in c_saddr;
+	struct sockaddr_in s_saddr;
+	struct sockaddr addr;
+	socklen_t addrlen = sizeof(addr);
+	char tx_buf[] = TEST_STR_SMALL;
+	int buf_optval = sizeof(TEST_STR_SMALL);
+	struct iovec iov[LOAN_IOV_COUNT];
+	size_t iovcnt;
+	char rx_buf[2];
+	void *eof_loan;
+	void *loan;
+
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, ANY_PORT, &c_sock, &c_saddr);
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, SERVER_PORT, &s_sock, &s_saddr);
+
+	test_bind(s_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_listen(s_sock);
+
+	/* Nothing to loan on a socket which is not connected */
+	iovcnt = LOAN_IOV_COUNT;
+	rv = zsock_recv_loan(s_sock, iov, &iovcnt, &loan, 0);
+	zassert_equal(rv, -1, "recv_loan should have failed");
+	zassert_equal(errno, ENOTCONN, "incorrect errno value");
+
+	test_connect(c_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+
+	test_accept(s_sock, &new_sock, &addr, &addrlen);
+	zassert_equal(addrlen, sizeof(struct sockaddr_in), "wrong addrlen");
+
+	/* Lower server-side RX window size, so that the data fills it */
+	rv = setsockopt(new_sock, SOL_SOCKET, SO_RCVBUF, &buf_optval,
+			sizeof(buf_optval));
+	zassert_equal(rv, 0, "setsockopt failed (%d)", errno);
+
+	test_send(c_sock, tx_buf, sizeof(tx_buf), MSG_DONTWAIT);
+	k_msleep(150);
+
+	test_recv_loan_data(new_sock, tx_buf, sizeof(tx_buf), &loan);
+
+	/* The loaned data is not consumed yet, the window stays closed */
+	k_msleep(150);
+	rv = send(c_sock, tx_buf, 1, MSG_DONTWAIT);
+	zassert_equal(rv, -1, "Unexpected return code %d", rv);
+	zassert_equal(errno, EAGAIN, "Unexpected errno value: %d", errno);
+
+	zsock_recv_loan_release(loan);
+
+	/* Releasing the loan reopens the window */
+	k_msleep(150);
+	test_send(c_sock, tx_buf, sizeof(tx_buf), MSG_DONTWAIT);
+	k_msleep(150);
+
+	/* Only the rest of a partially read segment is loaned */
+	rv = recv(new_sock, rx_buf, sizeof(rx_buf), 0);
+	zassert_equal(rv, sizeof(rx_buf), "recv failed (%d)", errno);
+	zassert_mem_equal(rx_buf, tx_buf, sizeof(rx_buf), "invalid rx data");
+
+	test_recv_loan_data(new_sock, tx_buf + sizeof(rx_buf),
+			    sizeof(tx_buf) - sizeof(rx_buf), &loan);
+
+	/* End of stream, nothing is loaned */
+	test_close(c_sock);
+
+	iovcnt = LOAN_IOV_COUNT;
+	rv = zsock_recv_loan(new_sock, iov, &iovcnt, &eof_loan, 0);
+	zassert_equal(rv, 0, "recv_loan should have returned EOF (%d)", errno);
+	zassert_is_null(eof_loan, "unexpected loan");
+	zassert_equal(iovcnt, 0, "unexpected iovcnt %zu", iovcnt);
+
+	/* Calling again should be OK */
+	iovcnt = LOAN_IOV_COUNT;
+	rv = zsock_recv_loan(new_sock, iov, &iovcnt, &eof_loan, 0);
+	zassert_equal(rv, 0, "recv_loan should have returned EOF (%d)", errno);
+
+	/* The loan outlives the socket, and holds its context until given
+	 * back
+	 */
+	test_close(new_sock);
+	test_close(s_sock);
+
+	zsock_recv_loan_release(loan);
+
+	test_context_cleanup();
+}
+
 #ifdef CONFIG_USERSPACE
 #define CHILD_STACK_SZ		(2048 + CONFIG_TEST_EXTRA_STACK_SIZE)
 struct k_thread child_thread;
@@ -14,6 +14,7 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
 
 #include <zephyr/net/socket.h>
 #include <zephyr/net/ethernet.h>
+#include <zephyr/net/ptp_time.h>
 
 #include "ipv6.h"
 #include "../../socket_helpers.h"
@@ -1286,4 +1287,328 @@ ZTEST(net_socket_udp, test_23_v6_dgram_overflow)
 			    BUF_AND_SIZE(test_str_all_tx_bufs));
 }
 
+static void comm_sendto_recvmsg(int client_sock, int server_sock,
+				struct sockaddr *server_addr,
+				socklen_t server_addrlen,
+				struct msghdr *msg, int expected_flags)
+{
+	char part1[2], part2[8];
+	struct iovec io_vector[2] = {
+		{ .iov_base = part1, .iov_len = sizeof(part1) },
+		{ .iov_base = part2, .iov_len = sizeof(part2) },
+	};
+	ssize_t sent, recved;
+
+	sent = sendto(client_sock, BUF_AND_SIZE(TEST_STR_SMALL), 0,
+		      server_addr, server_addrlen);
+	zassert_equal(sent, STRLEN(TEST_STR_SMALL), "sendto failed");
+
+	msg->msg_iov = io_vector;
+	msg->msg_iovlen = ARRAY_SIZE(io_vector);
+
+	recved = recvmsg(server_sock, msg, 0);
+	zassert_equal(recved, STRLEN(TEST_STR_SMALL), "recvmsg failed (%d)",
+		      -errno);
+	zassert_mem_equal(part1, TEST_STR_SMALL, sizeof(part1),
+			  "invalid rx data");
+	zassert_mem_equal(part2, TEST_STR_SMALL + sizeof(part1),
+			  STRLEN(TEST_STR_SMALL) - sizeof(part1),
+			  "invalid rx data");
+	zassert_equal(msg->msg_flags, expected_flags, "invalid flags");
+}
+
+static bool find_cmsg(struct msghdr *msg, int level, int type,
+		      void *data, size_t len)
+{
+	struct cmsghdr *cmsg;
+
+	for (cmsg = CMSG_FIRSTHDR(msg); cmsg != NULL;
+	     cmsg = CMSG_NXTHDR(msg, cmsg)) {
+		if (cmsg->cmsg_level == level && cmsg->cmsg_type == type) {
+			zassert_equal(cmsg->cmsg_len, CMSG_LEN(len),
+				      "invalid control message length");
+			memcpy(data, CMSG_DATA(cmsg), len);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+ZTEST_USER(net_socket_udp, test_24_v4_recvmsg_pktinfo_timestamping)
+{
+	int rv;
+	int opt = 1;
+	int client_sock;
+	int server_sock;
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	struct sockaddr_in src_addr;
+	struct msghdr msg;
+	struct in_pktinfo pktinfo;
+	struct net_ptp_time ts;
+	union {
+		struct cmsghdr hdr;
+		unsigned char  buf[CMSG_SPACE(sizeof(struct in_pktinfo)) +
+				   CMSG_SPACE(sizeof(struct net_ptp_time))];
+	} cmsgbuf;
+
+	prepare_sock_udp_v4(MY_IPV4_ADDR, ANY_PORT, &client_sock, &client_addr);
+	prepare_sock_udp_v4(MY_IPV4_ADDR, SERVER_PORT, &server_sock, &server_addr);
+
+	rv = bind(server_sock, (struct sockaddr *)&server_addr,
+		  sizeof(server_addr));
+	zassert_equal(rv, 0, "server bind failed");
+
+	rv = setsockopt(server_sock, IPPROTO_IP, IP_PKTINFO, &opt, sizeof(opt));
+	zassert_equal(rv, 0, "setsockopt IP_PKTINFO failed (%d)", -errno);
+
+	opt = SOF_TIMESTAMPING_RX_SOFTWARE;
+	rv = setsockopt(server_sock, SOL_SOCKET, SO_TIMESTAMPING, &opt,
+			sizeof(opt));
+	zassert_equal(rv, 0, "setsockopt SO_TIMESTAMPING failed (%d)", -errno);
+
+	memset(&msg, 0, sizeof(msg));
+	msg.msg_name = &src_addr;
+	msg.msg_namelen = sizeof(src_addr);
+	msg.msg_control = &cmsgbuf.buf;
+	msg.msg_controllen = sizeof(cmsgbuf.buf);
+
+	comm_sendto_recvmsg(client_sock, server_sock,
+			    (struct sockaddr *)&server_addr,
+			    sizeof(server_addr), &msg, 0);
+
+	zassert_equal(msg.msg_namelen, sizeof(src_addr), "invalid addrlen");
+	zassert_equal(src_addr.sin_family, AF_INET, "invalid family");
+
+	zassert_true(find_cmsg(&msg, IPPROTO_IP, IP_PKTINFO,
+			       &pktinfo, sizeof(pktinfo)),
+		     "no IP_PKTINFO control message");
+	zassert_true(pktinfo.ipi_ifindex > 0, "invalid interface index");
+	zassert_equal(pktinfo.ipi_addr.s_addr, server_addr.sin_addr.s_addr,
+		      "invalid destination address");
+
+	zassert_true(find_cmsg(&msg, SOL_SOCKET, SCM_TIMESTAMPING,
+			       &ts, sizeof(ts)),
+		     "no SCM_TIMESTAMPING control message");
+	zassert_true(ts.second != 0U || ts.nanosecond != 0U, "no timestamp");
+
+	/* No room left for the timestamp */
+	msg.msg_namelen = sizeof(src_addr);
+	msg.msg_controllen = CMSG_SPACE(sizeof(struct in_pktinfo));
+
+	comm_sendto_recvmsg(client_sock, server_sock,
+			    (struct sockaddr *)&server_addr,
+			    sizeof(server_addr), &msg, ZSOCK_MSG_CTRUNC);
+
+	zassert_equal(msg.msg_controllen, CMSG_SPACE(sizeof(struct in_pktinfo)),
+		      "invalid control length");
+
+	rv = close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
+ZTEST_USER(net_socket_udp, test_25_v6_recvmsg_pktinfo)
+{
+	int rv;
+	int opt = 1;
+	int client_sock;
+	int server_sock;
+	struct sockaddr_in6 client_addr;
+	struct sockaddr_in6 server_addr;
+	struct sockaddr_in6 src_addr;
+	struct msghdr msg;
+	struct in6_pktinfo pktinfo;
+	union {
+		struct cmsghdr hdr;
+		unsigned char  buf[CMSG_SPACE(sizeof(struct in6_pktinfo))];
+	} cmsgbuf;
+
+	prepare_sock_udp_v6(MY_IPV6_ADDR, ANY_PORT, &client_sock, &client_addr);
+	prepare_sock_udp_v6(MY_IPV6_ADDR, SERVER_PORT, &server_sock, &server_addr);
+
+	rv = bind(server_sock, (struct sockaddr *)&server_addr,
+		  sizeof(server_addr));
+	zassert_equal(rv, 0, "server bind failed");
+
+	rv = setsockopt(server_sock, IPPROTO_IPV6, IPV6_RECVPKTINFO, &opt,
+			sizeof(opt));
+	zassert_equal(rv, 0, "setsockopt IPV6_RECVPKTINFO failed (%d)", -errno);
+
+	memset(&msg, 0, sizeof(msg));
+	msg.msg_name = &src_addr;
+	msg.msg_namelen = sizeof(src_addr);
+	msg.msg_control = &cmsgbuf.buf;
+	msg.msg_controllen = sizeof(cmsgbuf.buf);
+
+	comm_sendto_recvmsg(client_sock, server_sock,
+			    (struct sockaddr *)&server_addr,
+			    sizeof(server_addr), &msg, 0);
+
+	zassert_equal(msg.msg_namelen, sizeof(src_addr), "invalid addrlen");
+	zassert_equal(src_addr.sin6_family, AF_INET6, "invalid family");
+
+	zassert_true(find_cmsg(&msg, IPPROTO_IPV6, IPV6_PKTINFO,
+			       &pktinfo, sizeof(pktinfo)),
+		     "no IPV6_PKTINFO control message");
+	zassert_true(pktinfo.ipi6_ifindex > 0, "invalid interface index");
+	zassert_mem_equal(&pktinfo.ipi6_addr, &server_addr.sin6_addr,
+			  sizeof(struct in6_addr),
+			  "invalid destination address");
+
+	rv = close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
+#define MMSG_COUNT 3
+
+static ZTEST_BMEM char mmsg_bufs[MMSG_COUNT + 1][sizeof(TEST_STR2)];
+
+ZTEST_USER(net_socket_udp, test_26_v4_sendmmsg_recvmmsg)
+{
+	int rv;
+	int client_sock;
+	int server_sock;
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	struct mmsghdr msgs[MMSG_COUNT + 1];
+	struct iovec tx_iov[MMSG_COUNT];
+	struct iovec rx_iov[MMSG_COUNT + 1];
+	int count = 0;
+
+	prepare_sock_udp_v4(MY_IPV4_ADDR, ANY_PORT, &client_sock, &client_addr);
+	prepare_sock_udp_v4(MY_IPV4_ADDR, SERVER_PORT, &server_sock, &server_addr);
+
+	rv = bind(server_sock, (struct sockaddr *)&server_addr,
+		  sizeof(server_addr));
+	zassert_equal(rv, 0, "server bind failed");
+
+	rv = connect(client_sock, (struct sockaddr *)&server_addr,
+		     sizeof(server_addr));
+	zassert_equal(rv, 0, "connect failed");
+
+	/* Messages of growing length */
+	memset(msgs, 0, sizeof(msgs));
+	for (int i = 0; i < MMSG_COUNT; i++) {
+		tx_iov[i].iov_base = TEST_STR2;
+		tx_iov[i].iov_len = STRLEN(TEST_STR2) - (MMSG_COUNT - i);
+		msgs[i].msg_hdr.msg_iov = &tx_iov[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	rv = sendmmsg(client_sock, msgs, MMSG_COUNT, 0);
+	zassert_equal(rv, MMSG_COUNT, "sendmmsg failed (%d)", -errno);
+
+	for (int i = 0; i < MMSG_COUNT; i++) {
+		zassert_equal(msgs[i].msg_len, tx_iov[i].iov_len,
+			      "invalid length sent");
+	}
+
+	/* One message more than sent, the last one is not waited for */
+	memset(msgs, 0, sizeof(msgs));
+	for (int i = 0; i < MMSG_COUNT + 1; i++) {
+		rx_iov[i].iov_base = mmsg_bufs[i];
+		rx_iov[i].iov_len = sizeof(mmsg_bufs[i]);
+		msgs[i].msg_hdr.msg_iov = &rx_iov[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	/* The messages may not all be queued yet when the first one is */
+	while (count < MMSG_COUNT) {
+		rv = recvmmsg(server_sock, &msgs[count], MMSG_COUNT + 1 - count,
+			      MSG_WAITFORONE, NULL);
+		zassert_true(rv > 0, "recvmmsg failed (%d)", -errno);
+		count += rv;
+	}
+
+	zassert_equal(count, MMSG_COUNT, "received too many messages");
+
+	for (int i = 0; i < MMSG_COUNT; i++) {
+		zassert_equal(msgs[i].msg_len, tx_iov[i].iov_len,
+			      "invalid length received");
+		zassert_mem_equal(mmsg_bufs[i], TEST_STR2, msgs[i].msg_len,
+				  "invalid rx data");
+	}
+
+	/* Nothing left */
+	rv = recvmmsg(server_sock, msgs, 1, MSG_DONTWAIT, NULL);
+	zassert_equal(rv, -1, "recvmmsg should have failed");
+	zassert_equal(errno, EAGAIN, "incorrect errno value");
+
+	rv = close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
+#define LOAN_IOV_COUNT 8
+
+ZTEST(net_socket_udp, test_27_v4_recv_loan)
+{
+	int rv;
+	int client_sock;
+	int server_sock;
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	struct iovec iov[LOAN_IOV_COUNT];
+	size_t iovcnt;
+	size_t offset = 0;
+	void *loan;
+
+	prepare_sock_udp_v4(MY_IPV4_ADDR, ANY_PORT, &client_sock, &client_addr);
+	prepare_sock_udp_v4(MY_IPV4_ADDR, SERVER_PORT, &server_sock, &server_addr);
+
+	rv = bind(server_sock, (struct sockaddr *)&server_addr,
+		  sizeof(server_addr));
+	zassert_equal(rv, 0, "server bind failed");
+
+	rv = connect(client_sock, (struct sockaddr *)&server_addr,
+		     sizeof(server_addr));
+	zassert_equal(rv, 0, "connect failed");
+
+	rv = send(client_sock, BUF_AND_SIZE(TEST_STR2), 0);
+	zassert_equal(rv, STRLEN(TEST_STR2), "send failed");
+
+	/* The datagram spans several buffers, one entry is not enough */
+	iovcnt = 1;
+	rv = zsock_recv_loan(server_sock, iov, &iovcnt, &loan, 0);
+	zassert_equal(rv, -1, "recv_loan should have failed");
+	zassert_equal(errno, EMSGSIZE, "incorrect errno value");
+	zassert_true(iovcnt > 1 && iovcnt <= LOAN_IOV_COUNT,
+		     "invalid iovcnt %zu", iovcnt);
+
+	/* The datagram is still queued */
+	iovcnt = LOAN_IOV_COUNT;
+	rv = zsock_recv_loan(server_sock, iov, &iovcnt, &loan, 0);
+	zassert_equal(rv, STRLEN(TEST_STR2), "recv_loan failed (%d)", -errno);
+	zassert_not_null(loan, "no loan");
+
+	for (size_t i = 0; i < iovcnt; i++) {
+		zassert_true(offset + iov[i].iov_len <= STRLEN(TEST_STR2),
+			     "too much data");
+		zassert_mem_equal(iov[i].iov_base, TEST_STR2 + offset,
+				  iov[i].iov_len, "invalid rx data");
+		offset += iov[i].iov_len;
+	}
+
+	zassert_equal(offset, STRLEN(TEST_STR2), "invalid length loaned");
+
+	zsock_recv_loan_release(loan);
+
+	/* Nothing left */
+	iovcnt = LOAN_IOV_COUNT;
+	rv = zsock_recv_loan(server_sock, iov, &iovcnt, &loan, MSG_DONTWAIT);
+	zassert_equal(rv, -1, "recv_loan should have failed");
+	zassert_equal(errno, EAGAIN, "incorrect errno value");
+
+	rv = close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
 ZTEST_SUITE(net_socket_udp, NULL, NULL, NULL, NULL, NULL);
@@ -47,6 +47,10 @@ ZTEST(posix_headers, test_sys_socket_h)
 	zassert_not_equal(-1, offsetof(struct msghdr, msg_controllen));
 	zassert_not_equal(-1, offsetof(struct msghdr, msg_flags));
 
+	/* not in POSIX, used by sendmmsg() and recvmmsg() */
+	zassert_not_equal(-1, offsetof(struct mmsghdr, msg_hdr));
+	zassert_not_equal(-1, offsetof(struct mmsghdr, msg_len));
+
 	zassert_not_equal(-1, offsetof(struct cmsghdr, cmsg_len));
 	zassert_not_equal(-1, offsetof(struct cmsghdr, cmsg_level));
 	zassert_not_equal(-1, offsetof(struct cmsghdr, cmsg_type));
@@ -109,8 +113,10 @@ ZTEST(posix_headers, test_sys_socket_h)
 		zassert_not_null(listen);
 		zassert_not_null(recv);
 		zassert_not_null(recvfrom);
-		/* zassert_not_null(recvmsg); */ /* not implemented */
+		zassert_not_null(recvmmsg); /* not in POSIX */
+		zassert_not_null(recvmsg);
 		zassert_not_null(send);
+		zassert_not_null(sendmmsg); /* not in POSIX */
 		zassert_not_null(sendmsg);
 		zassert_not_null(sendto);
 		zassert_not_null(setsockopt);
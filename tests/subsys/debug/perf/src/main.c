@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/debug/perf.h>
+
+#define FREQ MIN(100, CONFIG_SYS_CLOCK_TICKS_PER_SEC)
+
+struct perf_count {
+	uint32_t total;
+	uint32_t current;
+	uint32_t with_pc;
+};
+
+static void count_cb(const struct perf_sample *sample, void *user_data)
+{
+	struct perf_count *count = user_data;
+
+	count->total++;
+
+	if (sample->thread == k_current_get()) {
+		count->current++;
+
+		if (sample->pc != 0U) {
+			count->with_pc++;
+		}
+	}
+}
+
+/**
+ * @brief Test starting and stopping the profiler
+ *
+ * @see perf_start(), perf_stop(), perf_foreach()
+ */
+ZTEST(perf, test_perf_start_stop)
+{
+	struct perf_count count = { 0 };
+	uint32_t taken;
+
+	zassert_equal(perf_start(0), -EINVAL);
+	zassert_equal(perf_start(CONFIG_SYS_CLOCK_TICKS_PER_SEC + 1), -EINVAL);
+	zassert_equal(perf_stop(), -EALREADY);
+
+	zassert_equal(perf_start(FREQ), 0);
+	zassert_equal(perf_start(FREQ), -EALREADY);
+	zassert_equal(perf_foreach(count_cb, &count), -EBUSY);
+	k_busy_wait(100 * USEC_PER_MSEC);
+	zassert_equal(perf_stop(), 0);
+	zassert_equal(perf_stop(), -EALREADY);
+
+	taken = perf_samples_taken();
+	zassert_true(taken > 0);
+
+	/* A new run discards the samples of the previous one */
+	zassert_equal(perf_start(FREQ), 0);
+	zassert_equal(perf_stop(), 0);
+	zassert_true(perf_samples_taken() < taken);
+}
+
+/**
+ * @brief Test that samples are attributed to the running thread
+ *
+ * @see perf_foreach(), perf_samples_taken()
+ */
+ZTEST(perf, test_perf_samples)
+{
+	struct perf_count count = { 0 };
+	int ret;
+
+	zassert_equal(perf_start(FREQ), 0);
+
+	/* Keep this thread on the CPU for half a second */
+	for (int i = 0; i < 500; i++) {
+		k_busy_wait(USEC_PER_MSEC);
+	}
+
+	zassert_equal(perf_stop(), 0);
+
+	zassert_true(perf_samples_taken() >= FREQ / 4,
+		     "only %u samples taken", perf_samples_taken());
+
+	ret = perf_foreach(count_cb, &count);
+
+	/* Only the most recent ones are kept */
+	zassert_equal(ret, MIN(perf_samples_taken(),
+			       CONFIG_PROFILING_PERF_BUFFER_SIZE));
+	zassert_equal(count.total, ret);
+
+	zassert_true(count.current * 2 > count.total,
+		     "%u of %u samples in the busy thread", count.current,
+		     count.total);
+
+	if (IS_ENABLED(CONFIG_ARCH_HAS_PERF_SAMPLE)) {
+		zassert_equal(count.with_pc, count.current);
+	}
+}
+
+ZTEST_SUITE(perf, NULL, NULL, NULL, NULL, NULL);
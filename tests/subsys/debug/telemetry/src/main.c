@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/debug/telemetry.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/crc.h>
+#include <string.h>
+
+#define MAX_RECORDS 4
+#define MAX_RECORD_LEN 1024
+
+struct test_record {
+	size_t length;
+	uint8_t data[MAX_RECORD_LEN];
+};
+
+static struct test_record records[MAX_RECORDS];
+static size_t num_records;
+
+static void test_backend_output(const struct telemetry_backend *backend,
+				const uint8_t *data, size_t length)
+{
+	ARG_UNUSED(backend);
+
+	if ((num_records == MAX_RECORDS) || (length > MAX_RECORD_LEN)) {
+		return;
+	}
+
+	memcpy(records[num_records].data, data, length);
+	records[num_records].length = length;
+	num_records++;
+}
+
+static const struct telemetry_backend_api test_backend_api = {
+	.output = test_backend_output,
+};
+
+TELEMETRY_BACKEND_DEFINE(test_backend, test_backend_api);
+
+/* Check the framing of a record and return its payload */
+static const uint8_t *check_record(const struct test_record *rec,
+				   uint8_t type, size_t *length)
+{
+	struct telemetry_record_hdr hdr;
+	size_t total;
+
+	zassert_true(rec->length > sizeof(hdr) + sizeof(uint16_t));
+	memcpy(&hdr, rec->data, sizeof(hdr));
+
+	zassert_equal(hdr.magic[0], TELEMETRY_MAGIC0);
+	zassert_equal(hdr.magic[1], TELEMETRY_MAGIC1);
+	zassert_equal(hdr.version, TELEMETRY_VERSION);
+	zassert_equal(hdr.type, type);
+
+	*length = sys_le16_to_cpu(hdr.length);
+	total = sizeof(hdr) + *length;
+	zassert_equal(rec->length, total + sizeof(uint16_t));
+	zassert_equal(sys_get_le16(&rec->data[total]),
+		      crc16_ccitt(0xffff, rec->data, total), "bad CRC");
+
+	return &rec->data[sizeof(hdr)];
+}
+
+static void find_current(const uint8_t *payload, size_t length,
+			 struct telemetry_thread *found)
+{
+	struct telemetry_snapshot snap;
+	const uint8_t *pos;
+	uint32_t id = (uint32_t)(uintptr_t)k_current_get();
+
+	memcpy(&snap, payload, sizeof(snap));
+	zassert_equal(snap.num_cpus, arch_num_cpus());
+	zassert_true(snap.num_threads >= 2U, "idle and test threads missing");
+	zassert_equal(length, sizeof(snap) +
+		      (snap.num_cpus * sizeof(struct telemetry_cpu)) +
+		      (snap.num_threads * sizeof(struct telemetry_thread)));
+
+	pos = payload + sizeof(snap) +
+	      (snap.num_cpus * sizeof(struct telemetry_cpu));
+
+	for (int i = 0; i < snap.num_threads; i++) {
+		struct telemetry_thread entry;
+
+		memcpy(&entry, pos, sizeof(entry));
+		pos += sizeof(entry);
+
+		if (sys_le32_to_cpu(entry.id) == id) {
+			*found = entry;
+			return;
+		}
+	}
+
+	zassert_unreachable("current thread not in snapshot");
+}
+
+/**
+ * @brief Test the records written for a snapshot
+ *
+ * @see telemetry_snapshot()
+ */
+ZTEST(telemetry, test_telemetry_snapshot)
+{
+	struct telemetry_thread first, second;
+	const uint8_t *payload;
+	size_t length;
+
+	num_records = 0;
+	zassert_ok(telemetry_snapshot());
+
+	/* First snapshot, thread names follow */
+	zassert_equal(num_records, 2);
+	payload = check_record(&records[0], TELEMETRY_RECORD_SNAPSHOT, &length);
+	find_current(payload, length, &first);
+	(void)check_record(&records[1], TELEMETRY_RECORD_THREAD_NAMES, &length);
+
+	zassert_true(sys_le32_to_cpu(first.stack_used) > 0U);
+	zassert_true(sys_le32_to_cpu(first.stack_used) <=
+		     sys_le32_to_cpu(first.stack_size));
+
+	k_busy_wait(10000);
+
+	/* Same threads, no names this time */
+	num_records = 0;
+	zassert_ok(telemetry_snapshot());
+	zassert_equal(num_records, 1);
+	payload = check_record(&records[0], TELEMETRY_RECORD_SNAPSHOT, &length);
+	find_current(payload, length, &second);
+
+	zassert_true(sys_le64_to_cpu(second.cycles) >
+		     sys_le64_to_cpu(first.cycles), "no cycles accounted");
+}
+
+/**
+ * @brief Test starting and stopping periodic snapshots
+ *
+ * @see telemetry_start(), telemetry_stop()
+ */
+ZTEST(telemetry, test_telemetry_start_stop)
+{
+	zassert_equal(telemetry_start(0), -EINVAL);
+	zassert_equal(telemetry_stop(), -EALREADY);
+
+	num_records = 0;
+	zassert_ok(telemetry_start(10));
+	zassert_equal(telemetry_start(10), -EALREADY);
+
+	k_msleep(55);
+
+	zassert_ok(telemetry_stop());
+	zassert_true(num_records > 0U, "no periodic snapshot");
+}
+
+ZTEST_SUITE(telemetry, NULL, NULL, NULL, NULL, NULL);